@@ -0,0 +1,254 @@
+#include "BenchReport.hh"
+
+#include <algorithm>
+#include <iterator>
+
+#include <sys/resource.h>
+
+#include "octopus/components/basic/hitpoint/HitPoint.hh"
+#include "octopus/components/basic/player/Team.hh"
+#include "octopus/components/basic/projectile/Projectile.hh"
+#include "octopus/utils/alloc/AllocStats.hh"
+#include "octopus/utils/profiler/CostAttribution.hh"
+#include "octopus/utils/profiler/Profiler.hh"
+
+using namespace octopus;
+
+namespace bench
+{
+
+namespace
+{
+
+/// @brief mean per tick
+void write_allocs(std::ostream &os_p, AllocCounters const &allocs_p, uint64_t ticks_p)
+{
+	os_p << "{\"count\": " << allocs_p.allocations / ticks_p
+		<< ", \"bytes\": " << allocs_p.bytes / ticks_p << "}";
+}
+
+void write_counts(std::ostream &os_p, EntityCounts const &counts_p)
+{
+	os_p << "{\"alive_team_0\": " << counts_p.alive[0]
+		<< ", \"alive_team_1\": " << counts_p.alive[1]
+		<< ", \"projectiles\": " << counts_p.projectiles
+		<< ", \"world\": " << counts_p.world << "}";
+}
+
+} // namespace
+
+EntityCounts count_entities(flecs::world const &ecs)
+{
+	EntityCounts counts_l;
+	// disabled (dead) entities are skipped by queries
+	ecs.query<Team const, HitPoint const>().each([&counts_l](Team const &team_p, HitPoint const &hp_p) {
+		if(team_p.team < 2 && hp_p.qty > Fixed::Zero())
+		{
+			++counts_l.alive[team_p.team];
+		}
+	});
+	ecs.query<Projectile const>().each([&counts_l](Projectile const &) {
+		++counts_l.projectiles;
+	});
+	counts_l.world = uint64_t(ecs_get_entities(ecs.c_ptr()).alive_count);
+	return counts_l;
+}
+
+uint64_t peak_rss_kb()
+{
+	rusage usage_l;
+	if(getrusage(RUSAGE_SELF, &usage_l) != 0)
+	{
+		return 0;
+	}
+	// kB on linux
+	return uint64_t(usage_l.ru_maxrss);
+}
+
+void add_budgets(BenchReport &report_p, WorkScheduler const &scheduler_p)
+{
+	report_p.budgets.resize(scheduler_p.channels().size());
+	for(size_t i = 0 ; i < scheduler_p.channels().size() ; ++ i)
+	{
+		BudgetChannel const &channel_l = *scheduler_p.channels()[i];
+		BudgetReport &budget_l = report_p.budgets[i];
+		budget_l.name = channel_l.name;
+		budget_l.kind = channel_l.kind;
+		budget_l.budget = channel_l.budget;
+		budget_l.spent += channel_l.spent;
+		budget_l.runs += channel_l.runs;
+		budget_l.backlog += channel_l.backlog;
+		budget_l.max_backlog = std::max(budget_l.max_backlog, channel_l.backlog);
+		budget_l.max_stride = std::max(budget_l.max_stride, channel_l.stride);
+	}
+	++report_p.budget_ticks;
+}
+
+void add_history(BenchReport &report_p, flecs::world const &ecs)
+{
+	HistoryMemory const *history_l = ecs.try_get<HistoryMemory>();
+	if(!history_l)
+	{
+		return;
+	}
+	report_p.history = *history_l;
+	report_p.history_peak_bytes = std::max(report_p.history_peak_bytes, history_l->bytes);
+}
+
+uint64_t percentile(std::vector<uint64_t> const &sorted_p, uint32_t percent_p)
+{
+	if(sorted_p.empty()) { return 0; }
+	return sorted_p[(sorted_p.size() - 1) * percent_p / 100];
+}
+
+void write_json(std::ostream &os_p, BenchReport const &report_p, PhaseTimer const &timer_p)
+{
+	std::vector<uint64_t> sorted_l = report_p.tick_ns;
+	std::sort(sorted_l.begin(), sorted_l.end());
+	uint64_t total_l = 0;
+	for(uint64_t tick_l : sorted_l) { total_l += tick_l; }
+	uint64_t const ticks_l = std::max<uint64_t>(1, sorted_l.size());
+
+	ScenarioConfig const &config_l = report_p.config;
+	os_p << "{\n";
+	os_p << "  \"config\": {"
+		<< "\"units_per_team\": " << config_l.units_per_team
+		<< ", \"melee\": " << config_l.melee
+		<< ", \"ranged\": " << config_l.ranged
+		<< ", \"casters\": " << config_l.casters
+		<< ", \"producers\": " << config_l.producers
+		<< ", \"grid\": " << (config_l.grid ? "true" : "false")
+		<< ", \"flocks\": " << (config_l.flocks ? "true" : "false")
+		<< ", \"cast_period\": " << config_l.cast_period
+		<< ", \"step_kept\": " << config_l.step_kept
+		<< ", \"retarget_budget\": " << config_l.retarget_budget
+		<< ", \"path_budget\": " << config_l.path_budget
+		<< ", \"history_period\": " << config_l.history_period
+		<< ", \"metrics\": " << (config_l.metrics ? "true" : "false")
+		<< ", \"seed\": " << config_l.seed
+		<< ", \"warmup\": " << report_p.warmup
+		<< ", \"ticks\": " << report_p.tick_ns.size()
+		<< "},\n";
+
+	os_p << "  \"tick_ns\": {"
+		<< "\"p50\": " << percentile(sorted_l, 50)
+		<< ", \"p99\": " << percentile(sorted_l, 99)
+		<< ", \"max\": " << (sorted_l.empty() ? 0 : sorted_l.back())
+		<< ", \"mean\": " << total_l / ticks_l
+		<< "},\n";
+
+	os_p << "  \"phases_ns\": {\n";
+	for(size_t i = 0 ; i < timer_p.names.size() ; ++ i)
+	{
+		os_p << "    \"" << timer_p.names[i] << "\": {"
+			<< "\"mean\": " << timer_p.total_ns[i] / std::max<uint64_t>(1, timer_p.ticks)
+			<< ", \"max\": " << timer_p.max_ns[i]
+			<< "},\n";
+	}
+	os_p << "    \"untracked\": {\"mean\": " << timer_p.untracked_ns / std::max<uint64_t>(1, timer_p.ticks) << "}\n";
+	os_p << "  },\n";
+
+	if(report_p.zones)
+	{
+		// per tick mean over the measured ticks
+		os_p << "  \"zones_ns\": {\n";
+		std::map<std::string, ZoneHistogram> const &histograms_l = Profiler::get().histograms();
+		for(auto it_l = histograms_l.begin() ; it_l != histograms_l.end() ; ++ it_l)
+		{
+			ZoneHistogram const &histogram_l = it_l->second;
+			os_p << "    \"" << it_l->first << "\": {"
+				<< "\"count\": " << histogram_l.count
+				<< ", \"tick_mean\": " << histogram_l.total_ns / ticks_l
+				<< ", \"p50\": " << histogram_l.percentile(50)
+				<< ", \"p99\": " << histogram_l.percentile(99)
+				<< ", \"max\": " << histogram_l.max_ns
+				<< ", \"tick_allocations\": " << histogram_l.allocations / ticks_l
+				<< "}" << (std::next(it_l) == histograms_l.end() ? "\n" : ",\n");
+		}
+		os_p << "  },\n";
+	}
+
+	if(report_p.costs)
+	{
+		os_p << "  \"costs\": ";
+		CostAttribution::get().write_json(os_p);
+		os_p << ",\n";
+	}
+
+	// mean per tick
+	os_p << "  \"allocations\": {\"tracks_new\": " << (AllocStats::tracks_new() ? "true" : "false")
+		<< ", \"max_tick_count\": " << timer_p.max_tick_allocations
+		<< ",\n    \"new\": ";
+	write_allocs(os_p, timer_p.tick_allocs_new, ticks_l);
+	os_p << ",\n    \"flecs\": ";
+	write_allocs(os_p, timer_p.tick_allocs_flecs, ticks_l);
+	os_p << ",\n    \"phases\": {\n";
+	for(size_t i = 0 ; i < timer_p.names.size() ; ++ i)
+	{
+		os_p << "      \"" << timer_p.names[i] << "\": ";
+		write_allocs(os_p, timer_p.allocs[i], ticks_l);
+		os_p << (i + 1 == timer_p.names.size() ? "\n" : ",\n");
+	}
+	os_p << "    }\n  },\n";
+
+	// mean per tick
+	uint64_t const budget_ticks_l = std::max<uint64_t>(1, report_p.budget_ticks);
+	os_p << "  \"budgets\": {\n";
+	for(size_t i = 0 ; i < report_p.budgets.size() ; ++ i)
+	{
+		BudgetReport const &budget_l = report_p.budgets[i];
+		os_p << "    \"" << budget_l.name << "\": {"
+			<< "\"kind\": \"" << (budget_l.kind == BudgetKind::Queue ? "queue" : "stride")
+			<< "\", \"budget\": " << budget_l.budget
+			<< ", \"spent\": " << budget_l.spent / budget_ticks_l
+			<< ", \"runs\": " << budget_l.runs / budget_ticks_l
+			<< ", \"backlog\": " << budget_l.backlog / budget_ticks_l
+			<< ", \"max_backlog\": " << budget_l.max_backlog
+			<< ", \"max_stride\": " << budget_l.max_stride
+			<< "}" << (i + 1 == report_p.budgets.size() ? "\n" : ",\n");
+	}
+	os_p << "  },\n";
+
+	if(config_l.history_period > 0)
+	{
+		HistoryMemory const &history_l = report_p.history;
+		os_p << "  \"history\": {\"bytes\": " << history_l.bytes
+			<< ", \"elements\": " << history_l.elements
+			<< ", \"peak_bytes\": " << report_p.history_peak_bytes
+			<< ", \"layers\": " << history_l.layers.size()
+			<< ",\n    \"types\": {\n";
+		for(size_t i = 0 ; i < history_l.types.size() ; ++ i)
+		{
+			HistoryEntryMemory const &entry_l = history_l.types[i];
+			os_p << "      \"" << entry_l.name << "\": {"
+				<< "\"elements\": " << entry_l.elements
+				<< ", \"bytes\": " << entry_l.bytes
+				<< "}" << (i + 1 == history_l.types.size() ? "\n" : ",\n");
+		}
+		// bytes required to revert 1, 2, 4... steps
+		os_p << "    },\n    \"depths\": {";
+		uint64_t bytes_l = 0;
+		size_t next_l = 1;
+		for(size_t i = 0 ; i < history_l.layers.size() ; ++ i)
+		{
+			bytes_l += history_l.layers[i].bytes;
+			if(i + 1 == next_l || i + 1 == history_l.layers.size())
+			{
+				os_p << (i == 0 ? "" : ", ") << "\"" << i + 1 << "\": " << bytes_l;
+				next_l *= 2;
+			}
+		}
+		os_p << "}\n  },\n";
+	}
+
+	os_p << "  \"entities\": {\"start\": ";
+	write_counts(os_p, report_p.start);
+	os_p << ", \"end\": ";
+	write_counts(os_p, report_p.end);
+	os_p << "},\n";
+
+	os_p << "  \"peak_rss_kb\": " << report_p.peak_rss_kb << "\n";
+	os_p << "}\n";
+}
+
+} // namespace bench
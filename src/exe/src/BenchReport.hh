@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "flecs.h"
+#include "octopus/world/budget/WorkBudget.hh"
+#include "octopus/world/step/HistoryMemory.hh"
+
+#include "PhaseTimer.hh"
+#include "Scenario.hh"
+
+namespace bench
+{
+
+/// @brief entities of the world at a given step
+struct EntityCounts
+{
+	/// @brief alive units and producers per team
+	std::array<uint64_t, 2> alive = {0, 0};
+	uint64_t projectiles = 0;
+	/// @brief every entity of the world (including flecs internals)
+	uint64_t world = 0;
+};
+
+EntityCounts count_entities(flecs::world const &ecs);
+
+/// @brief peak resident set size of the process in kB
+uint64_t peak_rss_kb();
+
+/// @brief percentile of the sorted durations
+uint64_t percentile(std::vector<uint64_t> const &sorted_p, uint32_t percent_p);
+
+/// @brief budget channel cumulated over the measured ticks
+struct BudgetReport
+{
+	std::string name;
+	octopus::BudgetKind kind = octopus::BudgetKind::Queue;
+	uint64_t budget = 0;
+	uint64_t spent = 0;
+	uint64_t runs = 0;
+	uint64_t backlog = 0;
+	uint64_t max_backlog = 0;
+	int64_t max_stride = 0;
+};
+
+struct BenchReport
+{
+	ScenarioConfig config;
+	uint32_t warmup = 0;
+	/// @brief duration of every measured tick in ns
+	std::vector<uint64_t> tick_ns;
+	EntityCounts start;
+	EntityCounts end;
+	uint64_t peak_rss_kb = 0;
+	/// @brief zones were recorded by the profiler
+	bool zones = false;
+	/// @brief entity and command costs were sampled
+	bool costs = false;
+	/// @brief budget channels of the world
+	std::vector<BudgetReport> budgets;
+	/// @brief ticks accumulated in budgets
+	uint64_t budget_ticks = 0;
+	/// @brief last history memory accounted
+	octopus::HistoryMemory history;
+	/// @brief max of the bytes held by the histories over the measured ticks
+	uint64_t history_peak_bytes = 0;
+};
+
+/// @brief accumulate the budget channels after a measured tick
+void add_budgets(BenchReport &report_p, octopus::WorkScheduler const &scheduler_p);
+
+/// @brief keep the history memory after a measured tick (if accounted)
+void add_history(BenchReport &report_p, flecs::world const &ecs);
+
+/// @brief write the report as json, all durations are in ns
+/// zones are read from the octopus Profiler and costs from the CostAttribution when recorded
+void write_json(std::ostream &os_p, BenchReport const &report_p, PhaseTimer const &timer_p);
+
+} // namespace bench
@@ -0,0 +1,109 @@
+#include "PhaseTimer.hh"
+
+#include <algorithm>
+
+#include "octopus/systems/phases/Phases.hh"
+
+namespace bench
+{
+
+namespace
+{
+
+uint64_t elapsed_ns(PhaseTimer::clock::time_point const &start_p, PhaseTimer::clock::time_point const &end_p)
+{
+	return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(end_p - start_p).count());
+}
+
+} // namespace
+
+PhaseTimer::PhaseTimer(flecs::world &ecs)
+{
+	// pipeline order (see set_up_phases)
+	names = {
+		InitializationPhase,
+		PrepingUpdatePhase,
+		CleanUpPhase,
+		PostCleanUpPhase,
+		PreUpdatePhase,
+		UpdatePhase,
+		UpdateUnpausedPhase,
+		PostUpdatePhase,
+		PostUpdateUnpausedPhase,
+		EndUpdatePhase,
+		MovingPhase,
+		InputPhase,
+		SteppingPhase,
+		ValidatePhase,
+		DisplaySyncPhase,
+		EndCleanUpPhase,
+	};
+	total_ns.resize(names.size(), 0);
+	max_ns.resize(names.size(), 0);
+	_starts.resize(names.size());
+	allocs.resize(names.size());
+	_alloc_starts.resize(names.size());
+	_ran.resize(names.size(), false);
+
+	for(size_t i = 0 ; i < names.size() ; ++ i)
+	{
+		ecs.system<>(("bench::PhaseTimer::" + names[i]).c_str())
+			.kind(ecs.entity(names[i].c_str()))
+			.run([this, i](flecs::iter &) {
+				_starts[i] = clock::now();
+				_alloc_starts[i] = octopus::AllocStats::total();
+				_ran[i] = true;
+			});
+	}
+}
+
+void PhaseTimer::start_tick()
+{
+	std::fill(_ran.begin(), _ran.end(), false);
+	_tick_alloc_start_new = octopus::AllocStats::total(octopus::AllocSource::New);
+	_tick_alloc_start_flecs = octopus::AllocStats::total(octopus::AllocSource::Flecs);
+	_tick_start = clock::now();
+}
+
+uint64_t PhaseTimer::end_tick()
+{
+	clock::time_point const end_l = clock::now();
+	uint64_t const tick_l = elapsed_ns(_tick_start, end_l);
+	octopus::AllocCounters const end_new_l = octopus::AllocStats::total(octopus::AllocSource::New);
+	octopus::AllocCounters const end_flecs_l = octopus::AllocStats::total(octopus::AllocSource::Flecs);
+	octopus::AllocCounters alloc_end_l = end_new_l;
+	alloc_end_l += end_flecs_l;
+	octopus::AllocCounters const alloc_new_l = end_new_l - _tick_alloc_start_new;
+	octopus::AllocCounters const alloc_flecs_l = end_flecs_l - _tick_alloc_start_flecs;
+	tick_allocs_new += alloc_new_l;
+	tick_allocs_flecs += alloc_flecs_l;
+	max_tick_allocations = std::max(max_tick_allocations, alloc_new_l.allocations + alloc_flecs_l.allocations);
+
+	uint64_t tracked_l = 0;
+	for(size_t i = 0 ; i < names.size() ; ++ i)
+	{
+		if(!_ran[i]) { continue; }
+		// next phase that ran this tick
+		clock::time_point phase_end_l = end_l;
+		octopus::AllocCounters phase_alloc_end_l = alloc_end_l;
+		for(size_t j = i + 1 ; j < names.size() ; ++ j)
+		{
+			if(_ran[j])
+			{
+				phase_end_l = _starts[j];
+				phase_alloc_end_l = _alloc_starts[j];
+				break;
+			}
+		}
+		uint64_t const phase_l = elapsed_ns(_starts[i], phase_end_l);
+		total_ns[i] += phase_l;
+		max_ns[i] = std::max(max_ns[i], phase_l);
+		allocs[i] += phase_alloc_end_l - _alloc_starts[i];
+		tracked_l += phase_l;
+	}
+	untracked_ns += tick_l > tracked_l ? tick_l - tracked_l : 0;
+	++ticks;
+	return tick_l;
+}
+
+} // namespace bench
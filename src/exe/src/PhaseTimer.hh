@@ -0,0 +1,58 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "flecs.h"
+
+#include "octopus/utils/alloc/AllocStats.hh"
+
+namespace bench
+{
+
+/// @brief measure the time spent and the allocations made in every phase of the pipeline
+/// a marker system declared first in each phase records when the phase starts,
+/// a phase ends when the next marker runs or when the tick ends
+/// @note must be created after set_up_phases and before any other system
+/// @note the markers capture this object which must not be moved
+struct PhaseTimer
+{
+	using clock = std::chrono::steady_clock;
+
+	explicit PhaseTimer(flecs::world &ecs);
+	PhaseTimer(PhaseTimer const &) = delete;
+	PhaseTimer &operator=(PhaseTimer const &) = delete;
+
+	void start_tick();
+	/// @brief accumulate the phase durations of the tick
+	/// @return the duration of the tick in ns
+	uint64_t end_tick();
+
+	std::vector<std::string> names;
+	/// @brief cumulated and max duration of every phase in ns
+	std::vector<uint64_t> total_ns;
+	std::vector<uint64_t> max_ns;
+	/// @brief time of the tick out of every phase in ns (pipeline sync, builtin phases)
+	uint64_t untracked_ns = 0;
+	uint64_t ticks = 0;
+
+	/// @brief cumulated allocations of every phase (every thread)
+	std::vector<octopus::AllocCounters> allocs;
+	/// @brief cumulated allocations of the ticks per source
+	octopus::AllocCounters tick_allocs_new;
+	octopus::AllocCounters tick_allocs_flecs;
+	/// @brief max allocations in one tick (every source)
+	uint64_t max_tick_allocations = 0;
+
+private:
+	clock::time_point _tick_start;
+	octopus::AllocCounters _tick_alloc_start_new;
+	octopus::AllocCounters _tick_alloc_start_flecs;
+	std::vector<clock::time_point> _starts;
+	std::vector<octopus::AllocCounters> _alloc_starts;
+	std::vector<bool> _ran;
+};
+
+} // namespace bench
@@ -0,0 +1,85 @@
+#include "RollbackReport.hh"
+
+#include <algorithm>
+#include <iterator>
+
+namespace bench
+{
+
+namespace
+{
+
+uint64_t mean(std::vector<uint64_t> const &durations_p)
+{
+	uint64_t total_l = 0;
+	for(uint64_t duration_l : durations_p) { total_l += duration_l; }
+	return total_l / std::max<uint64_t>(1, durations_p.size());
+}
+
+/// @brief p50, max and mean of the durations
+void write_durations(std::ostream &os_p, std::vector<uint64_t> durations_p)
+{
+	std::sort(durations_p.begin(), durations_p.end());
+	os_p << "{\"p50\": " << percentile(durations_p, 50)
+		<< ", \"max\": " << (durations_p.empty() ? 0 : durations_p.back())
+		<< ", \"mean\": " << mean(durations_p)
+		<< "}";
+}
+
+} // namespace
+
+void write_json(std::ostream &os_p, RollbackReport const &report_p)
+{
+	ScenarioConfig const &config_l = report_p.config;
+	os_p << "{\n";
+	os_p << "  \"config\": {"
+		<< "\"units_per_team\": " << config_l.units_per_team
+		<< ", \"melee\": " << config_l.melee
+		<< ", \"ranged\": " << config_l.ranged
+		<< ", \"casters\": " << config_l.casters
+		<< ", \"producers\": " << config_l.producers
+		<< ", \"grid\": " << (config_l.grid ? "true" : "false")
+		<< ", \"flocks\": " << (config_l.flocks ? "true" : "false")
+		<< ", \"cast_period\": " << config_l.cast_period
+		<< ", \"seed\": " << config_l.seed
+		<< ", \"recorded\": " << report_p.recorded
+		<< ", \"repeat\": " << report_p.repeat
+		<< "},\n";
+
+	os_p << "  \"runs\": [\n";
+	for(size_t i = 0 ; i < report_p.runs.size() ; ++ i)
+	{
+		RollbackRun const &run_l = report_p.runs[i];
+		uint64_t const repeat_l = std::max<uint64_t>(1, run_l.revert_ns.size());
+		os_p << "    {\"threads\": " << run_l.threads
+			<< ", \"depth\": " << run_l.depth
+			// mean time to revert and clear one step
+			<< ", \"step_ns\": " << (mean(run_l.revert_ns) + mean(run_l.clear_ns)) / std::max<uint32_t>(1, run_l.depth)
+			<< ",\n      \"revert_ns\": ";
+		write_durations(os_p, run_l.revert_ns);
+		os_p << ", \"clear_ns\": ";
+		write_durations(os_p, run_l.clear_ns);
+		os_p << ", \"replay_ns\": ";
+		write_durations(os_p, run_l.replay_ns);
+		// mean per rollback
+		os_p << ",\n      \"breakdown_ns\": {";
+		for(auto it_l = run_l.zones_ns.begin() ; it_l != run_l.zones_ns.end() ; ++ it_l)
+		{
+			os_p << "\"" << it_l->first << "\": " << it_l->second / repeat_l
+				<< (std::next(it_l) == run_l.zones_ns.end() ? "" : ", ");
+		}
+		os_p << "}}" << (i + 1 == report_p.runs.size() ? "\n" : ",\n");
+	}
+	os_p << "  ],\n";
+
+	os_p << "  \"entities\": {"
+		<< "\"alive_team_0\": " << report_p.entities.alive[0]
+		<< ", \"alive_team_1\": " << report_p.entities.alive[1]
+		<< ", \"projectiles\": " << report_p.entities.projectiles
+		<< ", \"world\": " << report_p.entities.world << "},\n";
+
+	os_p << "  \"peak_rss_kb\": " << report_p.peak_rss_kb << "\n";
+	os_p << "}\n";
+}
+
+} // namespace bench
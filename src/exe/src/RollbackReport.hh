@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "BenchReport.hh"
+#include "Scenario.hh"
+
+namespace bench
+{
+
+/// @brief measures of the rollbacks of a given depth with a given number of threads
+struct RollbackRun
+{
+	uint32_t threads = 0;
+	uint32_t depth = 0;
+	/// @brief duration of every call in ns
+	std::vector<uint64_t> revert_ns;
+	std::vector<uint64_t> clear_ns;
+	/// @brief duration of the ticks replayed after every rollback in ns
+	std::vector<uint64_t> replay_ns;
+	/// @brief cumulated duration of the revert zones (revert.steps, revert.state_steps...)
+	/// over every repetition in ns
+	std::map<std::string, uint64_t> zones_ns;
+};
+
+struct RollbackReport
+{
+	ScenarioConfig config;
+	/// @brief ticks recorded before the rollbacks
+	uint32_t recorded = 0;
+	uint32_t repeat = 0;
+	/// @brief entities once the ticks are recorded
+	EntityCounts entities;
+	std::vector<RollbackRun> runs;
+	uint64_t peak_rss_kb = 0;
+};
+
+/// @brief write the report as json, all durations are in ns
+void write_json(std::ostream &os_p, RollbackReport const &report_p);
+
+} // namespace bench
@@ -0,0 +1,281 @@
+#include "Scenario.hh"
+
+#include <cassert>
+
+#include "octopus/commands/basic/move/AttackCommandSystem.hh"
+#include "octopus/components/basic/ability/Caster.hh"
+#include "octopus/components/basic/attack/Attack.hh"
+#include "octopus/components/basic/flock/FlockManager.hh"
+#include "octopus/components/basic/hitpoint/HitPoint.hh"
+#include "octopus/components/basic/player/Team.hh"
+#include "octopus/components/basic/position/Move.hh"
+#include "octopus/components/basic/position/Position.hh"
+#include "octopus/components/basic/position/PositionInTree.hh"
+#include "octopus/components/advanced/production/queue/ProductionQueue.hh"
+#include "octopus/serialization/commands/CommandSupport.hh"
+#include "octopus/serialization/components/BasicSupport.hh"
+#include "octopus/serialization/queue/CommandQueueSupport.hh"
+#include "octopus/systems/Systems.hh"
+#include "octopus/world/path/PathFindingCache.hh"
+#include "octopus/world/resources/ResourceStock.hh"
+#include "octopus/world/step/StepEntityManager.hh"
+
+using namespace octopus;
+
+namespace bench
+{
+
+namespace
+{
+
+/// @brief spacing between two spawned units
+int32_t const unit_spacing = 2;
+/// @brief distance between the two spawn areas
+int32_t const team_gap = 40;
+int32_t const map_margin = 20;
+/// @brief number of units queued in every producer
+size_t const production_count = 16;
+
+/// @brief self heal of the casters
+struct HealAbility : AbilityTemplate<DefaultStepManager>
+{
+	virtual bool check_requirement(flecs::entity, flecs::world const &) const { return true; }
+	virtual std::unordered_map<std::string, Fixed> resource_consumption() const { return {{"mana", 10}}; }
+	virtual void cast(flecs::entity caster_p, Vector, flecs::entity, flecs::world const &, DefaultStepManager &manager_p) const
+	{
+		manager_p.get_last_layer().back().template get<HitPointStep>().add_step(caster_p, HitPointStep{5});
+	}
+	virtual std::string name() const { return "heal"; }
+	virtual int64_t windup() const { return 2; }
+	virtual int64_t reload() const { return 10; }
+	virtual bool need_point_target() const { return false; }
+	virtual bool need_entity_target() const { return false; }
+	virtual Fixed range() const { return 0; }
+};
+
+/// @brief spawn a melee unit next to the producer
+struct UnitProduction : ProductionTemplate<DefaultStepManager>
+{
+	virtual bool check_requirement(flecs::entity, flecs::world const &) const { return true; }
+	virtual std::unordered_map<std::string, Fixed> resource_consumption() const { return {}; }
+	virtual void produce(flecs::entity producer_p, flecs::world const &, DefaultStepManager &) const
+	{
+		Vector const spawn_l = producer_p.try_get<Position>()->pos + producer_p.try_get<ProductionQueue>()->spawn_point;
+		uint16_t const team_l = producer_p.try_get<Team>()->team;
+
+		EntityCreationStep step_l;
+		step_l.set_up_function = [spawn_l, team_l](flecs::entity new_ent, flecs::world const &) {
+			set_up_unit(new_ent, UnitKind::Melee, team_l, spawn_l);
+		};
+		producer_p.world().try_get_mut<StepEntityManager>()->get_last_layer().push_back(step_l);
+	}
+	virtual void enqueue(flecs::entity, flecs::world const &, DefaultStepManager &) const {}
+	virtual void dequeue(flecs::entity, flecs::world const &, DefaultStepManager &) const {}
+	virtual std::string name() const { return "unit"; }
+	virtual int64_t duration() const { return 40; }
+};
+
+UnitKind roll_kind(RandomGenerator &rng_p, ScenarioConfig const &config_p)
+{
+	int const total_l = config_p.melee + config_p.ranged + config_p.casters + config_p.producers;
+	assert(total_l > 0);
+	int roll_l = rng_p.roll(0, total_l - 1);
+	if(roll_l < int(config_p.melee)) { return UnitKind::Melee; }
+	roll_l -= config_p.melee;
+	if(roll_l < int(config_p.ranged)) { return UnitKind::Ranged; }
+	roll_l -= config_p.ranged;
+	if(roll_l < int(config_p.casters)) { return UnitKind::Caster; }
+	return UnitKind::Producer;
+}
+
+/// @brief number of units on a row of a spawn area
+int32_t area_columns(ScenarioConfig const &config_p)
+{
+	int32_t columns_l = 1;
+	while(uint32_t(columns_l * columns_l) < config_p.units_per_team) { ++columns_l; }
+	return columns_l;
+}
+
+/// @brief square grid covering both spawn areas with a wall
+/// between the teams forcing paths around it
+void set_up_grid(BenchGrid &grid_p, ScenarioConfig const &config_p)
+{
+	int32_t const band_l = area_columns(config_p) * unit_spacing;
+	int32_t const size_l = 2 * map_margin + 2 * band_l + team_gap;
+	int32_t const tile_l = grid_p.tile_size.to_int();
+
+	grid_p.nb_tiles_x = size_l / tile_l + 1;
+	grid_p.nb_tiles = grid_p.nb_tiles_x * grid_p.nb_tiles_x;
+	grid_p.free.assign(grid_p.nb_tiles, true);
+
+	size_t const wall_x_l = (map_margin + band_l + team_gap / 2) / tile_l;
+	size_t const wall_start_l = (map_margin + band_l / 4) / tile_l;
+	size_t const wall_end_l = (map_margin + 3 * band_l / 4) / tile_l;
+	for(size_t y = wall_start_l ; y <= wall_end_l ; ++ y)
+	{
+		grid_p.free[y * grid_p.nb_tiles_x + wall_x_l] = false;
+	}
+}
+
+} // namespace
+
+void set_up_unit(flecs::entity e, UnitKind kind_p, uint16_t team_p, Vector const &pos_p)
+{
+	Position pos_l;
+	pos_l.pos = pos_p;
+	e.set<Position>(pos_l)
+		.add<PositionInTree>()
+		.set<Team>({team_p});
+
+	if(kind_p == UnitKind::Producer)
+	{
+		std::vector<Symbol> queue_l(production_count, Symbol("unit"));
+		e.set<Collision>({Fixed(2), Fixed(100), true})
+			.set<HitPoint>({200})
+			.set<ProductionQueue>({0, queue_l});
+		return;
+	}
+
+	e.add<BenchCommandQueue>()
+		.add<Move>()
+		.add<AttackCommand>()
+		.set<Collision>({Fixed::One() / 2, Fixed::One(), true});
+
+	switch(kind_p)
+	{
+		case UnitKind::Melee:
+			e.set<HitPoint>({60})
+				.set<Attack>({{5, 10, 6, 1}});
+			break;
+		case UnitKind::Ranged:
+			e.set<HitPoint>({40})
+				.set<Attack>({{5, 15, 5, 6}})
+				.set<BasicProjectileAttack>({Fixed::One()})
+				.set<BenchProjectile>({});
+			break;
+		case UnitKind::Caster:
+			e.set<HitPoint>({40})
+				.set<Attack>({{5, 20, 2, 4}})
+				.set<ResourceStock>({ {
+					{"mana", {1000, 0} }
+				}})
+				.add<Caster>()
+				.add<CastCommand>();
+			break;
+		default:
+			break;
+	}
+}
+
+void set_up_bench_support(WorldContext<DefaultStepManager> &world, ScenarioConfig const &config_p, Scenario &scenario_p)
+{
+	flecs::world &ecs = world.ecs;
+
+	basic_components_support(ecs);
+	basic_commands_support(ecs);
+	command_queue_support<NoOpCommand, MoveCommand, AttackCommand, CastCommand>(ecs);
+	ecs.component<BenchProjectile>().member<bool>("decoy");
+	ecs.add<StepEntityManager>();
+
+	AbilityTemplateLibrary<DefaultStepManager> abilities_l;
+	abilities_l.add_template(new HealAbility());
+	ecs.set(abilities_l);
+
+	ProductionTemplateLibrary<DefaultStepManager> productions_l;
+	productions_l.add_template(new UnitProduction());
+	ecs.set(productions_l);
+
+	ecs.add<BenchInput>();
+	if(config_p.flocks)
+	{
+		scenario_p.flock_manager = ecs.entity("flock_manager")
+			.add<FlockManager>();
+		ecs.try_get_mut<BenchInput>()->flock_manager = scenario_p.flock_manager;
+	}
+}
+
+void set_up_bench_systems(WorldContext<DefaultStepManager> &world, BenchStepContext &step_context, ScenarioConfig const &config_p, Scenario &scenario_p)
+{
+	flecs::world &ecs = world.ecs;
+
+	world.attack_retarget_budget = config_p.retarget_budget;
+	world.history_memory_period = config_p.history_period;
+	world.metrics = config_p.metrics;
+	world.metrics_rest_port = config_p.rest_port;
+	set_up_systems(world, step_context, config_p.step_kept);
+	set_up_basic_projectile_basis(ecs);
+	set_up_basic_projectile_systems<BenchProjectile>(ecs, world);
+
+	if(config_p.grid)
+	{
+		set_up_grid(scenario_p.grid, config_p);
+		ecs.add<PathFindingCache>();
+		PathFindingCache *cache_l = ecs.try_get_mut<PathFindingCache>();
+		cache_l->declare_sync_system(ecs, &scenario_p.grid);
+		cache_l->declare_cache_update_system(ecs);
+		cache_l->budget.budget = config_p.path_budget;
+		world.work_scheduler.attach(cache_l->budget);
+	}
+}
+
+void spawn_scenario(WorldContext<DefaultStepManager> &world, ScenarioConfig const &config_p, Scenario &scenario_p)
+{
+	int32_t const columns_l = area_columns(config_p);
+	int32_t const band_l = columns_l * unit_spacing;
+
+	for(uint16_t team_l = 0 ; team_l < 2 ; ++ team_l)
+	{
+		int32_t const origin_x_l = map_margin + team_l * (band_l + team_gap);
+		scenario_p.base[team_l] = Vector(origin_x_l + band_l / 2, map_margin + band_l / 2);
+
+		for(uint32_t i = 0 ; i < config_p.units_per_team ; ++ i)
+		{
+			// small jitter to avoid perfectly aligned units
+			Vector pos_l(origin_x_l + int32_t(i % columns_l) * unit_spacing, map_margin + int32_t(i / columns_l) * unit_spacing);
+			pos_l.x += Fixed(world.rng.roll(0, 99)) / 100;
+			pos_l.y += Fixed(world.rng.roll(0, 99)) / 100;
+
+			UnitKind const kind_l = roll_kind(world.rng, config_p);
+			flecs::entity e = world.ecs.entity();
+			set_up_unit(e, kind_l, team_l, pos_l);
+
+			if(kind_l != UnitKind::Producer)
+			{
+				scenario_p.army[team_l].push_back(e);
+			}
+			if(kind_l == UnitKind::Caster)
+			{
+				scenario_p.casters[team_l].push_back(e);
+			}
+		}
+	}
+}
+
+void issue_orders(flecs::world &ecs, ScenarioConfig const &config_p, Scenario const &scenario_p, uint32_t step_p)
+{
+	BenchInput *input_l = ecs.try_get_mut<BenchInput>();
+	for(uint16_t team_l = 0 ; team_l < 2 ; ++ team_l)
+	{
+		AttackCommand const attack_move_l {flecs::entity(), scenario_p.base[1 - team_l], true};
+		if(step_p == 0)
+		{
+			input_l->addBackCommand(scenario_p.army[team_l], attack_move_l);
+		}
+		// casters heal themselves then resume the attack move
+		else if(config_p.cast_period > 0 && step_p % config_p.cast_period == 0)
+		{
+			std::vector<flecs::entity> casters_l;
+			for(flecs::entity const &e : scenario_p.casters[team_l])
+			{
+				if(e.is_alive() && !e.has(flecs::Disabled))
+				{
+					casters_l.push_back(e);
+				}
+			}
+			input_l->addFrontCommand(casters_l, CastCommand {"heal"});
+			input_l->addBackCommand(casters_l, attack_move_l);
+		}
+	}
+}
+
+} // namespace bench
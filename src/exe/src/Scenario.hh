@@ -0,0 +1,112 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <variant>
+#include <vector>
+
+#include "flecs.h"
+
+#include "octopus/commands/basic/ability/CastCommand.hh"
+#include "octopus/commands/basic/move/AttackCommand.hh"
+#include "octopus/commands/basic/move/MoveCommand.hh"
+#include "octopus/commands/queue/CommandQueue.hh"
+#include "octopus/systems/input/Input.hh"
+#include "octopus/world/StepContext.hh"
+#include "octopus/world/WorldContext.hh"
+
+namespace bench
+{
+
+using bench_variant = std::variant<octopus::NoOpCommand, octopus::MoveCommand, octopus::AttackCommand, octopus::CastCommand>;
+using BenchCommandQueue = octopus::CommandQueue<bench_variant>;
+using BenchInput = octopus::Input<bench_variant, octopus::DefaultStepManager>;
+using BenchStepContext = decltype(octopus::makeDefaultStepContext<bench_variant>());
+
+enum class UnitKind
+{
+	Melee,
+	Ranged,
+	Caster,
+	Producer
+};
+
+/// @brief tag of the projectiles spawned by ranged units
+struct BenchProjectile { bool decoy = false; };
+
+/// @brief generated scenario parameters
+/// @note unit kinds are rolled with the given weights
+struct ScenarioConfig
+{
+	uint32_t units_per_team = 500;
+	uint32_t melee = 4;
+	uint32_t ranged = 3;
+	uint32_t casters = 1;
+	uint32_t producers = 1;
+	/// @brief use a PathFindingCache on a grid with a wall between the teams
+	bool grid = false;
+	/// @brief issue group commands through flocks
+	bool flocks = false;
+	/// @brief number of steps between two casts
+	uint32_t cast_period = 50;
+	/// @brief number of steps kept for rollback (0 keeps all)
+	uint32_t step_kept = 0;
+	/// @brief target scans per step (0 for unlimited)
+	uint64_t retarget_budget = 0;
+	/// @brief path finding nodes expanded per step (0 for unlimited)
+	uint64_t path_budget = 4096;
+	/// @brief steps between two history memory accountings (0 disables it)
+	uint32_t history_period = 0;
+	/// @brief publish the engine metrics (see EngineMetricsCollector)
+	bool metrics = false;
+	/// @brief port of the flecs REST api (0 disables it)
+	uint16_t rest_port = 0;
+	unsigned long seed = 42;
+};
+
+/// @brief grid used by the PathFindingCache (see declare_sync_system)
+struct BenchGrid
+{
+	std::size_t nb_tiles_x = 0;
+	std::size_t nb_tiles = 0;
+	octopus::Fixed tile_size = 4;
+	uint64_t revision = 0;
+	std::vector<bool> free;
+
+	std::size_t get_nb_tiles() const { return nb_tiles; }
+	std::size_t get_size_x() const { return nb_tiles_x; }
+	octopus::Fixed get_tile_size() const { return tile_size; }
+	uint64_t get_revision() const { return revision; }
+	bool is_free(std::size_t i) const { return free[i]; }
+};
+
+/// @brief entities of the generated scenario
+struct Scenario
+{
+	/// @brief units receiving the attack move orders per team
+	std::array<std::vector<flecs::entity>, 2> army;
+	std::array<std::vector<flecs::entity>, 2> casters;
+	/// @brief center of each team spawn area
+	std::array<octopus::Vector, 2> base;
+	flecs::entity flock_manager;
+	BenchGrid grid;
+};
+
+/// @brief register components, templates and input of the benchmark
+void set_up_bench_support(octopus::WorldContext<octopus::DefaultStepManager> &world, ScenarioConfig const &config_p, Scenario &scenario_p);
+
+/// @brief set up the engine systems, the projectiles and the optional path finding grid
+void set_up_bench_systems(octopus::WorldContext<octopus::DefaultStepManager> &world, BenchStepContext &step_context, ScenarioConfig const &config_p, Scenario &scenario_p);
+
+/// @brief spawn two teams facing each other
+/// using the world random generator
+void spawn_scenario(octopus::WorldContext<octopus::DefaultStepManager> &world, ScenarioConfig const &config_p, Scenario &scenario_p);
+
+/// @brief orders given to the teams for the given step
+/// (attack move at start and periodic casts)
+void issue_orders(flecs::world &ecs, ScenarioConfig const &config_p, Scenario const &scenario_p, uint32_t step_p);
+
+/// @brief set up a unit of the given kind (also used for units spawned by producers)
+void set_up_unit(flecs::entity e, UnitKind kind_p, uint16_t team_p, octopus::Vector const &pos_p);
+
+} // namespace bench
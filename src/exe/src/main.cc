@@ -1,250 +1,215 @@
-// #include "flecs.h"
-
-// #include <iostream>
-
-// #include <chrono>
-// #include <cstddef>
-// #include <iomanip>
-// #include <iostream>
-// #include <numeric>
-// #include <vector>
-// #include <sstream>
-// #include <cmath>
-// #include <limits>
-// #include <mutex>
-
-// #include "octopus/components/generic/Components.hh"
-// #include "octopus/components/generic/Toolbox.hh"
-// #include "octopus/components/basic/Attack.hh"
-// #include "octopus/components/basic/Position.hh"
-// #include "octopus/components/basic/HitPoint.hh"
-// #include "octopus/components/basic/Team.hh"
-// #include "octopus/components/behaviour/target/Target.hh"
-// #include "octopus/components/step/StepContainer.hh"
-// #include "octopus/systems/GenericSystems.hh"
-
-// #include "octopus/utils/Grid.hh"
-// #include "octopus/utils/ThreadPool.hh"
-
-// using namespace octopus;
-
-// namespace octopus
-// {
-
-// } // octopus
-
-
-// struct Zombie {};
-
-// void zombie(
-// 	StepContainer &step,
-//     Grid const &grid_p,
-//     int32_t timestamp_p,
-//     flecs::entity e,
-//     Position const & p,
-//     Speed const & speed,
-//     Target const& target,
-//     Team const &team,
-//     Attack const &a
-// )
-// {
-//     // aquire target
-//     target_system(step, grid_p, e, p, target, team);
-
-//     if(target.data.target)
-//     {
-//         Position const *target_pos = target.data.target.try_get<Position>();
-//         if(target_pos)
-//         {
-//             Vector diff = target_pos->vec - p.vec;
-//             /// @todo use range and size of entity
-//             bool in_range = square_length(diff) < 1;
-//             // if in range or already started prepare attack
-//             if((a.state == AttackState::Idle && in_range)
-//             || a.state != AttackState::Idle)
-//             {
-//                 attack_system(step, timestamp_p, e, a);
-//             }
-
-//             // if we just ended wind up
-//             if(timestamp_p == a.data.winddown_timestamp+1)
-//             {
-//                 // deal damage
-//                 HitPoint const *hp_target = target.data.target.try_get<HitPoint>();
-// 				step.hitpoints.add_step(e, HitPointStep {-10});
-//             }
-
-//             // if not in wind up/down
-//             if(a.state == AttackState::Idle && !in_range)
-//             {
-//                 diff /= length(diff);
-// 				diff *= speed.speed;
-// 				step.positions.add_step(e, PositionStep {diff});
-//             }
-//         }
-//     }
-// }
-
-// int main(int, char *[]) {
-// 	size_t nb_threads = 12;
-
-// 	flecs::world ecs;
-// 	ecs.set_threads(nb_threads);
-// 	ThreadPool pool_l(nb_threads);
-
-// 	std::vector<StepContainer> steps(pool_l.size(), StepContainer());
-
-// 	size_t nb_l = 150000;
-
-// 	octopus::Grid grid_l;
-// 	init(grid_l, 2048, 2048);
-//     int32_t timestamp_l = 0;
-
-// 	/// ITERATION
-// 	ecs.system<Position const, Target const, Team const, Attack const, Speed const>()
-// 		.kind<Iteration>()
-// 		.iter([&pool_l, &steps, &grid_l, &timestamp_l](flecs::iter& it, Position const *pos, Target const *target, Team const *team, Attack const* attack, Speed const* speed) {
-// 			threading(it.count(), pool_l, [&it, &pos, &target, &team, &attack, &speed, &steps, &grid_l, timestamp_l](size_t t, size_t s, size_t e) {
-// 				// set up memory
-// 				reserve(steps[t], e-s);
-// 				for (size_t j = s; j < e; j ++) {
-// 					flecs::entity &ent = it.entity(j);
-// 					zombie(steps[t], grid_l, timestamp_l, ent, pos[j], speed[j], target[j], team[j], attack[j]);
-// 				}
-// 			}
-// 			);
-// 		});
-
-//     // destruct entities when hp < 0
-//     ecs.system<HitPoint const>()
-//         .multi_threaded()
-//         .kind<Iteration>()
-//         .each([&grid_l](flecs::entity e, HitPoint const &hp) {
-//             if(hp.hp <= 0)
-//             {
-//                 // free grid if necessary
-//                 if(e.has<Position>())
-//                 {
-//                     const Position * pos_l = e.try_get<Position const>();
-//                     size_t x = size_t(pos_l->vec.x.to_int());
-//                     size_t y = size_t(pos_l->vec.y.to_int());
-//                     set(grid_l, x, y, flecs::entity());
-//                 }
-//                 e.destruct();
-//             }
-//         });
-
-//     // move computation
-//     ecs.system()
-//         .kind<Iteration>()
-//         .iter([&pool_l, &steps, &grid_l](flecs::iter it) {
-// 			threading(steps.size(), pool_l, [&steps, &grid_l](size_t t, size_t, size_t) {
-// 				for (StepPair<PositionMemento> &pair : steps[t].positions.steps) {
-// 					StepPair<PositionMemento> &pair2 = pair;
-// 					flecs::entity &ent = pair.data.entity();
-// 					// maye have been destroyed
-// 					if(ent)
-// 					{
-// 						Position const * pos = pair.data.try_get();
-// 						position_system(grid_l, ent, *pos, pair.step);
-// 					}
-// 				}
-// 			}
-// 			);
-
-//         });
-
-// 	// Create computation pipeline
-// 	flecs::entity iteration = ecs.pipeline()
-// 		.with(flecs::System)
-// 		.with<Iteration>()
-// 		.build();
-
-// 	/// APPLY
-// 	declare_apply_system(ecs, steps, pool_l);
-
-// 	// Create computation pipeline
-// 	flecs::entity apply = ecs.pipeline()
-// 		.with(flecs::System)
-// 		.with<Apply>()
-// 		.build();
-
-// 	auto start = std::chrono::high_resolution_clock::now();
-
-// 	for(size_t i = 0 ; i < nb_l ; ++ i)
-// 	{
-// 		std::stringstream ss_l;
-// 		ss_l<<"e"<<i;
-// 		Position pos;
-// 		pos.vec.x = (10+i)%grid_l.x;
-// 		pos.vec.y = (20+i)%grid_l.y;
-// 		flecs::entity ent = ecs.entity(ss_l.str().c_str())
-// 			.set<Position>(pos)
-// 			.add<Target>()
-// 			.add<Attack>()
-// 			.set<Team>({int8_t(i%2)})
-// 			.set<HitPoint>({50})
-// 			.set<Speed>({0.1})
-// 			.add<Zombie>();
-
-// 		set(grid_l, pos.vec.x.to_int(), pos.vec.y.to_int(), ent);
-// 	}
-
-// 	auto end = std::chrono::high_resolution_clock::now();
-
-// 	std::chrono::duration<double> diff = end - start;
-
-// 	std::cout << "Time init\t" << diff.count()*1000. << "ms" << std::endl;
-
-//     for( ; timestamp_l < 30 ; ++ timestamp_l)
-//     {
-// 		start = std::chrono::high_resolution_clock::now();
-
-// 		ecs.set_pipeline(iteration);
-// 		ecs.progress();
-
-// 		end = std::chrono::high_resolution_clock::now();
-
-// 		diff = end - start;
-
-// 		std::cout << "Time iter\t" << diff.count()*1000. << "ms" << std::endl;
-
-// 		start = std::chrono::high_resolution_clock::now();
-
-// 		ecs.set_pipeline(apply);
-// 		ecs.progress();
-
-// 		end = std::chrono::high_resolution_clock::now();
-
-// 		diff = end - start;
-
-// 		std::cout << "Time apply\t" << diff.count()*1000. << "ms" << std::endl;
-
-// 		for(StepContainer &container_l : steps)
-// 		{
-// 			clear_container(container_l);
-// 		}
-// 	}
-
-// 	start = std::chrono::high_resolution_clock::now();
-
-// 	bool done_l = false;
-// 	bool valid_l = true;
-// 	ecs.query<Position const, HitPoint const>()
-// 	.each([&valid_l, &done_l](Position const& p, HitPoint const& hp) {
-// 		done_l = true;
-// 		valid_l &= p.vec.x == 32 && p.vec.y == 50;
-// 		valid_l &= hp.hp == 40;
-// 	});
-
-
-// 	end = std::chrono::high_resolution_clock::now();
-
-// 	diff = end - start;
-
-// 	std::cout << "\tTime valid\t" << diff.count()*1000. << "ms, valid : "<< valid_l << ", done : "<< done_l << std::endl;
-// }
-
-int main(int, char *[]) {
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "octopus/systems/Systems.hh"
+#include "octopus/utils/profiler/CostAttribution.hh"
+#include "octopus/utils/profiler/Profiler.hh"
+#include "octopus/world/metrics/EngineMetrics.hh"
+#include "octopus/world/StepContext.hh"
+#include "octopus/world/WorldContext.hh"
+
+#include "BenchReport.hh"
+#include "PhaseTimer.hh"
+#include "Scenario.hh"
+
+using namespace octopus;
+
+/////////////////////////////////////////////////
+/// Headless benchmark : two generated armies
+/// fight for a number of ticks and the tick
+/// times are reported as json
+/// the scenario only depends on the seed so that
+/// reports can be compared across commits
+/////////////////////////////////////////////////
+
+namespace
+{
+
+void usage(char const *exe_p)
+{
+	std::cerr << "usage: " << exe_p << " [options]\n"
+		<< "  --units N        units per team (default 500)\n"
+		<< "  --ticks K        measured ticks (default 600)\n"
+		<< "  --warmup W       ticks run before measuring (default 10)\n"
+		<< "  --seed S         seed of the scenario (default 42)\n"
+		<< "  --melee W        weight of melee units (default 4)\n"
+		<< "  --ranged W       weight of ranged units (default 3)\n"
+		<< "  --casters W      weight of casters (default 1)\n"
+		<< "  --producers W    weight of producers (default 1)\n"
+		<< "  --cast-period P  steps between two casts, 0 to disable (default 50)\n"
+		<< "  --step-kept N    steps kept for rollback, 0 keeps all (default 0)\n"
+		<< "  --retarget-budget N  target scans per step, 0 for unlimited (default 0)\n"
+		<< "  --path-budget N  path finding nodes expanded per step, 0 for unlimited (default 4096)\n"
+		<< "  --history P      account the memory of the rollback histories every P steps\n"
+		<< "  --grid           enable the path finding grid\n"
+		<< "  --flocks         issue group commands with flocks\n"
+		<< "  --zones          report the profiler zones (systems, jobs) of the measured ticks\n"
+		<< "  --trace FILE     write the chrome trace of the measured ticks to FILE (implies --zones)\n"
+		<< "  --costs K        report the K most expensive entities and the cost per command type\n"
+		<< "  --cost-period P  sample the costs of one measured tick every P (default 1)\n"
+		<< "  --metrics FILE   publish the engine metrics and write the last tick ones to FILE\n"
+		<< "  --rest PORT      publish the engine metrics and serve the flecs REST api on localhost\n"
+		<< "  --out FILE       write the json report to FILE instead of stdout\n";
+}
+
+/// @brief parse the command line
+/// @return false if the command line is invalid
+bool parse_args(int argc, char *argv[], bench::ScenarioConfig &config_p, uint32_t &ticks_p, uint32_t &warmup_p,
+	bool &zones_p, std::string &trace_p, uint32_t &costs_p, uint32_t &cost_period_p, std::string &metrics_p, std::string &out_p)
+{
+	for(int i = 1 ; i < argc ; ++ i)
+	{
+		std::string const arg_l = argv[i];
+		if(arg_l == "--grid") { config_p.grid = true; continue; }
+		if(arg_l == "--flocks") { config_p.flocks = true; continue; }
+		if(arg_l == "--zones") { zones_p = true; continue; }
+
+		// options with a value
+		if(i + 1 >= argc) { return false; }
+		char const *value_l = argv[++i];
+		if(arg_l == "--out") { out_p = value_l; continue; }
+		if(arg_l == "--metrics") { metrics_p = value_l; config_p.metrics = true; continue; }
+		if(arg_l == "--trace") { trace_p = value_l; zones_p = true; continue; }
+
+		char *end_l = nullptr;
+		unsigned long const number_l = std::strtoul(value_l, &end_l, 10);
+		if(end_l == value_l || *end_l != '\0') { return false; }
+
+		if(arg_l == "--units") { config_p.units_per_team = uint32_t(number_l); }
+		else if(arg_l == "--ticks") { ticks_p = uint32_t(number_l); }
+		else if(arg_l == "--warmup") { warmup_p = uint32_t(number_l); }
+		else if(arg_l == "--seed") { config_p.seed = number_l; }
+		else if(arg_l == "--melee") { config_p.melee = uint32_t(number_l); }
+		else if(arg_l == "--ranged") { config_p.ranged = uint32_t(number_l); }
+		else if(arg_l == "--casters") { config_p.casters = uint32_t(number_l); }
+		else if(arg_l == "--producers") { config_p.producers = uint32_t(number_l); }
+		else if(arg_l == "--cast-period") { config_p.cast_period = uint32_t(number_l); }
+		else if(arg_l == "--step-kept") { config_p.step_kept = uint32_t(number_l); }
+		else if(arg_l == "--retarget-budget") { config_p.retarget_budget = number_l; }
+		else if(arg_l == "--path-budget") { config_p.path_budget = number_l; }
+		else if(arg_l == "--history") { config_p.history_period = uint32_t(number_l); }
+		else if(arg_l == "--costs") { costs_p = uint32_t(number_l); }
+		else if(arg_l == "--cost-period") { cost_period_p = uint32_t(number_l); }
+		else if(arg_l == "--rest") { config_p.rest_port = uint16_t(number_l); config_p.metrics = true; }
+		else { return false; }
+	}
+	return config_p.melee + config_p.ranged + config_p.casters + config_p.producers > 0;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+	bench::ScenarioConfig config_l;
+	uint32_t ticks_l = 600;
+	uint32_t warmup_l = 10;
+	bool zones_l = false;
+	std::string trace_l;
+	uint32_t costs_l = 0;
+	uint32_t cost_period_l = 1;
+	std::string metrics_l;
+	std::string out_l;
+	if(!parse_args(argc, argv, config_l, ticks_l, warmup_l, zones_l, trace_l, costs_l, cost_period_l, metrics_l, out_l))
+	{
+		usage(argv[0]);
+		return 1;
+	}
+
+	WorldContext world(config_l.seed);
+	flecs::world &ecs = world.ecs;
+	auto step_context = makeDefaultStepContext<bench::bench_variant>();
+	bench::Scenario scenario_l;
+
+	bench::set_up_bench_support(world, config_l, scenario_l);
+	// markers must be the first systems of their phase
+	set_up_phases(ecs);
+	bench::PhaseTimer timer_l(ecs);
+	bench::set_up_bench_systems(world, step_context, config_l, scenario_l);
+	bench::spawn_scenario(world, config_l, scenario_l);
+
+	bench::BenchReport report_l;
+	report_l.config = config_l;
+	report_l.warmup = warmup_l;
+	report_l.zones = zones_l;
+	report_l.costs = costs_l > 0;
+	report_l.start = bench::count_entities(ecs);
+	report_l.tick_ns.reserve(ticks_l);
+
+	for(uint32_t step_l = 0 ; step_l < warmup_l + ticks_l ; ++ step_l)
+	{
+		bench::issue_orders(ecs, config_l, scenario_l, step_l);
+		if(step_l < warmup_l)
+		{
+			ecs.progress();
+			continue;
+		}
+		if(zones_l && step_l == warmup_l)
+		{
+			Profiler::get().enable(!trace_l.empty());
+		}
+		if(costs_l > 0 && step_l == warmup_l)
+		{
+			CostAttribution::get().enable(cost_period_l, costs_l);
+		}
+		timer_l.start_tick();
+		ecs.progress();
+		report_l.tick_ns.push_back(timer_l.end_tick());
+		bench::add_budgets(report_l, world.work_scheduler);
+		bench::add_history(report_l, ecs);
+		// out of the measured time
+		if(zones_l)
+		{
+			Profiler::get().collect();
+		}
+		if(costs_l > 0)
+		{
+			CostAttribution::get().collect();
+		}
+	}
+	Profiler::get().disable();
+	CostAttribution::get().disable();
+
+	report_l.end = bench::count_entities(ecs);
+	report_l.peak_rss_kb = bench::peak_rss_kb();
+
+	if(!trace_l.empty())
+	{
+		std::ofstream file_l(trace_l);
+		if(!file_l)
+		{
+			std::cerr << "cannot open " << trace_l << std::endl;
+			return 1;
+		}
+		Profiler::get().write_chrome_trace(file_l);
+	}
+
+	if(!metrics_l.empty())
+	{
+		std::ofstream file_l(metrics_l);
+		if(!file_l)
+		{
+			std::cerr << "cannot open " << metrics_l << std::endl;
+			return 1;
+		}
+		write_metrics_json(file_l, ecs);
+	}
+
+	if(out_l.empty())
+	{
+		bench::write_json(std::cout, report_l, timer_l);
+	}
+	else
+	{
+		std::ofstream file_l(out_l);
+		if(!file_l)
+		{
+			std::cerr << "cannot open " << out_l << std::endl;
+			return 1;
+		}
+		bench::write_json(file_l, report_l, timer_l);
+	}
 	return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,231 @@
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "octopus/components/step/StepReversal.hh"
+#include "octopus/systems/Systems.hh"
+#include "octopus/utils/ThreadPool.hh"
+#include "octopus/utils/profiler/Profiler.hh"
+#include "octopus/world/StepContext.hh"
+#include "octopus/world/WorldContext.hh"
+
+#include "BenchReport.hh"
+#include "RollbackReport.hh"
+#include "Scenario.hh"
+
+using namespace octopus;
+
+/////////////////////////////////////////////////
+/// Rollback benchmark : the scenario of the main
+/// benchmark is recorded for a number of ticks
+/// then rollbacks of several depths are timed
+/// (revert_n_steps then clear_n_steps) for
+/// several thread counts. The reverted ticks are
+/// replayed after every rollback, as in a
+/// lockstep catch-up, so that every rollback
+/// starts from the same history depth
+/////////////////////////////////////////////////
+
+namespace
+{
+
+using steady_clock = std::chrono::steady_clock;
+
+uint64_t elapsed_ns(steady_clock::time_point const &start_p)
+{
+	return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(steady_clock::now() - start_p).count());
+}
+
+void usage(char const *exe_p)
+{
+	std::cerr << "usage: " << exe_p << " [options]\n"
+		<< "  --units N        units per team (default 500)\n"
+		<< "  --record M       ticks recorded before the rollbacks (default 200)\n"
+		<< "  --depths LIST    comma separated rollback depths (default 1,8,32,128)\n"
+		<< "  --threads LIST   comma separated thread counts of the revert pool (default 1,4,12)\n"
+		<< "  --repeat R       rollbacks per depth and thread count (default 5)\n"
+		<< "  --seed S         seed of the scenario (default 42)\n"
+		<< "  --melee W        weight of melee units (default 4)\n"
+		<< "  --ranged W       weight of ranged units (default 3)\n"
+		<< "  --casters W      weight of casters (default 1)\n"
+		<< "  --producers W    weight of producers (default 1)\n"
+		<< "  --cast-period P  steps between two casts, 0 to disable (default 50)\n"
+		<< "  --grid           enable the path finding grid\n"
+		<< "  --flocks         issue group commands with flocks\n"
+		<< "  --out FILE       write the json report to FILE instead of stdout\n";
+}
+
+/// @brief parse a comma separated list of positive numbers
+bool parse_list(char const *value_p, std::vector<uint32_t> &list_p)
+{
+	list_p.clear();
+	char const *cur_l = value_p;
+	while(*cur_l != '\0')
+	{
+		char *end_l = nullptr;
+		unsigned long const number_l = std::strtoul(cur_l, &end_l, 10);
+		if(end_l == cur_l || number_l == 0 || (*end_l != ',' && *end_l != '\0')) { return false; }
+		list_p.push_back(uint32_t(number_l));
+		cur_l = *end_l == ',' ? end_l + 1 : end_l;
+	}
+	return !list_p.empty();
+}
+
+struct RollbackConfig
+{
+	uint32_t record = 200;
+	std::vector<uint32_t> depths = {1, 8, 32, 128};
+	std::vector<uint32_t> threads = {1, 4, 12};
+	uint32_t repeat = 5;
+	std::string out;
+};
+
+/// @brief parse the command line
+/// @return false if the command line is invalid
+bool parse_args(int argc, char *argv[], bench::ScenarioConfig &config_p, RollbackConfig &rollback_p)
+{
+	for(int i = 1 ; i < argc ; ++ i)
+	{
+		std::string const arg_l = argv[i];
+		if(arg_l == "--grid") { config_p.grid = true; continue; }
+		if(arg_l == "--flocks") { config_p.flocks = true; continue; }
+
+		// options with a value
+		if(i + 1 >= argc) { return false; }
+		char const *value_l = argv[++i];
+		if(arg_l == "--out") { rollback_p.out = value_l; continue; }
+		if(arg_l == "--depths") { if(!parse_list(value_l, rollback_p.depths)) { return false; } continue; }
+		if(arg_l == "--threads") { if(!parse_list(value_l, rollback_p.threads)) { return false; } continue; }
+
+		char *end_l = nullptr;
+		unsigned long const number_l = std::strtoul(value_l, &end_l, 10);
+		if(end_l == value_l || *end_l != '\0') { return false; }
+
+		if(arg_l == "--units") { config_p.units_per_team = uint32_t(number_l); }
+		else if(arg_l == "--record") { rollback_p.record = uint32_t(number_l); }
+		else if(arg_l == "--repeat") { rollback_p.repeat = uint32_t(number_l); }
+		else if(arg_l == "--seed") { config_p.seed = number_l; }
+		else if(arg_l == "--melee") { config_p.melee = uint32_t(number_l); }
+		else if(arg_l == "--ranged") { config_p.ranged = uint32_t(number_l); }
+		else if(arg_l == "--casters") { config_p.casters = uint32_t(number_l); }
+		else if(arg_l == "--producers") { config_p.producers = uint32_t(number_l); }
+		else if(arg_l == "--cast-period") { config_p.cast_period = uint32_t(number_l); }
+		else { return false; }
+	}
+	for(uint32_t depth_l : rollback_p.depths)
+	{
+		if(depth_l > rollback_p.record) { return false; }
+	}
+	return rollback_p.repeat > 0 && config_p.melee + config_p.ranged + config_p.casters + config_p.producers > 0;
+}
+
+/// @brief breakdown of the rollback from the revert zones
+void add_revert_zones(bench::RollbackRun &run_p)
+{
+	std::string const prefix_l = "revert.";
+	for(auto &&pair_l : Profiler::get().histograms())
+	{
+		if(pair_l.first.compare(0, prefix_l.size(), prefix_l) == 0)
+		{
+			run_p.zones_ns[pair_l.first.substr(prefix_l.size())] += pair_l.second.total_ns;
+		}
+	}
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+	bench::ScenarioConfig config_l;
+	RollbackConfig rollback_l;
+	if(!parse_args(argc, argv, config_l, rollback_l))
+	{
+		usage(argv[0]);
+		return 1;
+	}
+	// the whole history is required to revert
+	config_l.step_kept = 0;
+
+	WorldContext world(config_l.seed);
+	flecs::world &ecs = world.ecs;
+	auto step_context = makeDefaultStepContext<bench::bench_variant>();
+	bench::Scenario scenario_l;
+
+	bench::set_up_bench_support(world, config_l, scenario_l);
+	bench::set_up_bench_systems(world, step_context, config_l, scenario_l);
+	bench::spawn_scenario(world, config_l, scenario_l);
+
+	uint32_t step_l = 0;
+	for( ; step_l < rollback_l.record ; ++ step_l)
+	{
+		bench::issue_orders(ecs, config_l, scenario_l, step_l);
+		ecs.progress();
+	}
+
+	bench::RollbackReport report_l;
+	report_l.config = config_l;
+	report_l.recorded = rollback_l.record;
+	report_l.repeat = rollback_l.repeat;
+	report_l.entities = bench::count_entities(ecs);
+
+	for(uint32_t threads_l : rollback_l.threads)
+	{
+		// the revert jobs run on this pool, the replayed ticks on the world pool
+		ThreadPool pool_l(threads_l);
+		for(uint32_t depth_l : rollback_l.depths)
+		{
+			bench::RollbackRun run_l;
+			run_l.threads = threads_l;
+			run_l.depth = depth_l;
+
+			for(uint32_t repeat_l = 0 ; repeat_l < rollback_l.repeat ; ++ repeat_l)
+			{
+				Profiler::get().reset();
+				Profiler::get().enable();
+
+				steady_clock::time_point start_l = steady_clock::now();
+				revert_n_steps(ecs, pool_l, depth_l, step_context.step_manager, step_context.memento_manager, step_context.state_step_manager);
+				run_l.revert_ns.push_back(elapsed_ns(start_l));
+
+				start_l = steady_clock::now();
+				clear_n_steps(ecs, depth_l, step_context.step_manager, step_context.memento_manager, step_context.state_step_manager);
+				run_l.clear_ns.push_back(elapsed_ns(start_l));
+
+				Profiler::get().disable();
+				Profiler::get().collect();
+				add_revert_zones(run_l);
+
+				// replay the reverted ticks
+				start_l = steady_clock::now();
+				for(step_l -= depth_l ; step_l < rollback_l.record ; ++ step_l)
+				{
+					bench::issue_orders(ecs, config_l, scenario_l, step_l);
+					ecs.progress();
+				}
+				run_l.replay_ns.push_back(elapsed_ns(start_l));
+			}
+			report_l.runs.push_back(run_l);
+		}
+	}
+	Profiler::get().reset();
+	report_l.peak_rss_kb = bench::peak_rss_kb();
+
+	if(rollback_l.out.empty())
+	{
+		bench::write_json(std::cout, report_l);
+	}
+	else
+	{
+		std::ofstream file_l(rollback_l.out);
+		if(!file_l)
+		{
+			std::cerr << "cannot open " << rollback_l.out << std::endl;
+			return 1;
+		}
+		bench::write_json(file_l, report_l);
+	}
+	return 0;
+}
@@ -0,0 +1,225 @@
+#include "maps.hh"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+
+#include "octopus/utils/RandomGenerator.hh"
+#include "octopus/utils/wave_function_collapse/WaveFunctionCollapse.hh"
+
+using namespace octopus;
+
+namespace bench
+{
+
+namespace
+{
+
+/// @brief tiles kept free in every corner
+constexpr int corner_size = 8;
+
+bool in_corner(MapBox const &box_p, int nb_tiles_x_p)
+{
+	int const far_l = nb_tiles_x_p - corner_size;
+	bool const low_l = box_p.x < corner_size && box_p.y < corner_size;
+	bool const high_l = box_p.x + box_p.size_x > far_l && box_p.y + box_p.size_y > far_l;
+	return low_l || high_l;
+}
+
+/// @brief true if the boxes overlap or touch
+bool touch(MapBox const &a_p, MapBox const &b_p)
+{
+	return a_p.x <= b_p.x + b_p.size_x && b_p.x <= a_p.x + a_p.size_x
+		&& a_p.y <= b_p.y + b_p.size_y && b_p.y <= a_p.y + a_p.size_y;
+}
+
+void generate_maze(BenchMap &map_p)
+{
+	int const size_l = int(map_p.nb_tiles_x);
+	bool left_l = false;
+	for(int y = corner_size ; y < size_l - corner_size / 2 ; y += corner_size)
+	{
+		// the gap alternates between the right and the left side
+		map_p.boxes.push_back({left_l ? 3 : 0, y, size_l - 3, 1});
+		left_l = !left_l;
+	}
+}
+
+void generate_obstacles(BenchMap &map_p, RandomGenerator &rng_p)
+{
+	int const size_l = int(map_p.nb_tiles_x);
+	size_t const tries_l = map_p.nb_tiles / 32;
+	for(size_t i = 0 ; i < tries_l ; ++ i)
+	{
+		MapBox box_l;
+		box_l.size_x = rng_p.roll(1, 6);
+		box_l.size_y = rng_p.roll(1, 6);
+		box_l.x = rng_p.roll(0, size_l - box_l.size_x);
+		box_l.y = rng_p.roll(0, size_l - box_l.size_y);
+
+		bool valid_l = !in_corner(box_l, size_l);
+		for(size_t j = 0 ; valid_l && j < map_p.boxes.size() ; ++ j)
+		{
+			valid_l = !touch(box_l, map_p.boxes[j]);
+		}
+		if(valid_l)
+		{
+			map_p.boxes.push_back(box_l);
+		}
+	}
+}
+
+struct WfcCell
+{
+	int x = 0;
+	int y = 0;
+};
+
+struct WfcOption
+{
+	char val = '.';
+	bool operator==(WfcOption const &other) const { return val == other.val; }
+	bool operator!=(WfcOption const &other) const { return val != other.val; }
+};
+
+/// @brief walls make their neighbours more likely to be walls
+struct WfcCluster
+{
+	int cells_x = 0;
+	int boost = 0;
+
+	void init(VecTileRef<WfcOption, WfcCell> const &) {}
+
+	bool propagate(VecTileRef<WfcOption, WfcCell> const &tiles_p, Tile<WfcOption, WfcCell> const &tile_p, WfcOption const &option_p) const
+	{
+		if(option_p.val != '#') { return true; }
+		for(int y = std::max(0, tile_p.content.y - 1) ; y <= std::min(cells_x - 1, tile_p.content.y + 1) ; ++ y)
+		{
+			for(int x = std::max(0, tile_p.content.x - 1) ; x <= std::min(cells_x - 1, tile_p.content.x + 1) ; ++ x)
+			{
+				// tiles are stored row by row
+				Tile<WfcOption, WfcCell> &tile_l = tiles_p[x + y * cells_x].get();
+				if(tile_l.allocated) { continue; }
+				for(OptionBundle<WfcOption> &bundle_l : tile_l.options)
+				{
+					if(bundle_l.option.val == '#')
+					{
+						bundle_l.weight += boost;
+					}
+				}
+			}
+		}
+		return true;
+	}
+};
+
+/// @brief cells of 4x4 tiles are collapsed then every wall cell is a 3x3 box
+void generate_wfc(BenchMap &map_p, RandomGenerator &rng_p)
+{
+	int const cell_size_l = 4;
+	int const cells_x_l = int(map_p.nb_tiles_x) / cell_size_l;
+	int const corner_cells_l = corner_size / cell_size_l;
+
+	std::vector<Tile<WfcOption, WfcCell> > cells_l;
+	cells_l.reserve(cells_x_l * cells_x_l);
+	for(int y = 0 ; y < cells_x_l ; ++ y)
+	{
+		for(int x = 0 ; x < cells_x_l ; ++ x)
+		{
+			cells_l.push_back(Tile<WfcOption, WfcCell> { {x, y}, {{{'.'}, 60}, {{'#'}, 20}} });
+			bool const low_l = x < corner_cells_l && y < corner_cells_l;
+			bool const high_l = x >= cells_x_l - corner_cells_l && y >= cells_x_l - corner_cells_l;
+			if(low_l || high_l)
+			{
+				pre_allocate(cells_l.back(), WfcOption {'.'});
+			}
+		}
+	}
+	VecTileRef<WfcOption, WfcCell> refs_l(cells_l.begin(), cells_l.end());
+
+	std::vector<Constraint<WfcOption, WfcCell> > constraints_l;
+	constraints_l.emplace_back(refs_l, WfcCluster { cells_x_l, 40 });
+	// at most 35% of walls
+	constraints_l.emplace_back(refs_l, AtMost<WfcOption, WfcCell> { cells_x_l * cells_x_l * 35 / 100, {'#'} });
+	for(Constraint<WfcOption, WfcCell> &constraint_l : constraints_l)
+	{
+		constraint_l.init();
+	}
+
+	auto least_l = get_least_entropy_tile(cells_l, rng_p);
+	while(least_l)
+	{
+		auto option_l = get_option(least_l->get(), rng_p);
+		allocate(least_l->get(), option_l ? option_l->get() : WfcOption {'.'});
+		least_l = get_least_entropy_tile(cells_l, rng_p);
+	}
+
+	for(Tile<WfcOption, WfcCell> const &cell_l : cells_l)
+	{
+		if(get_option(cell_l).val == '#')
+		{
+			map_p.boxes.push_back({cell_l.content.x * cell_size_l, cell_l.content.y * cell_size_l, cell_size_l - 1, cell_size_l - 1});
+		}
+	}
+}
+
+BenchMap generate(MapKind kind_p, std::size_t nb_tiles_x_p)
+{
+	BenchMap map_l;
+	map_l.nb_tiles_x = nb_tiles_x_p;
+	map_l.nb_tiles = nb_tiles_x_p * nb_tiles_x_p;
+
+	RandomGenerator rng_l(42);
+	switch(kind_p)
+	{
+		case MapKind::Open: break;
+		case MapKind::Maze: generate_maze(map_l); break;
+		case MapKind::Obstacles: generate_obstacles(map_l, rng_l); break;
+		case MapKind::Wfc: generate_wfc(map_l, rng_l); break;
+	}
+
+	map_l.free.resize(map_l.nb_tiles, true);
+	for(MapBox const &box_l : map_l.boxes)
+	{
+		for(int y = box_l.y ; y < box_l.y + box_l.size_y ; ++ y)
+		{
+			for(int x = box_l.x ; x < box_l.x + box_l.size_x ; ++ x)
+			{
+				map_l.free[x + y * nb_tiles_x_p] = false;
+			}
+		}
+	}
+	return map_l;
+}
+
+} // namespace
+
+char const *map_name(MapKind kind_p)
+{
+	switch(kind_p)
+	{
+		case MapKind::Open: return "open";
+		case MapKind::Maze: return "maze";
+		case MapKind::Obstacles: return "obstacles";
+		case MapKind::Wfc: return "wfc";
+	}
+	return "unknown";
+}
+
+Vector BenchMap::tile_center(std::size_t x_p, std::size_t y_p) const
+{
+	return Vector(tile_size * int(x_p) + tile_size / 2, tile_size * int(y_p) + tile_size / 2);
+}
+
+BenchMap const &get_map(MapKind kind_p, std::size_t nb_tiles_x_p)
+{
+	static std::map<std::pair<MapKind, std::size_t>, std::unique_ptr<BenchMap> > maps_l;
+	std::unique_ptr<BenchMap> &map_l = maps_l[{kind_p, nb_tiles_x_p}];
+	if(!map_l)
+	{
+		map_l = std::make_unique<BenchMap>(generate(kind_p, nb_tiles_x_p));
+	}
+	return *map_l;
+}
+
+} // namespace bench
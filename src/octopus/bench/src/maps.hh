@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "octopus/utils/FixedPoint.hh"
+#include "octopus/utils/Vector.hh"
+
+namespace bench
+{
+
+enum class MapKind
+{
+	/// @brief no obstacle
+	Open,
+	/// @brief horizontal walls leaving a gap on alternate sides (serpentine path)
+	Maze,
+	/// @brief random boxes
+	Obstacles,
+	/// @brief clusters of walls generated with the wave function collapse
+	Wfc
+};
+
+char const *map_name(MapKind kind_p);
+
+/// @brief wall in tiles
+struct MapBox
+{
+	int x = 0;
+	int y = 0;
+	int size_x = 0;
+	int size_y = 0;
+};
+
+/// @brief square generated map
+/// walls are boxes of tiles separated by at least one free tile
+/// and the corners are always free (paths go from a corner to the opposite one)
+/// @note usable as the grid of a PathFindingCache (see declare_sync_system)
+struct BenchMap
+{
+	std::size_t nb_tiles_x = 0;
+	std::size_t nb_tiles = 0;
+	octopus::Fixed tile_size = 4;
+	uint64_t revision = 1;
+	std::vector<bool> free;
+	std::vector<MapBox> boxes;
+
+	std::size_t get_nb_tiles() const { return nb_tiles; }
+	std::size_t get_size_x() const { return nb_tiles_x; }
+	octopus::Fixed get_tile_size() const { return tile_size; }
+	uint64_t get_revision() const { return revision; }
+	bool is_free(std::size_t i) const { return free[i]; }
+
+	/// @brief size of the map in world coordinates
+	int world_size() const { return int(nb_tiles_x) * tile_size.to_int(); }
+	/// @brief center of the tile in world coordinates
+	octopus::Vector tile_center(std::size_t x_p, std::size_t y_p) const;
+};
+
+/// @brief map of the given kind with nb_tiles_x_p tiles per side
+/// @note generated once (seeded) and kept for the other benchmarks
+BenchMap const &get_map(MapKind kind_p, std::size_t nb_tiles_x_p);
+
+} // namespace bench
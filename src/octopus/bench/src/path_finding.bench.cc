@@ -0,0 +1,106 @@
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <memory>
+
+#include "flecs.h"
+#include "octopus/systems/Systems.hh"
+#include "octopus/utils/RandomGenerator.hh"
+#include "octopus/world/path/PathFindingCache.hh"
+
+#include "maps.hh"
+
+using namespace octopus;
+using bench::BenchMap;
+using bench::MapKind;
+
+namespace
+{
+
+/// @brief cache synced with a map
+struct SyncedCache
+{
+	flecs::world ecs;
+	PathFindingCache cache;
+};
+
+PathFindingCache const &get_cache(BenchMap const &map_p)
+{
+	static std::map<BenchMap const *, std::unique_ptr<SyncedCache> > caches_l;
+	std::unique_ptr<SyncedCache> &synced_l = caches_l[&map_p];
+	if(!synced_l)
+	{
+		synced_l = std::make_unique<SyncedCache>();
+		set_up_phases(synced_l->ecs);
+		synced_l->cache.declare_sync_system(synced_l->ecs, &map_p);
+		synced_l->ecs.progress();
+	}
+	return synced_l->cache;
+}
+
+BenchMap const &get_map(benchmark::State &state_p)
+{
+	MapKind const kind_l = MapKind(state_p.range(0));
+	state_p.SetLabel(bench::map_name(kind_l));
+	return bench::get_map(kind_l, std::size_t(state_p.range(1)));
+}
+
+/// @brief A* from a corner to the opposite one (no caching)
+void BM_PathFindingCache_compute_path(benchmark::State &state_p)
+{
+	BenchMap const &map_l = get_map(state_p);
+	PathFindingCache const &cache_l = get_cache(map_l);
+
+	std::size_t const last_l = map_l.nb_tiles_x - 2;
+	std::size_t const orig_l = cache_l.get_index(map_l.tile_center(1, 1));
+	std::size_t const dest_l = cache_l.get_index(map_l.tile_center(last_l, last_l));
+
+	std::size_t length_l = 0;
+	for(auto _ : state_p)
+	{
+		std::vector<std::size_t> path_l = cache_l.compute_path(orig_l, dest_l);
+		length_l = path_l.size();
+		benchmark::DoNotOptimize(path_l.data());
+	}
+	state_p.counters["path_length"] = double(length_l);
+}
+
+/// @brief line of sight between random free tiles
+void BM_PathFindingCache_losCheck(benchmark::State &state_p)
+{
+	BenchMap const &map_l = get_map(state_p);
+	PathFindingCache const &cache_l = get_cache(map_l);
+
+	RandomGenerator rng_l(42);
+	std::vector<Vector> positions_l;
+	while(positions_l.size() < 512)
+	{
+		std::size_t const x_l = std::size_t(rng_l.roll(0, int(map_l.nb_tiles_x) - 1));
+		std::size_t const y_l = std::size_t(rng_l.roll(0, int(map_l.nb_tiles_x) - 1));
+		if(map_l.is_free(x_l + y_l * map_l.nb_tiles_x))
+		{
+			positions_l.push_back(map_l.tile_center(x_l, y_l));
+		}
+	}
+
+	std::size_t idx_l = 0;
+	int64_t visible_l = 0;
+	for(auto _ : state_p)
+	{
+		visible_l += cache_l.losCheck(positions_l[idx_l], positions_l[idx_l + 1]) ? 1 : 0;
+		idx_l = (idx_l + 2) % positions_l.size();
+	}
+	benchmark::DoNotOptimize(visible_l);
+	state_p.counters["visible"] = benchmark::Counter(double(visible_l), benchmark::Counter::kAvgIterations);
+}
+
+} // namespace
+
+BENCHMARK(BM_PathFindingCache_compute_path)
+	->ArgNames({"map", "tiles"})
+	->ArgsProduct({{int64_t(MapKind::Open), int64_t(MapKind::Maze), int64_t(MapKind::Obstacles), int64_t(MapKind::Wfc)}, {64, 128, 256}})
+	->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_PathFindingCache_losCheck)
+	->ArgNames({"map", "tiles"})
+	->ArgsProduct({{int64_t(MapKind::Open), int64_t(MapKind::Maze), int64_t(MapKind::Obstacles), int64_t(MapKind::Wfc)}, {64, 128, 256}});
@@ -0,0 +1,108 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <map>
+#include <memory>
+
+#include "flecs.h"
+#include "octopus/components/basic/position/Position.hh"
+#include "octopus/utils/RandomGenerator.hh"
+#include "octopus/utils/aabb/aabb.hh"
+#include "octopus/world/position/PositionContext.hh"
+#include "octopus/world/position/closest_neighbours.hh"
+
+using namespace octopus;
+
+namespace
+{
+
+/// @brief entities spread uniformly (one entity per 16 units²)
+/// and inserted in the first tree as the position systems do
+struct SpatialWorld
+{
+	SpatialWorld() : context(ecs) {}
+
+	flecs::world ecs;
+	PositionContext context;
+	/// @brief query centers
+	std::vector<Position> centers;
+};
+
+SpatialWorld const &get_world(std::size_t entities_p)
+{
+	static std::map<std::size_t, std::unique_ptr<SpatialWorld> > worlds_l;
+	std::unique_ptr<SpatialWorld> &world_l = worlds_l[entities_p];
+	if(!world_l)
+	{
+		world_l = std::make_unique<SpatialWorld>();
+		int const side_l = int(std::sqrt(double(entities_p))) * 4;
+		RandomGenerator rng_l(42);
+		for(std::size_t i = 0 ; i < entities_p ; ++ i)
+		{
+			Position pos_l;
+			pos_l.pos = Vector(rng_l.roll(0, side_l), rng_l.roll(0, side_l));
+			Collision const col_l;
+			flecs::entity e = world_l->ecs.entity()
+				.set<Position>(pos_l)
+				.set<Collision>(col_l);
+			aabb box_l {pos_l.pos, pos_l.pos};
+			add_new_leaf(world_l->context.trees[0], expand_aabb(box_l, 2*col_l.ray), e);
+		}
+		for(std::size_t i = 0 ; i < 1024 ; ++ i)
+		{
+			Position pos_l;
+			pos_l.pos = Vector(rng_l.roll(0, side_l), rng_l.roll(0, side_l));
+			world_l->centers.push_back(pos_l);
+		}
+	}
+	return *world_l;
+}
+
+/// @brief every entity in a circle of ray 8 (about 12 entities)
+void BM_tree_circle_query(benchmark::State &state_p)
+{
+	SpatialWorld const &world_l = get_world(std::size_t(state_p.range(0)));
+
+	int64_t found_l = 0;
+	std::function<bool(int32_t, flecs::entity)> const callback_l = [&found_l](int32_t, flecs::entity) {
+		++found_l;
+		return true;
+	};
+
+	std::size_t idx_l = 0;
+	for(auto _ : state_p)
+	{
+		tree_circle_query(world_l.context.trees[0], world_l.centers[idx_l].pos, Fixed(8), callback_l);
+		idx_l = (idx_l + 1) % world_l.centers.size();
+	}
+	state_p.counters["found"] = benchmark::Counter(double(found_l), benchmark::Counter::kAvgIterations);
+	state_p.counters["tree_height"] = double(world_l.context.trees[0].nodes[world_l.context.trees[0].root].height);
+}
+
+/// @brief 5 closest entities in a circle of ray 8 (as for target acquisition)
+void BM_get_closest_entities(benchmark::State &state_p)
+{
+	SpatialWorld const &world_l = get_world(std::size_t(state_p.range(0)));
+	std::function<bool(flecs::entity const&)> const filter_l = [](flecs::entity const &) { return true; };
+
+	std::size_t idx_l = 0;
+	int64_t found_l = 0;
+	for(auto _ : state_p)
+	{
+		std::vector<flecs::entity> closest_l = get_closest_entities(5, 0, Fixed(8), world_l.context, world_l.centers[idx_l], filter_l);
+		found_l += int64_t(closest_l.size());
+		idx_l = (idx_l + 1) % world_l.centers.size();
+	}
+	state_p.counters["found"] = benchmark::Counter(double(found_l), benchmark::Counter::kAvgIterations);
+}
+
+} // namespace
+
+// bigger worlds take minutes to set up (inserting 32k entities in the tree)
+BENCHMARK(BM_tree_circle_query)
+	->ArgName("entities")
+	->RangeMultiplier(4)->Range(1 << 8, 1 << 12);
+
+BENCHMARK(BM_get_closest_entities)
+	->ArgName("entities")
+	->RangeMultiplier(4)->Range(1 << 8, 1 << 12);
@@ -0,0 +1,105 @@
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <memory>
+
+#include "octopus/utils/triangulation/Triangulation.hh"
+
+#include "maps.hh"
+
+using namespace octopus;
+using bench::BenchMap;
+using bench::MapKind;
+
+namespace
+{
+
+/// @brief triangulation with a forbidden box per wall of the map
+Triangulation const &get_triangulation(BenchMap const &map_p)
+{
+	static std::map<BenchMap const *, std::unique_ptr<Triangulation> > triangulations_l;
+	std::unique_ptr<Triangulation> &triangulation_l = triangulations_l[&map_p];
+	if(!triangulation_l)
+	{
+		triangulation_l = std::make_unique<Triangulation>();
+		int const tile_l = map_p.tile_size.to_int();
+		triangulation_l->init(map_p.world_size(), map_p.world_size());
+		for(bench::MapBox const &box_l : map_p.boxes)
+		{
+			insert_box(*triangulation_l, box_l.x * tile_l, box_l.y * tile_l, box_l.size_x * tile_l, box_l.size_y * tile_l, true);
+		}
+		triangulation_l->finalize();
+	}
+	return *triangulation_l;
+}
+
+BenchMap const &get_map(benchmark::State &state_p)
+{
+	MapKind const kind_l = MapKind(state_p.range(0));
+	state_p.SetLabel(bench::map_name(kind_l));
+	return bench::get_map(kind_l, std::size_t(state_p.range(1)));
+}
+
+/// @brief path of triangles from a corner to the opposite one
+void BM_Triangulation_compute_path(benchmark::State &state_p)
+{
+	BenchMap const &map_l = get_map(state_p);
+	Triangulation const &triangulation_l = get_triangulation(map_l);
+
+	std::size_t const last_l = map_l.nb_tiles_x - 2;
+	Vector const orig_l = map_l.tile_center(1, 1);
+	Vector const dest_l = map_l.tile_center(last_l, last_l);
+
+	std::size_t length_l = 0;
+	for(auto _ : state_p)
+	{
+		std::vector<std::size_t> path_l = triangulation_l.compute_path(orig_l, dest_l);
+		length_l = path_l.size();
+		benchmark::DoNotOptimize(path_l.data());
+	}
+	state_p.counters["triangles"] = double(triangulation_l.cdt.triangles.size());
+	state_p.counters["path_length"] = double(length_l);
+}
+
+/// @brief funnel of a precomputed path from a corner to the opposite one
+void BM_Triangulation_compute_funnel(benchmark::State &state_p)
+{
+	BenchMap const &map_l = get_map(state_p);
+	Triangulation const &triangulation_l = get_triangulation(map_l);
+
+	std::size_t const last_l = map_l.nb_tiles_x - 2;
+	Vector const orig_l = map_l.tile_center(1, 1);
+	Vector const dest_l = map_l.tile_center(last_l, last_l);
+	std::vector<std::size_t> const path_l = triangulation_l.compute_path(orig_l, dest_l);
+
+	std::size_t waypoints_l = 0;
+	for(auto _ : state_p)
+	{
+		std::vector<Vector> funnel_l = triangulation_l.compute_funnel_from_path(orig_l, dest_l, path_l);
+		waypoints_l = funnel_l.size();
+		benchmark::DoNotOptimize(funnel_l.data());
+	}
+	state_p.counters["waypoints"] = double(waypoints_l);
+}
+
+/// @brief every map kind at every scale
+/// @note the 256 tiles maze is skipped : its walls (1000 units long, 4 units thick)
+/// trip an assertion of the CDT (edgeNeighborInd) when looking for the path
+void map_args(benchmark::internal::Benchmark *bench_p)
+{
+	bench_p->ArgNames({"map", "tiles"});
+	for(int64_t tiles_l : {64, 128, 256})
+	{
+		for(MapKind kind_l : {MapKind::Open, MapKind::Maze, MapKind::Obstacles, MapKind::Wfc})
+		{
+			if(kind_l == MapKind::Maze && tiles_l == 256) { continue; }
+			bench_p->Args({int64_t(kind_l), tiles_l});
+		}
+	}
+}
+
+} // namespace
+
+BENCHMARK(BM_Triangulation_compute_path)->Apply(map_args)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_Triangulation_compute_funnel)->Apply(map_args)->Unit(benchmark::kMicrosecond);
@@ -2,14 +2,17 @@
 
 #include "flecs.h"
 #include "octopus/utils/Vector.hh"
+#include "octopus/utils/symbol/Symbol.hh"
+#include "octopus/utils/profiler/CostAttribution.hh"
 #include "octopus/components/basic/ability/Caster.hh"
 #include "octopus/components/basic/timestamp/TimeStamp.hh"
 #include "octopus/components/step/StepContainer.hh"
 #include "octopus/commands/queue/CommandQueue.hh"
-#include "octopus/world/stats/TimeStats.hh"
 #include "octopus/world/ability/AbilityTemplateLibrary.hh"
 #include "octopus/world/player/PlayerInfo.hh"
+#include "octopus/world/player/PlayerRegistry.hh"
 #include "octopus/world/resources/CostReduction.hh"
+#include "octopus/world/resources/ResourceLedger.hh"
 #include "octopus/world/resources/ResourceStock.hh"
 
 namespace octopus
@@ -20,7 +23,8 @@ namespace octopus
 ///////////////////////////////
 
 struct CastCommand {
-	std::string ability;
+	/// @brief interned to keep the command variant cheap to copy
+	Symbol ability;
 	flecs::entity entity_target;
 	Vector point_target;
 
@@ -50,35 +54,29 @@ InputStatus can_cast(flecs::world const &ecs, flecs::entity e, ResourceStock con
 	// check is_castable
 	std::string castability_error = ability->is_castable(e, ecs);
 	if(!castability_error.empty()) {
-		Logger::getDebug() <<"  not castable: "<<castability_error<<std::endl;
+		OCTOPUS_LOG_DEBUG <<"  not castable: "<<castability_error<<std::endl;
 		status.ok = false;
 		status.other_explanations.push_back(castability_error);
 	}
 	// check resources
-	if(!check_resources(stock.resource, {}, ability->resource_consumption())) {
-		Logger::getDebug() <<"  no resource"<<std::endl;
+	if(!ResourceLedger{&stock}.can_afford(Symbol(), ability->dense_cost())) {
+		OCTOPUS_LOG_DEBUG <<"  no resource"<<std::endl;
 		status.other_explanations.push_back("MISSING_RESOURCES");
 		status.ok = false;
 	}
 	// check player resource
-	flecs::entity player = get_player_from_appartenance(e, ecs);
-	ResourceStock const * resource_stock = player.is_valid() ? player.try_get<ResourceStock>() : nullptr;
-	ReductionLibrary const * reduction_library = player.is_valid() ? player.try_get<ReductionLibrary>() : nullptr;
-	ResourceSpent * resource_spent = player.is_valid() ? player.try_get_mut<ResourceSpent>() : nullptr;
-	status.resource_cost = reduction_library ? get_required_resources(reduction_library->reductions[ability->name()], ability->player_resource_consumption()) : ability->player_resource_consumption();
-	if (!check_resources(
-		resource_stock ? resource_stock->resource : fast_map<std::string, ResourceInfo>{},
-		resource_spent ? resource_spent->resources_spent : std::unordered_map<std::string, Fixed>{},
-		status.resource_cost
-	)){
-		Logger::getDebug() <<"  no player resource"<<std::endl;
+	PlayerEntry const * player = get_player_entry(e, ecs);
+	ResourceLedger const ledger = get_resource_ledger(player);
+	status.resource_cost = ledger.reductions ? get_required_resources(ledger.reductions->reductions[ability->name()], ability->player_resource_consumption()) : ability->player_resource_consumption();
+	if (!ledger.can_afford(ability->symbol(), ability->dense_player_cost())){
+		OCTOPUS_LOG_DEBUG <<"  no player resource"<<std::endl;
 		status.other_explanations.push_back("MISSING_RESOURCES");
 		status.ok = false;
 	}
 	// check cooldown
-	int64_t last_call = caster.get_timestamp_last_call(ability->name());
+	int64_t last_call = caster.get_timestamp_last_call(ability->symbol());
 	if(last_call >= 0 && last_call + ability->reload() > get_time_stamp(ecs)) {
-		Logger::getDebug() <<"  no reload"<<std::endl;
+		OCTOPUS_LOG_DEBUG <<"  no reload"<<std::endl;
 		status.cooldown_ratio = double(get_time_stamp(ecs) - last_call)/double(ability->reload());
 		status.cooldown_ticks_remaining = last_call + ability->reload() - get_time_stamp(ecs);
 		status.other_explanations.push_back("COOLDOWN");
@@ -98,7 +96,8 @@ void set_up_cast_system(flecs::world &ecs, StepManager_t &manager_p)
 		.with(CommandQueue_t::state(ecs), ecs.component<CastCommand::State>())
 		.each([&ecs, &manager_p, ability_library](flecs::entity e, Position const&pos_p, CastCommand const &castCommand_p,
 			Move &move_p, Caster const &caster_p, ResourceStock const &res_p, CommandQueue_t &queue_p) {
-			Logger::getDebug() <<"casting"<<std::endl;
+			OCTOPUS_ENTITY_COST("cast_command", e, "CastCommand")
+			OCTOPUS_LOG_DEBUG <<"casting"<<std::endl;
 			move_p.target_move = Vector();
 			// get ability
 			AbilityTemplate<StepManager_t> const * ability_l = ability_library->try_get(castCommand_p.ability);
@@ -137,7 +136,7 @@ void set_up_cast_system(flecs::world &ecs, StepManager_t &manager_p)
 				{
 					// move routine
 					move_routine(ecs, e, pos_p, target_pos, move_p);
-					Logger::getDebug() <<"  moving"<<std::endl;
+					OCTOPUS_LOG_DEBUG <<"  moving"<<std::endl;
 				}
 			}
 			else
@@ -154,7 +153,7 @@ void set_up_cast_system(flecs::world &ecs, StepManager_t &manager_p)
 			if(caster_p.timestamp_windup_start != 0
 			&& caster_p.timestamp_windup_start + ability_l->windup() <= get_time_stamp(ecs))
 			{
-				Logger::getDebug() <<"  cast"<<std::endl;
+				OCTOPUS_LOG_DEBUG <<"  cast"<<std::endl;
 				// run spell
 				ability_l->cast(e, castCommand_p.point_target, castCommand_p.entity_target, ecs, manager_p);
 				// consume resources
@@ -166,7 +165,8 @@ void set_up_cast_system(flecs::world &ecs, StepManager_t &manager_p)
 					manager_p.get_last_layer().back().template get<ResourceStockStep>().add_step(e, {-resource_consumed_l, resource_l});
 				}
 				// consume player resources
-				flecs::entity player = get_player_from_appartenance(e, ecs);
+				PlayerEntry const * player_entry = get_player_entry(e, ecs);
+				flecs::entity player = player_entry ? player_entry->player : flecs::entity();
 				// consume resources
 				for(auto &&pair_l : status.resource_cost)
 				{
@@ -178,7 +178,7 @@ void set_up_cast_system(flecs::world &ecs, StepManager_t &manager_p)
 				// reset windup
 				manager_p.get_last_layer().back().template get<CasterWindupStep>().add_step(e, {0});
 				// reload set up
-				manager_p.get_last_layer().back().template get<CasterLastCastStep>().add_step(e, {get_time_stamp(ecs), ability_l->name()});
+				manager_p.get_last_layer().back().template get<CasterLastCastStep>().add_step(e, {get_time_stamp(ecs), ability_l->symbol()});
 				queue_p._queuedActions.push_back(CommandQueueActionDone());
 			}
 		});
@@ -12,7 +12,6 @@
 #include "octopus/commands/basic/move/MoveCommand.hh"
 #include "octopus/world/position/closest_neighbours.hh"
 #include "octopus/world/position/PositionContext.hh"
-#include "octopus/world/stats/TimeStats.hh"
 
 #include "octopus/world/path/direction.hh"
 
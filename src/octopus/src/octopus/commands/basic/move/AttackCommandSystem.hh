@@ -19,10 +19,12 @@
 #include "octopus/world/path/direction.hh"
 #include "octopus/world/position/closest_neighbours.hh"
 #include "octopus/world/position/PositionContext.hh"
-#include "octopus/world/stats/TimeStats.hh"
+#include "octopus/utils/profiler/CostAttribution.hh"
+#include "octopus/utils/profiler/Profiler.hh"
 #include "octopus/world/step/EntityCreationStep.hh"
 #include "octopus/world/step/StepEntityManager.hh"
 #include "octopus/world/WorldContext.hh"
+#include "octopus/world/damage/DamageAccumulator.hh"
 
 namespace octopus {
 
@@ -36,7 +38,7 @@ bool has_reloaded(uint32_t time_p, Attack const&attack_p);
 
 template<class StepManager_t, class CommandQueue_t>
 void set_up_attack_system(flecs::world &ecs, StepManager_t &manager_p, WorldContext<StepManager_t> &world_context,
-	TimeStats &time_stats_p, int64_t attack_retarget_wait)
+	BudgetChannel &retarget_p)
 {
 	DamageModifier *damage_modifier = world_context.damage_modifier.get();
 	PositionContext &pos_context = world_context.position_context;
@@ -44,7 +46,7 @@ void set_up_attack_system(flecs::world &ecs, StepManager_t &manager_p, WorldCont
 		.kind(ecs.entity(PostUpdatePhase))
 		.multi_threaded()
 		.with(CommandQueue_t::state(ecs), ecs.component<NoOpCommand::State>())
-		.run([&, attack_retarget_wait](flecs::iter &it)
+		.run([&](flecs::iter &it)
 		{
 		    while (it.next())
 			{
@@ -52,29 +54,31 @@ void set_up_attack_system(flecs::world &ecs, StepManager_t &manager_p, WorldCont
 				auto attackCommand = it.field<AttackCommand const>(1);
 				auto attack = it.field<Attack const>(2);
 				auto queue = it.field<CommandQueue_t>(4);
-				START_TIME(attack_command_new_target)
 
 				size_t thread_idx = it.world().get_stage_id();
+				uint64_t scans_l = 0;
 				for(size_t ent_idx = 0; ent_idx < it.count(); ++ ent_idx)
 				{
 					flecs::entity e = it.entity(ent_idx);
+					OCTOPUS_ENTITY_COST("attack_command.scan", e, "NoOpCommand")
 					auto && pos_p = pos[ent_idx];
 					auto && attackCommand_p = attackCommand[ent_idx];
 					auto && attack_p = attack[ent_idx];
 					auto && queue_p = queue[ent_idx];
 
-					Logger::getDebug() << "AttackCommand :: = "<<e.name()<<" "<<e.id() <<std::endl;
+					OCTOPUS_LOG_DEBUG << "AttackCommand :: = "<<e.name()<<" "<<e.id() <<std::endl;
 					flecs::entity new_target;
 
-					if((get_time_stamp(ecs) + e.id()) % attack_retarget_wait == 0 || !attackCommand_p.init)
+					++scans_l;
+					if(retarget_p.is_due(get_time_stamp(ecs), e.id()) || !attackCommand_p.init)
 					{
 
-						Logger::getDebug() << "  looking for target" <<std::endl;
+						OCTOPUS_LOG_DEBUG << "  looking for target" <<std::endl;
 						new_target = get_new_target(e, pos_context, pos_p, std::max(Fixed(11), attack_p.cst.range), attack_p.cst.damage < 0);
 
 						if(new_target)
 						{
-							Logger::getDebug() << "    found " <<new_target.name()<<" "<<new_target.id()<<std::endl;
+							OCTOPUS_LOG_DEBUG << "    found " <<new_target.name()<<" "<<new_target.id()<<std::endl;
 							AttackCommand atk_l {new_target, pos_p.pos, true, true};
 							queue_p._queuedActions.push_back(CommandQueueActionAddFront<typename CommandQueue_t::variant> {atk_l});
 						}
@@ -88,7 +92,8 @@ void set_up_attack_system(flecs::world &ecs, StepManager_t &manager_p, WorldCont
 					}
 
 				}
-				END_TIME(attack_command_new_target)
+				// target scans if every entity was due
+				retarget_p.add_demand(scans_l);
 			}
 		});
 
@@ -97,9 +102,8 @@ void set_up_attack_system(flecs::world &ecs, StepManager_t &manager_p, WorldCont
 		.multi_threaded()
 		.template write<AttackTrigger>()
 		.with(CommandQueue_t::state(ecs), ecs.component<AttackCommand::State>())
-		.run([&, attack_retarget_wait](flecs::iter &it)
+		.run([&](flecs::iter &it)
 		{
-			START_TIME(attack_command)
 		    while (it.next())
 			{
 				auto pos = it.field<Position const>(0);
@@ -110,9 +114,11 @@ void set_up_attack_system(flecs::world &ecs, StepManager_t &manager_p, WorldCont
 				auto col = it.field<Collision const>(5);
 
 				size_t thread_idx = it.world().get_stage_id();
+				uint64_t scans_l = 0;
 				for(size_t ent_idx = 0; ent_idx < it.count(); ++ ent_idx)
 				{
 					flecs::entity e = it.entity(ent_idx);
+					OCTOPUS_ENTITY_COST("attack_command", e, "AttackCommand")
 					auto && pos_p = pos[ent_idx];
 					auto && attackCommand_p = attackCommand[ent_idx];
 					auto && attack_p = attack[ent_idx];
@@ -120,7 +126,7 @@ void set_up_attack_system(flecs::world &ecs, StepManager_t &manager_p, WorldCont
 					auto && queue_p = queue[ent_idx];
 					auto && col_p = col[ent_idx];
 
-					Logger::getDebug() << "AttackCommand :: = "<<e.name()<<" "<<e.id() <<std::endl;
+					OCTOPUS_LOG_DEBUG << "AttackCommand :: = "<<e.name()<<" "<<e.id() <<std::endl;
 
 
 					move_p.target_move = Vector();
@@ -142,12 +148,13 @@ void set_up_attack_system(flecs::world &ecs, StepManager_t &manager_p, WorldCont
 						should_scan_l |= (!hp || !hp_max || hp->qty >= hp_max->qty) && healer;
 
 						flecs::entity new_target;
-						if((get_time_stamp(ecs) + e.id()) % attack_retarget_wait == 0 || should_scan_l)
+						++scans_l;
+						if(retarget_p.is_due(get_time_stamp(ecs), e.id()) || should_scan_l)
 						{
-							START_TIME(attack_command_new_target)
+							OCTOPUS_ZONE("attack_command.new_target")
 
 							new_target = get_new_target(e, pos_context, pos_p, std::max(Fixed(8), attack_p.cst.range), healer);
-							Logger::getDebug() << "  re-looking for target " << pos_p.pos<<std::endl;
+							OCTOPUS_LOG_DEBUG << "  re-looking for target " << pos_p.pos<<std::endl;
 
 							if(!new_target)
 							{
@@ -162,27 +169,25 @@ void set_up_attack_system(flecs::world &ecs, StepManager_t &manager_p, WorldCont
 								// set up attack command as initialized
 								manager_p.get_last_layer()[thread_idx].template get<AttackCommandInitStep>().add_step(e, {true});
 							}
-
-							END_TIME(attack_command_new_target)
 						}
 
 						if(!new_target)
 						{
-							Logger::getDebug() << " moving "<<attackCommand_p.target_pos <<std::endl;
+							OCTOPUS_LOG_DEBUG << " moving "<<attackCommand_p.target_pos <<std::endl;
 							flecs::entity flock_entity = attackCommand_p.flock_handle.get();
 							Flock const * flock = flock_entity.is_valid() ? flock_entity.try_get<Flock>() : nullptr;
 							// if no move we are done
 							if(!attackCommand_p.move)
 							{
-								Logger::getDebug() << " done" <<std::endl;
+								OCTOPUS_LOG_DEBUG << " done" <<std::endl;
 								queue_p._queuedActions.push_back(CommandQueueActionDone());
 							}
 							// else move and if done we are done
-							else if(move_routine(ecs, e, pos_p, attackCommand_p.target_pos, move_p, flock, &time_stats_p))
+							else if(move_routine(ecs, e, pos_p, attackCommand_p.target_pos, move_p, flock))
 							{
 								if(flock_entity.is_valid() && flock)
 								{
-									Logger::getDebug() << " arrived = "<<flock->arrived <<std::endl;
+									OCTOPUS_LOG_DEBUG << " arrived = "<<flock->arrived <<std::endl;
 									manager_p.get_last_layer()[thread_idx].template get<FlockArrivedStep>().add_step(flock_entity, {flock->arrived + 1});
 								}
 								queue_p._queuedActions.push_back(CommandQueueActionDone());
@@ -190,14 +195,14 @@ void set_up_attack_system(flecs::world &ecs, StepManager_t &manager_p, WorldCont
 						}
 						else
 						{
-							Logger::getDebug() << "    found " <<new_target.name()<<" "<<new_target.id()<<std::endl;
+							OCTOPUS_LOG_DEBUG << "    found " <<new_target.name()<<" "<<new_target.id()<<std::endl;
 							// update target
 							manager_p.get_last_layer()[thread_idx].template get<AttackCommandStep>().add_step(e, {new_target});
 							// reset windup
 							manager_p.get_last_layer()[thread_idx].template get<AttackWindupStep>().add_step(e, {0});
 						}
 
-						// Logger::getDebug() << "Done :: "<<thread_idx<<std::endl;
+						// OCTOPUS_LOG_DEBUG << "Done :: "<<thread_idx<<std::endl;
 						continue;
 					}
 
@@ -225,7 +230,7 @@ void set_up_attack_system(flecs::world &ecs, StepManager_t &manager_p, WorldCont
 					// if not in range we need to move
 					else if(!in_attack_range(target_pos, target_col, pos_p, col_p, attack_p))
 					{
-						Logger::getDebug() << " not inrange" <<std::endl;
+						OCTOPUS_LOG_DEBUG << " not inrange" <<std::endl;
 						// reset mass if necessary
 						if(col_p.mass > 1)
 						{
@@ -233,20 +238,19 @@ void set_up_attack_system(flecs::world &ecs, StepManager_t &manager_p, WorldCont
 						}
 
 						flecs::entity new_target;
-						if((get_time_stamp(ecs) + e.id()) % attack_retarget_wait == 0 && !attackCommand_p.forced_target)
+						++scans_l;
+						if(retarget_p.is_due(get_time_stamp(ecs), e.id()) && !attackCommand_p.forced_target)
 						{
-							START_TIME(attack_command_new_target)
+							OCTOPUS_ZONE("attack_command.new_target")
 
-							Logger::getDebug() << " re-target greedy" <<std::endl;
+							OCTOPUS_LOG_DEBUG << " re-target greedy" <<std::endl;
 							new_target = get_new_target(e, pos_context, pos_p, std::max(Fixed(8), attack_p.cst.range), attack_p.cst.damage < 0);
-
-							END_TIME(attack_command_new_target)
 						}
 
 						if(new_target
 						&& in_attack_range(new_target.try_get<Position>(), new_target.try_get<Collision>(), pos_p, col_p, attack_p))
 						{
-							Logger::getDebug() << "    found " <<new_target.name()<<" "<<new_target.id()<<std::endl;
+							OCTOPUS_LOG_DEBUG << "    found " <<new_target.name()<<" "<<new_target.id()<<std::endl;
 							// update target
 							manager_p.get_last_layer()[thread_idx].template get<AttackCommandStep>().add_step(e, {new_target});
 						}
@@ -256,7 +260,7 @@ void set_up_attack_system(flecs::world &ecs, StepManager_t &manager_p, WorldCont
 					// if in range and reload ready initiate windup
 					else
 					{
-						Logger::getDebug() << " inrange p="<<pos_p.pos<<" t="<<target_pos->pos <<std::endl;
+						OCTOPUS_LOG_DEBUG << " inrange p="<<pos_p.pos<<" t="<<target_pos->pos <<std::endl;
 						// set mass if necessary
 						if(col_p.mass < 5)
 						{
@@ -264,24 +268,47 @@ void set_up_attack_system(flecs::world &ecs, StepManager_t &manager_p, WorldCont
 						}
 						if(has_reloaded(uint32_t(get_time_stamp(ecs)), attack_p))
 						{
-							Logger::getDebug() << " winding up" <<std::endl;
+							OCTOPUS_LOG_DEBUG << " winding up" <<std::endl;
 							// increment windup
 							manager_p.get_last_layer()[thread_idx].template get<AttackWindupStep>().add_step(e, {attack_p.windup+1});
 						}
 					}
 
 				}
+				// target scans if every entity was due
+				retarget_p.add_demand(scans_l);
 
 			}
-			END_TIME(attack_command)
 		});
 
+	DamageAccumulator &damage_accumulator = world_context.damage_accumulator;
 	ecs.system<AttackTrigger const, Attack const>()
 		.kind(ecs.entity(EndUpdatePhase))
 		.without<NoInstantDamage>()
 		.without<BasicProjectileAttackTag>()
-		.each([&manager_p, damage_modifier](flecs::entity e, AttackTrigger const& trigger, Attack const &attack_p) {
-			manager_p.get_last_layer().back().template get<HitPointStep>().add_step(trigger.target, {-damage_modifier->modify_attack(e, trigger.target, attack_p)});
+		.run([&manager_p, damage_modifier, &damage_accumulator](flecs::iter &it) {
+			// evaluate all attacks at once
+			std::vector<AttackDamage> attacks_l;
+			std::vector<Fixed> damages_l;
+			while(it.next())
+			{
+				auto trigger = it.field<AttackTrigger const>(0);
+				auto attack = it.field<Attack const>(1);
+				for(size_t ent_idx = 0; ent_idx < it.count(); ++ ent_idx)
+				{
+					attacks_l.push_back({it.entity(ent_idx), trigger[ent_idx].target, &attack[ent_idx]});
+				}
+			}
+			damage_modifier->modify_attacks(attacks_l, damages_l);
+			for(size_t i = 0 ; i < attacks_l.size() ; ++ i)
+			{
+				flecs::entity const &target_l = attacks_l[i].target;
+				damage_accumulator.add(attacks_l[i].attacker, target_l, damages_l[i]);
+				if(Position const *pos_l = target_l.try_get<Position>())
+				{
+					wake_up(target_l, *pos_l, manager_p.get_last_layer().back());
+				}
+			}
 		});
 
 	ecs.system<AttackTrigger const>()
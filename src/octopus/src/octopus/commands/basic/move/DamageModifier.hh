@@ -1,6 +1,7 @@
 #pragma once
 
 #include "flecs.h"
+#include <vector>
 #include "octopus/utils/Vector.hh"
 #include "octopus/components/basic/attack/Attack.hh"
 #include "octopus/components/basic/armor/Armor.hh"
@@ -8,9 +9,26 @@
 namespace octopus
 {
 
+/// @brief an attack to be evaluated by a DamageModifier
+struct AttackDamage {
+	flecs::entity attacker;
+	flecs::entity target;
+	Attack const *attack = nullptr;
+};
+
 struct DamageModifier {
 	virtual ~DamageModifier() = default;
 	virtual octopus::Fixed modify_attack(flecs::entity const &attacker, flecs::entity const &target, Attack const &attack) const = 0;
+
+	/// @brief evaluate a batch of attacks
+	/// @note default calls modify_attack on every attack
+	virtual void modify_attacks(std::vector<AttackDamage> const &attacks, std::vector<Fixed> &damages) const {
+		damages.resize(attacks.size());
+		for(size_t i = 0 ; i < attacks.size() ; ++ i)
+		{
+			damages[i] = modify_attack(attacks[i].attacker, attacks[i].target, *attacks[i].attack);
+		}
+	}
 };
 
 struct ArmorDamageModifier : public DamageModifier {
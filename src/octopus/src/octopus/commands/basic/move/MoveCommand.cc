@@ -6,29 +6,29 @@ namespace octopus
 {
 
 bool move_routine(flecs::world &ecs, flecs::entity e, Position const&pos_p, Vector const&target_p,
-	Move &move_p, Flock const *flock_p, TimeStats *stats_p, Fixed const &extra_tolerance)
+	Move &move_p, Flock const *flock_p, Fixed const &extra_tolerance)
 {
 	Fixed tol_l = Fixed::One()/10 + extra_tolerance;
 	if(flock_p)
 	{
 		uint32_t arrived_l = flock_p->arrived;
-		Logger::getDebug() << "move_routine :: flock_p->arrived = "<<flock_p->arrived <<std::endl;
+		OCTOPUS_LOG_DEBUG << "move_routine :: flock_p->arrived = "<<flock_p->arrived <<std::endl;
 		tol_l += Fixed::One() + Fixed::One()*2*arrived_l;
 	}
-	Logger::getDebug() << "move_routine :: tol = "<<tol_l <<std::endl;
-	Logger::getDebug() << "  p = "<<pos_p.pos <<std::endl;
-	Logger::getDebug() << "  t = "<<target_p <<std::endl;
+	OCTOPUS_LOG_DEBUG << "move_routine :: tol = "<<tol_l <<std::endl;
+	OCTOPUS_LOG_DEBUG << "  p = "<<pos_p.pos <<std::endl;
+	OCTOPUS_LOG_DEBUG << "  t = "<<target_p <<std::endl;
 
 	if(square_length(pos_p.pos - target_p) < tol_l)
 	{
-		Logger::getDebug() << "  done" <<std::endl;
+		OCTOPUS_LOG_DEBUG << "  done" <<std::endl;
 		return true;
 	}
 	// this will be updated
 	move_p.move = get_speed_direction(ecs, pos_p, target_p, move_p.speed);
 	// this is kept to know in which direction we wanted to move
 	move_p.target_move = move_p.move;
-	Logger::getDebug() << "  move = "<< move_p.move<<std::endl;
+	OCTOPUS_LOG_DEBUG << "  move = "<< move_p.move<<std::endl;
 	return false;
 }
 
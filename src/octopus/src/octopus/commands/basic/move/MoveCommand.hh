@@ -7,7 +7,7 @@
 #include "octopus/components/basic/flock/FlockHandle.hh"
 #include "octopus/components/basic/position/Move.hh"
 #include "octopus/commands/queue/CommandQueue.hh"
-#include "octopus/world/stats/TimeStats.hh"
+#include "octopus/utils/profiler/CostAttribution.hh"
 
 #include "octopus/world/path/direction.hh"
 
@@ -30,29 +30,28 @@ struct MoveCommand {
 /// END State
 
 bool move_routine(flecs::world &ecs, flecs::entity e, Position const&pos_p, Vector const&target_p,
-	Move &move_p, Flock const *flock_p=nullptr, TimeStats *stats_p=nullptr, Fixed const &extra_tolerance=Fixed::Zero());
+	Move &move_p, Flock const *flock_p=nullptr, Fixed const &extra_tolerance=Fixed::Zero());
 
 template<class StepManager_t, class CommandQueue_t>
-void set_up_move_system(flecs::world &ecs, StepManager_t &manager_p, TimeStats &time_stats_p)
+void set_up_move_system(flecs::world &ecs, StepManager_t &manager_p)
 {
 	ecs.system<Position const, MoveCommand const, Move, CommandQueue_t>()
 		.kind(ecs.entity(PostUpdatePhase))
 		.with(CommandQueue_t::state(ecs), ecs.component<MoveCommand::State>())
-		.each([&ecs, &manager_p, &time_stats_p](flecs::entity e, Position const&pos_p, MoveCommand const &moveCommand_p, Move &move_p, CommandQueue_t &queue_p) {
-			START_TIME(move_command)
+		.each([&ecs, &manager_p](flecs::entity e, Position const&pos_p, MoveCommand const &moveCommand_p, Move &move_p, CommandQueue_t &queue_p) {
+			OCTOPUS_ENTITY_COST("move_command", e, "MoveCommand")
 			move_p.target_move = Vector();
 			flecs::entity flock_entity = moveCommand_p.flock_handle.get();
 			Flock const * flock = flock_entity.is_valid() ? flock_entity.try_get<Flock>() : nullptr;
-			if(move_routine(ecs, e, pos_p, moveCommand_p.target, move_p, flock, nullptr, moveCommand_p.extra_tolerance))
+			if(move_routine(ecs, e, pos_p, moveCommand_p.target, move_p, flock, moveCommand_p.extra_tolerance))
 			{
 				if(flock_entity.is_valid() && flock)
 				{
-					Logger::getDebug() << "MoveCommand :: arrived = "<<flock->arrived <<std::endl;
+					OCTOPUS_LOG_DEBUG << "MoveCommand :: arrived = "<<flock->arrived <<std::endl;
 					manager_p.get_last_layer().back().template get<FlockArrivedStep>().add_step(flock_entity, {flock->arrived + 1});
 				}
 				queue_p._queuedActions.push_back(CommandQueueActionDone());
 			}
-			END_TIME(move_command)
 		});
 
 	// clean up
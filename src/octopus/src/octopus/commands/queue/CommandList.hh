@@ -0,0 +1,227 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <vector>
+
+namespace octopus
+{
+
+/// @brief Ring buffer of commands stored in place
+/// the first N commands are stored in the queue itself, the heap
+/// is only used once more commands are queued and its buffer is then
+/// kept so that later enqueue, dequeue and replace do not allocate
+/// @note list like interface (front, back, push, pop, iteration)
+template<typename T, size_t N = 2>
+class CommandList
+{
+public:
+	template<typename list_t, typename value_t>
+	class Iterator
+	{
+	public:
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = value_t *;
+		using reference = value_t &;
+
+		Iterator(list_t *list_p, size_t idx_p) : _list(list_p), _idx(idx_p) {}
+
+		reference operator*() const { return (*_list)[_idx]; }
+		pointer operator->() const { return &(*_list)[_idx]; }
+		Iterator &operator++() { ++_idx; return *this; }
+		Iterator operator++(int) { Iterator tmp_l = *this; ++_idx; return tmp_l; }
+		Iterator &operator--() { --_idx; return *this; }
+		Iterator operator--(int) { Iterator tmp_l = *this; --_idx; return tmp_l; }
+		bool operator==(Iterator const &other_p) const { return _idx == other_p._idx; }
+		bool operator!=(Iterator const &other_p) const { return _idx != other_p._idx; }
+	private:
+		list_t *_list;
+		size_t _idx;
+	};
+
+	using value_type = T;
+	using iterator = Iterator<CommandList, T>;
+	using const_iterator = Iterator<CommandList const, T const>;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+	CommandList() = default;
+	CommandList(std::initializer_list<T> init_p)
+	{
+		for(T const &value_l : init_p)
+		{
+			push_back(value_l);
+		}
+	}
+	CommandList(CommandList const &other_p)
+	{
+		*this = other_p;
+	}
+	CommandList(CommandList &&other_p)
+	{
+		*this = std::move(other_p);
+	}
+
+	CommandList &operator=(CommandList const &other_p)
+	{
+		if(this == &other_p) { return *this; }
+		clear();
+		reserve(other_p._size);
+		for(T const &value_l : other_p)
+		{
+			push_back(value_l);
+		}
+		return *this;
+	}
+
+	/// @brief steal the heap buffer if any, inline commands are moved
+	CommandList &operator=(CommandList &&other_p)
+	{
+		if(this == &other_p) { return *this; }
+		clear();
+		if(!other_p._heap.empty())
+		{
+			_heap.swap(other_p._heap);
+			_head = other_p._head;
+			_size = other_p._size;
+		}
+		else
+		{
+			for(T &value_l : other_p)
+			{
+				push_back(std::move(value_l));
+			}
+			other_p.clear();
+		}
+		other_p._head = 0;
+		other_p._size = 0;
+		return *this;
+	}
+
+	size_t size() const { return _size; }
+	bool empty() const { return _size == 0; }
+	size_t capacity() const { return _heap.empty() ? N : _heap.size(); }
+
+	T &operator[](size_t idx_p) { return data()[slot(idx_p)]; }
+	T const &operator[](size_t idx_p) const { return data()[slot(idx_p)]; }
+
+	T &front() { assert(_size > 0); return (*this)[0]; }
+	T const &front() const { assert(_size > 0); return (*this)[0]; }
+	T &back() { assert(_size > 0); return (*this)[_size-1]; }
+	T const &back() const { assert(_size > 0); return (*this)[_size-1]; }
+
+	iterator begin() { return iterator(this, 0); }
+	iterator end() { return iterator(this, _size); }
+	const_iterator begin() const { return const_iterator(this, 0); }
+	const_iterator end() const { return const_iterator(this, _size); }
+	reverse_iterator rbegin() { return reverse_iterator(end()); }
+	reverse_iterator rend() { return reverse_iterator(begin()); }
+	const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+	const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+	void push_back(T const &value_p) { push_back(T(value_p)); }
+	void push_back(T &&value_p)
+	{
+		if(_size == capacity()) { reserve(_size+1); }
+		data()[slot(_size)] = std::move(value_p);
+		++_size;
+	}
+
+	void push_front(T const &value_p) { push_front(T(value_p)); }
+	void push_front(T &&value_p)
+	{
+		if(_size == capacity()) { reserve(_size+1); }
+		_head = (_head + capacity() - 1) % capacity();
+		data()[_head] = std::move(value_p);
+		++_size;
+	}
+
+	/// @brief popped commands are reset to release their content
+	void pop_front()
+	{
+		assert(_size > 0);
+		data()[_head] = T();
+		_head = slot(1);
+		--_size;
+	}
+
+	void pop_back()
+	{
+		assert(_size > 0);
+		data()[slot(_size-1)] = T();
+		--_size;
+	}
+
+	/// @brief replace the content with the given range
+	template<typename iterator_t>
+	void assign(iterator_t begin_p, iterator_t end_p)
+	{
+		clear();
+		reserve(std::distance(begin_p, end_p));
+		for(iterator_t it_l = begin_p ; it_l != end_p ; ++ it_l)
+		{
+			push_back(*it_l);
+		}
+	}
+
+	/// @brief keep the heap buffer if any
+	void clear()
+	{
+		while(_size > 0)
+		{
+			pop_back();
+		}
+		_head = 0;
+	}
+
+	void resize(size_t size_p)
+	{
+		reserve(size_p);
+		while(_size < size_p)
+		{
+			push_back(T());
+		}
+		while(_size > size_p)
+		{
+			pop_back();
+		}
+	}
+
+	/// @brief ensure capacity (doubling) moving commands to the heap
+	void reserve(size_t size_p)
+	{
+		if(size_p <= capacity()) { return; }
+		size_t capacity_l = capacity();
+		while(capacity_l < size_p) { capacity_l *= 2; }
+
+		std::vector<T> heap_l(capacity_l);
+		for(size_t i = 0 ; i < _size ; ++ i)
+		{
+			heap_l[i] = std::move((*this)[i]);
+			(*this)[i] = T();
+		}
+		_heap.swap(heap_l);
+		_head = 0;
+	}
+
+	/// @brief bytes allocated on the heap
+	size_t heap_bytes() const { return _heap.capacity() * sizeof(T); }
+
+private:
+	T *data() { return _heap.empty() ? _inline.data() : _heap.data(); }
+	T const *data() const { return _heap.empty() ? _inline.data() : _heap.data(); }
+	size_t slot(size_t idx_p) const { return (_head + idx_p) % capacity(); }
+
+	std::array<T, N> _inline;
+	std::vector<T> _heap;
+	uint32_t _head = 0;
+	uint32_t _size = 0;
+};
+
+} // namespace octopus
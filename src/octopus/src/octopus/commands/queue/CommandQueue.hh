@@ -1,13 +1,16 @@
 #pragma once
 
+#include <cassert>
 #include <list>
 #include <variant>
+#include <vector>
 
 #include "flecs.h"
 
 #include "octopus/commands/step/StateChangeSteps.hh"
 #include "octopus/utils/log/Logger.hh"
 #include "action/CommandQueueAction.hh"
+#include "CommandList.hh"
 
 namespace octopus
 {
@@ -27,7 +30,20 @@ void remove(flecs::entity &e, flecs::entity state, type_t const &)
 	e.remove_second<typename type_t::State>(state);
 }
 
-/// @brief Memento used to store the state of the queue
+/// @brief kind of change recorded in a memento
+enum class CommandQueueChange
+{
+	/// @brief queued actions have been handled
+	Actions,
+	/// @brief current command has been reset because done
+	CleanUp,
+	/// @brief front command has become the current one
+	Pop
+};
+
+/// @brief Memento used to revert one change of the queue
+/// only the delta is stored : removed commands are moved
+/// into the memento and added ones are popped on revert
 template<typename variant_t>
 struct CommandQueueMemento
 {
@@ -38,11 +54,17 @@ struct CommandQueueMemento
 		CommandQueueActionAddBack<variant_t>
 	> CommandQueueAction;
 
-	variant_t _current;
-	std::list<variant_t> _queued;
-	std::list<CommandQueueAction> _queuedActions;
-	bool _done;
 	flecs::entity e;
+	CommandQueueChange change = CommandQueueChange::Actions;
+	/// @brief handled actions (Actions only)
+	/// restored on revert so that they are handled again
+	std::vector<CommandQueueAction> _queuedActions;
+	/// @brief queues removed by every replace action (Actions only)
+	std::vector<CommandList<variant_t> > _replaced;
+	/// @brief current command before reset (CleanUp only)
+	variant_t _current;
+	/// @brief done flag before the change (Actions and CleanUp)
+	bool _done = false;
 };
 
 template<typename variant_t>
@@ -52,6 +74,9 @@ struct CommandQueueMementoManager
 	typedef std::vector<CommandQueueMemento<variant_t> > vMemento;
 
 	std::list<vMemento> lMementos;
+	/// @brief mementos of multi threaded systems (one per stage)
+	/// merged into the last mementos by a single threaded system
+	std::vector<vMemento> stageMementos;
 };
 
 template<typename variant_t>
@@ -61,7 +86,7 @@ struct CommandQueue
 	/// @warning this is just an out of date pointer
 	/// to get the type information of the current action
 	variant_t _current;
-	std::list<variant_t> _queued;
+	CommandList<variant_t> _queued;
 	/// @brief true if the current command is done
 	bool _done = false;
 
@@ -72,15 +97,24 @@ struct CommandQueue
 		CommandQueueActionAddBack<variant_t>
 	> CommandQueueAction;
 
-	std::list<CommandQueueAction> _queuedActions;
+	CommandList<CommandQueueAction> _queuedActions;
 
 	// PrepingUpdatePhase (1)
 	// set clean up state
-	void clean_up_current(flecs::world &ecs, flecs::entity &e, StateStepContainer<variant_t> &stateStep_p)
+	void clean_up_current(flecs::world &ecs, flecs::entity &e, StateStepContainer<variant_t> &stateStep_p, CommandQueueMementoManager<variant_t> &mementoManager_p)
 	{
+		if(_done)
+		{
+			CommandQueueMemento<variant_t> memento_l;
+			memento_l.e = e;
+			memento_l.change = CommandQueueChange::CleanUp;
+			memento_l._current = _current;
+			memento_l._done = _done;
+			mementoManager_p.lMementos.back().push_back(std::move(memento_l));
+		}
 		if(_done && !std::holds_alternative<NoOpCommand>(_current))
 		{
-			Logger::getDebug()<<"clean_up_current : resetting state to nothing"<<std::endl;
+			OCTOPUS_LOG_DEBUG <<"clean_up_current : resetting state to nothing"<<std::endl;
 			// reset state
 			stateStep_p.get_last_prelayer()._removePair.push_back({e, state(ecs), _current});
 			// add clean up (do not use step here since at the end of the iteration this will be cleaned up)
@@ -95,7 +129,7 @@ struct CommandQueue
 	template<typename type_t, typename StateStepLayer_t>
 	void update_comp(flecs::entity &e, StateStepLayer_t &state_layer_p, type_t const &new_comp)
 	{
-		Logger::getDebug()<<"update_comp : setting comp "<<e.id()<<" "<<type_t::naming()<<std::endl;
+		OCTOPUS_LOG_DEBUG <<"update_comp : setting comp "<<e.id()<<" "<<type_t::naming()<<std::endl;
 		variant_t old_comp;
 		type_t const * old_typped_value = e.try_get<type_t>();
 		if(old_typped_value)
@@ -106,14 +140,14 @@ struct CommandQueue
 	}
 
 	// PostCleanUpPhase (1)
-	void update_current(flecs::world &ecs, flecs::entity &e, StateStepContainer<variant_t> &stateStep_p)
+	void update_current(flecs::world &ecs, flecs::entity &e, StateStepContainer<variant_t> &stateStep_p, CommandQueueMementoManager<variant_t> &mementoManager_p)
 	{
 		e.remove(cleanup(ecs), flecs::Wildcard);
 		if(std::holds_alternative<NoOpCommand>(_current))
 		{
 			if(_queued.empty())
 			{
-				Logger::getDebug()<<"update_current : setting comp "<<e.id()<<" "<<NoOpCommand::naming()<<std::endl;
+				OCTOPUS_LOG_DEBUG <<"update_current : setting comp "<<e.id()<<" "<<NoOpCommand::naming()<<std::endl;
 				// set state
 				stateStep_p.get_last_prelayer()._addPair.push_back({e, state(ecs), NoOpCommand()});
 			}
@@ -122,7 +156,12 @@ struct CommandQueue
 				_current = _queued.front();
 				_queued.pop_front();
 
-				Logger::getDebug()<<"update_current : setting comp "<<e.id()<<" front"<<std::endl;
+				CommandQueueMemento<variant_t> memento_l;
+				memento_l.e = e;
+				memento_l.change = CommandQueueChange::Pop;
+				mementoManager_p.lMementos.back().push_back(std::move(memento_l));
+
+				OCTOPUS_LOG_DEBUG <<"update_current : setting comp "<<e.id()<<" front"<<std::endl;
 				// set state
 				stateStep_p.get_last_prelayer()._addPair.push_back({e, state(ecs), _current});
 
@@ -136,35 +175,115 @@ struct CommandQueue
 	static flecs::entity cleanup(flecs::world &ecs) { return ecs.entity("cleanup"); }
 };
 
+template<typename queue_t>
+queue_t * get_queue(flecs::entity e, queue_t const &)
+{
+	return e.try_get_mut<queue_t>();
+}
+
 template<typename variant_t>
-CommandQueueMemento<variant_t> memento(flecs::entity const &e, CommandQueue<variant_t> const &queue_p)
+void revert_action(CommandQueue<variant_t> &, CommandQueueActionDone const &, std::vector<CommandList<variant_t> > &)
 {
-	return {
-		queue_p._current,
-		queue_p._queued,
-		queue_p._queuedActions,
-		queue_p._done,
-		e
-	};
+	// done flag is restored from the memento
 }
 
-template<typename queue_t>
-queue_t * get_queue(flecs::entity e, queue_t const &)
+template<typename variant_t>
+void revert_action(CommandQueue<variant_t> &queue_p, CommandQueueActionReplace<variant_t> const &, std::vector<CommandList<variant_t> > &replaced_p)
 {
-	return e.try_get_mut<queue_t>();
+	assert(!replaced_p.empty());
+	queue_p._queued = std::move(replaced_p.back());
+	replaced_p.pop_back();
 }
 
+template<typename variant_t>
+void revert_action(CommandQueue<variant_t> &queue_p, CommandQueueActionAddFront<variant_t> const &, std::vector<CommandList<variant_t> > &)
+{
+	assert(!queue_p._queued.empty());
+	queue_p._queued.pop_front();
+}
+
+template<typename variant_t>
+void revert_action(CommandQueue<variant_t> &queue_p, CommandQueueActionAddBack<variant_t> const &, std::vector<CommandList<variant_t> > &)
+{
+	assert(!queue_p._queued.empty());
+	queue_p._queued.pop_back();
+}
+
+/// @brief revert the change stored in the memento
+/// @note mementos of a step must be restored in reverse order
 template<typename variant_t>
 void restore(flecs::world &ecs, CommandQueueMemento<variant_t> const &memento_p)
 {
+	if(!memento_p.e.is_alive())
+	{
+		return;
+	}
 	CommandQueue<variant_t> *queue_p = get_queue(memento_p.e.mut(ecs), CommandQueue<variant_t>());
-	if(queue_p)
+	if(!queue_p)
 	{
-		queue_p->_current = memento_p._current;
-		queue_p->_queued = memento_p._queued;
-		queue_p->_queuedActions = memento_p._queuedActions;
-		queue_p->_done = memento_p._done;
+		return;
+	}
+	switch(memento_p.change)
+	{
+		case CommandQueueChange::Actions:
+		{
+			// only copy the replaced queues, this is not the hot path
+			std::vector<CommandList<variant_t> > replaced_l = memento_p._replaced;
+			for(auto rit_l = memento_p._queuedActions.rbegin() ; rit_l != memento_p._queuedActions.rend() ; ++ rit_l)
+			{
+				std::visit([queue_p, &replaced_l](auto&& arg)
+				{
+					revert_action(*queue_p, arg, replaced_l);
+				}, *rit_l);
+			}
+			queue_p->_queuedActions.clear();
+			for(auto const &action_l : memento_p._queuedActions)
+			{
+				queue_p->_queuedActions.push_back(action_l);
+			}
+			queue_p->_done = memento_p._done;
+			break;
+		}
+		case CommandQueueChange::CleanUp:
+			queue_p->_current = memento_p._current;
+			queue_p->_done = memento_p._done;
+			break;
+		case CommandQueueChange::Pop:
+			queue_p->_queued.push_front(queue_p->_current);
+			queue_p->_current = NoOpCommand();
+			break;
+	}
+}
+
+/// @brief approximate heap and inline bytes held by the memento
+template<typename variant_t>
+size_t memory_footprint(CommandQueueMemento<variant_t> const &memento_p)
+{
+	size_t size_l = sizeof(memento_p);
+	size_l += memento_p._queuedActions.capacity() * sizeof(typename CommandQueueMemento<variant_t>::CommandQueueAction);
+	size_l += memento_p._replaced.capacity() * sizeof(CommandList<variant_t>);
+	for(CommandList<variant_t> const &replaced_l : memento_p._replaced)
+	{
+		size_l += replaced_l.heap_bytes();
+	}
+	return size_l;
+}
+
+/// @brief approximate bytes held by all the mementos kept
+template<typename variant_t>
+size_t memory_footprint(CommandQueueMementoManager<variant_t> const &manager_p)
+{
+	size_t size_l = 0;
+	for(auto const &mementos_l : manager_p.lMementos)
+	{
+		// unused capacity of the vector
+		size_l += (mementos_l.capacity() - mementos_l.size()) * sizeof(CommandQueueMemento<variant_t>);
+		for(CommandQueueMemento<variant_t> const &memento_l : mementos_l)
+		{
+			size_l += memory_footprint(memento_l);
+		}
 	}
+	return size_l;
 }
 
 }
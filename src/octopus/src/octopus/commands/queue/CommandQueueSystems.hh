@@ -8,25 +8,27 @@ namespace octopus
 
 
 template<typename variant_t>
-void handle_action(CommandQueue<variant_t> &queue_p, CommandQueueActionDone const &action_p)
+void handle_action(CommandQueue<variant_t> &queue_p, CommandQueueMemento<variant_t> &, CommandQueueActionDone const &action_p)
 {
 	queue_p._done = action_p._done;
 }
 
 template<typename variant_t>
-void handle_action(CommandQueue<variant_t> &queue_p, CommandQueueActionReplace<variant_t> const &action_p)
+void handle_action(CommandQueue<variant_t> &queue_p, CommandQueueMemento<variant_t> &memento_p, CommandQueueActionReplace<variant_t> const &action_p)
 {
-	queue_p._queued = action_p._queued;
+	// move the old queue to the memento instead of copying it
+	memento_p._replaced.push_back(std::move(queue_p._queued));
+	queue_p._queued.assign(action_p._queued.begin(), action_p._queued.end());
 }
 
 template<typename variant_t>
-void handle_action(CommandQueue<variant_t> &queue_p, CommandQueueActionAddFront<variant_t> const &action_p)
+void handle_action(CommandQueue<variant_t> &queue_p, CommandQueueMemento<variant_t> &, CommandQueueActionAddFront<variant_t> const &action_p)
 {
 	queue_p._queued.push_front(action_p._queued);
 }
 
 template<typename variant_t>
-void handle_action(CommandQueue<variant_t> &queue_p, CommandQueueActionAddBack<variant_t> const &action_p)
+void handle_action(CommandQueue<variant_t> &queue_p, CommandQueueMemento<variant_t> &, CommandQueueActionAddBack<variant_t> const &action_p)
 {
 	queue_p._queued.push_back(action_p._queued);
 }
@@ -42,56 +44,86 @@ void set_up_command_queue_systems(flecs::world &ecs, CommandQueueMementoManager<
 	ecs.system("CommandQueueMementoSetup")
 		.kind(ecs.entity(InitializationPhase))
 		.run([&mementoManager_p, step_kept_p](flecs::iter& it) {
-			Logger::getDebug() << "CommandQueueMementoSetup :: start" << std::endl;
+			OCTOPUS_LOG_DEBUG << "CommandQueueMementoSetup :: start" << std::endl;
 			mementoManager_p.lMementos.push_back(typename CommandQueueMementoManager<variant_t>::vMemento());
+			mementoManager_p.stageMementos.resize(it.world().get_stage_count());
 			if(step_kept_p != 0 && mementoManager_p.lMementos.size() > step_kept_p)
 			{
 				mementoManager_p.lMementos.pop_front();
 			}
-			Logger::getDebug() << "CommandQueueMementoSetup :: end" << std::endl;
+			OCTOPUS_LOG_DEBUG << "CommandQueueMementoSetup :: end" << std::endl;
 		});
 
 	// Apply actions
+	// queues are independent so this runs on every thread
+	// mementos being stored per stage
 	ecs.system<CommandQueue<variant_t>>()
 		.kind(ecs.entity(PrepingUpdatePhase))
-		.each([&ecs, &mementoManager_p](flecs::entity e, CommandQueue<variant_t> &queue_p) {
-			Logger::getDebug() << "CommandQueue Run :: name=" << e.name() << " idx=" << e.id() << std::endl;
+		.multi_threaded()
+		.each([&mementoManager_p](flecs::iter &it, size_t i, CommandQueue<variant_t> &queue_p) {
+			flecs::entity e = it.entity(i);
+			OCTOPUS_LOG_DEBUG << "CommandQueue Run :: name=" << e.name() << " idx=" << e.id() << std::endl;
 
-			if(queue_p._queuedActions.size() > 0)
+			if(queue_p._queuedActions.empty())
 			{
-				mementoManager_p.lMementos.back().push_back(memento(e, queue_p));
+				return;
 			}
 
+			CommandQueueMemento<variant_t> memento_l;
+			memento_l.e = e;
+			memento_l.change = CommandQueueChange::Actions;
+			memento_l._done = queue_p._done;
+
 			for(typename CommandQueue<variant_t>::CommandQueueAction const & action_l : queue_p._queuedActions)
 			{
-				std::visit([&queue_p](auto&& arg)
+				std::visit([&queue_p, &memento_l](auto&& arg)
 				{
-					handle_action(queue_p, arg);
+					handle_action(queue_p, memento_l, arg);
 				}, action_l);
 			}
 
-			// clear once done
+			// move actions to the memento once done
+			memento_l._queuedActions.reserve(queue_p._queuedActions.size());
+			for(typename CommandQueue<variant_t>::CommandQueueAction & action_l : queue_p._queuedActions)
+			{
+				memento_l._queuedActions.push_back(std::move(action_l));
+			}
 			queue_p._queuedActions.clear();
+			mementoManager_p.stageMementos[it.world().get_stage_id()].push_back(std::move(memento_l));
+
+			OCTOPUS_LOG_DEBUG << "  done"<< std::endl;
+		});
 
-			Logger::getDebug() << "  done"<< std::endl;
+	// Merge mementos of every stage (in stage order)
+	ecs.system("CommandQueueMementoMerge")
+		.kind(ecs.entity(PrepingUpdatePhase))
+		.run([&mementoManager_p](flecs::iter& it) {
+			for(auto &mementos_l : mementoManager_p.stageMementos)
+			{
+				for(CommandQueueMemento<variant_t> &memento_l : mementos_l)
+				{
+					mementoManager_p.lMementos.back().push_back(std::move(memento_l));
+				}
+				mementos_l.clear();
+			}
 		});
 
 	ecs.system<CommandQueue<variant_t>>()
 		.immediate()
 		.kind(ecs.entity(PrepingUpdatePhase))
-		.each([&ecs, &stateStep_p](flecs::entity e, CommandQueue<variant_t> &queue_p) {
-			// Logger::getDebug() << "CommandQueue clean up current :: name=" << e.name() << " idx=" << e.id() <<" :: done"<< std::endl;
-			queue_p.clean_up_current(ecs, e, stateStep_p);
-			// Logger::getDebug() << "CommandQueue clean up current :: done"<< std::endl;
+		.each([&ecs, &stateStep_p, &mementoManager_p](flecs::entity e, CommandQueue<variant_t> &queue_p) {
+			// OCTOPUS_LOG_DEBUG << "CommandQueue clean up current :: name=" << e.name() << " idx=" << e.id() <<" :: done"<< std::endl;
+			queue_p.clean_up_current(ecs, e, stateStep_p, mementoManager_p);
+			// OCTOPUS_LOG_DEBUG << "CommandQueue clean up current :: done"<< std::endl;
 		});
 
 	ecs.system<CommandQueue<variant_t>>()
 		.immediate()
 		.kind(ecs.entity(PostCleanUpPhase))
-		.each([&ecs, &stateStep_p](flecs::entity e, CommandQueue<variant_t> &queue_p) {
-			// Logger::getDebug() << "CommandQueue update current :: name=" << e.name() << " idx=" << e.id() <<" :: done"<< std::endl;
-			queue_p.update_current(ecs, e, stateStep_p);
-			// Logger::getDebug() << "CommandQueue update current :: done"<< std::endl;
+		.each([&ecs, &stateStep_p, &mementoManager_p](flecs::entity e, CommandQueue<variant_t> &queue_p) {
+			// OCTOPUS_LOG_DEBUG << "CommandQueue update current :: name=" << e.name() << " idx=" << e.id() <<" :: done"<< std::endl;
+			queue_p.update_current(ecs, e, stateStep_p, mementoManager_p);
+			// OCTOPUS_LOG_DEBUG << "CommandQueue update current :: done"<< std::endl;
 		});
 }
 
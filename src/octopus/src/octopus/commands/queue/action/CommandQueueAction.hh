@@ -3,6 +3,7 @@
 #include "flecs.h"
 
 #include <variant>
+#include <vector>
 
 namespace octopus
 {
@@ -15,10 +16,11 @@ struct CommandQueueActionDone
 };
 
 /// @brief replace the queue with the given one
+/// @note stored in a vector to keep actions small
 template<typename variant_t>
 struct CommandQueueActionReplace
 {
-	std::list<variant_t> _queued;
+	std::vector<variant_t> _queued;
 	static constexpr char const * const naming()  { return "replace"; }
 };
 
@@ -37,14 +37,14 @@ struct StateSetComponentStep
 template<typename type_t>
 void add_second(flecs::entity e, flecs::entity state, type_t const &)
 {
-	Logger::getDebug()<<"  add_second "<<type_t::naming()<<std::endl;
+	OCTOPUS_LOG_DEBUG <<"  add_second "<<type_t::naming()<<std::endl;
 	e.add_second<typename type_t::State>(state);
 }
 
 template<typename type_t>
 void remove_second(flecs::entity e, flecs::entity state, type_t const &)
 {
-	Logger::getDebug()<<"  remove_second "<<type_t::naming()<<std::endl;
+	OCTOPUS_LOG_DEBUG <<"  remove_second "<<type_t::naming()<<std::endl;
 	e.add_second<NoOpCommand::State>(state);
 	// e.remove_second<typename type_t::State>(state);
 }
@@ -59,43 +59,43 @@ struct StateStepLayer
 
 	void apply(flecs::world &ecs)
 	{
-		Logger::getDebug()<<"StateStepLayer apply"<<std::endl;
+		OCTOPUS_LOG_DEBUG <<"StateStepLayer apply"<<std::endl;
 		for(StateRemovePairStep<variant_t> const &step_l : _removePair)
 		{
-			Logger::getDebug()<<" StateRemovePairStep : "<<step_l.ent.id()<<std::endl;
+			OCTOPUS_LOG_DEBUG <<" StateRemovePairStep : "<<step_l.ent.id()<<std::endl;
 			std::visit([&step_l, &ecs](auto&& arg) { remove_second(step_l.ent.mut(ecs), step_l.pair_first, arg); }, step_l.pair_second);
 		}
 		for(StateAddPairStep<variant_t> const &step_l : _addPair)
 		{
-			Logger::getDebug()<<" StateAddPairStep : "<<step_l.ent.id()<<std::endl;
+			OCTOPUS_LOG_DEBUG <<" StateAddPairStep : "<<step_l.ent.id()<<std::endl;
 			std::visit([&step_l, &ecs](auto&& arg) { add_second(step_l.ent.mut(ecs), step_l.pair_first, arg); }, step_l.pair_second);
 		}
 		for(StateSetComponentStep<variant_t> const &step_l : _setComp)
 		{
-			Logger::getDebug()<<" StateSetComponentStep : "<<step_l.ent.id()<<std::endl;
+			OCTOPUS_LOG_DEBUG <<" StateSetComponentStep : "<<step_l.ent.id()<<std::endl;
 			std::visit([&step_l, &ecs](auto&& arg) { step_l.ent.mut(ecs).set(arg); }, step_l.new_value);
 		}
 	}
 
 	void revert(flecs::world &ecs)
 	{
-		Logger::getDebug()<<"StateStepLayer revert"<<std::endl;
+		OCTOPUS_LOG_DEBUG <<"StateStepLayer revert"<<std::endl;
 		for(auto rit_l = _setComp.rbegin() ; rit_l != _setComp.rend() ; ++ rit_l)
 		{
 			StateSetComponentStep<variant_t> const &step_l = *rit_l;
-			Logger::getDebug()<<" StateRemovePairStep : "<<step_l.ent.id()<<std::endl;
+			OCTOPUS_LOG_DEBUG <<" StateRemovePairStep : "<<step_l.ent.id()<<std::endl;
 			std::visit([this, &step_l, &ecs](auto&& arg) { step_l.ent.mut(ecs).set(arg); }, step_l.old_value);
 		}
 		for(auto rit_l = _addPair.rbegin() ; rit_l != _addPair.rend() ; ++ rit_l)
 		{
 			StateAddPairStep<variant_t> const &step_l = *rit_l;
-			Logger::getDebug()<<" StateAddPairStep : "<<step_l.ent.id()<<std::endl;
+			OCTOPUS_LOG_DEBUG <<" StateAddPairStep : "<<step_l.ent.id()<<std::endl;
 			std::visit([this, &step_l, &ecs](auto&& arg) { remove_second(step_l.ent.mut(ecs), step_l.pair_first, arg); }, step_l.pair_second);
 		}
 		for(auto rit_l = _removePair.rbegin() ; rit_l != _removePair.rend() ; ++ rit_l)
 		{
 			StateRemovePairStep<variant_t> const &step_l = *rit_l;
-			Logger::getDebug()<<" StateSetComponentStep : "<<step_l.ent.id()<<std::endl;
+			OCTOPUS_LOG_DEBUG <<" StateSetComponentStep : "<<step_l.ent.id()<<std::endl;
 			std::visit([this, &step_l, &ecs](auto&& arg) { add_second(step_l.ent.mut(ecs), step_l.pair_first, arg); }, step_l.pair_second);
 		}
 	}
@@ -16,20 +16,35 @@ void ProductionQueueTimestampStep::revert_step(Data &d, Memento const &m) const
 
 void ProductionQueueOperationStep::apply_step(Data &d, Memento &m) const
 {
-	m.old_queue = d.queue;
+	m.canceled = false;
+	m.added = false;
 	if(canceled_idx >= 0 && canceled_idx < d.queue.size())
 	{
+		m.canceled_production = d.queue[canceled_idx];
+		m.canceled = true;
 		d.queue.erase(d.queue.begin()+canceled_idx);
+		d.queue_duration -= canceled_duration;
 	}
-	if(added_production != "")
+	if(!added_production.empty())
 	{
+		m.added = true;
 		d.queue.push_back(added_production);
+		d.queue_duration += added_duration;
 	}
 }
 
 void ProductionQueueOperationStep::revert_step(Data &d, Memento const &m) const
 {
-	d.queue = m.old_queue;
+	if(m.added)
+	{
+		d.queue.pop_back();
+		d.queue_duration -= added_duration;
+	}
+	if(m.canceled)
+	{
+		d.queue.insert(d.queue.begin()+canceled_idx, m.canceled_production);
+		d.queue_duration += canceled_duration;
+	}
 }
 
 } // namespace octopus
@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 #include "octopus/utils/Vector.hh"
+#include "octopus/utils/symbol/Symbol.hh"
 
 namespace octopus
 {
@@ -10,9 +11,16 @@ namespace octopus
 struct ProductionQueue
 {
 	int64_t start_timestamp = 0;
-	std::vector<std::string> queue;
+	std::vector<Symbol> queue;
 	/// @brief point where unit should spawn
 	Vector spawn_point = Vector(0,4);
+	/// @brief sum of the durations of the queued productions
+	/// kept up to date by ProductionQueueOperationStep and on set
+	/// @note not serialized
+	int64_t queue_duration = 0;
+
+	/// @brief tick at which the queue will be empty
+	int64_t queue_end() const { return start_timestamp + queue_duration; }
 };
 
 struct ProductionQueueTimestampMemento {
@@ -30,15 +38,23 @@ struct ProductionQueueTimestampStep {
 	void revert_step(Data &d, Memento const &memento) const;
 };
 
+/// @brief only the delta is stored, the queue is rebuilt on revert
 struct ProductionQueueOperationMemento {
-	std::vector<std::string> old_queue;
+	/// @brief production removed by the cancel
+	Symbol canceled_production;
+	bool canceled = false;
+	bool added = false;
 };
 
 struct ProductionQueueOperationStep {
 	// empty to not add anything
-	std::string added_production;
+	Symbol added_production;
 	// < 0 to no cancel anything
 	int canceled_idx = -1;
+	// duration of the added production
+	int64_t added_duration = 0;
+	// duration of the canceled production
+	int64_t canceled_duration = 0;
 
 	typedef ProductionQueue Data;
 	typedef ProductionQueueOperationMemento Memento;
@@ -3,6 +3,7 @@
 
 #include "octopus/components/step/Step.hh"
 #include "octopus/utils/fast_map/fast_map.hh"
+#include "octopus/utils/symbol/Symbol.hh"
 #include <unordered_map>
 #include <string>
 
@@ -10,10 +11,10 @@ namespace octopus
 {
 
 struct Caster {
-    fast_map<std::string, int64_t> timestamp_last_cast;
+    fast_map<Symbol, int64_t> timestamp_last_cast;
 	int64_t timestamp_windup_start = 0;
 
-    int64_t get_timestamp_last_call(std::string const &ability) const
+    int64_t get_timestamp_last_call(Symbol const &ability) const
     {
         auto &&it = timestamp_last_cast.data().find(ability);
         if(timestamp_last_cast.data().cend() != it)
@@ -23,7 +24,7 @@ struct Caster {
         return -1;
     }
 
-    bool check_timestamp_last_cast(int64_t reload, int64_t timestamp, std::string const &ability) const
+    bool check_timestamp_last_cast(int64_t reload, int64_t timestamp, Symbol const &ability) const
     {
         auto &&it = timestamp_last_cast.data().find(ability);
         return timestamp_last_cast.data().cend() == it
@@ -41,7 +42,7 @@ struct CasterLastCastMemento {
 
 struct CasterLastCastStep {
 	int64_t new_value = 0;
-    std::string ability;
+    Symbol ability;
 
 	typedef Caster Data;
 	typedef CasterLastCastMemento Memento;
@@ -1,11 +1,47 @@
 #include "PlayerUpgrade.hh"
+#include "UpgradeRequirement.hh"
 
 namespace octopus
 {
 
-bool check_upgrades(PlayerUpgrade const &upgrades, std::string const &upgrade, int64_t level)
+bool check_upgrades(PlayerUpgrade const &upgrades, Symbol const &upgrade, int64_t level)
 {
 	return upgrades.upgrades.safe_get(upgrade, 0) >= level;
 }
 
+bool PlayerUpgrade::is_satisfied(uint32_t requirement_p) const
+{
+	if(requirement_p < satisfied.size())
+	{
+		return satisfied[requirement_p];
+	}
+	return check_requirements(get_requirement(requirement_p), *this);
+}
+
+void PlayerUpgrade::update_satisfied(Symbol const &upgrade_p)
+{
+	if(satisfied.size() < requirement_count())
+	{
+		sync_satisfied();
+		return;
+	}
+	for(RequirementId id_l : get_dependent_requirements(upgrade_p))
+	{
+		if(id_l < satisfied.size())
+		{
+			satisfied[id_l] = check_requirements(get_requirement(id_l), *this);
+		}
+	}
+}
+
+void PlayerUpgrade::sync_satisfied()
+{
+	uint32_t const count_l = requirement_count();
+	satisfied.resize(count_l);
+	for(RequirementId id_l = 0 ; id_l < count_l ; ++ id_l)
+	{
+		satisfied[id_l] = check_requirements(get_requirement(id_l), *this);
+	}
+}
+
 } // namespace octopus
@@ -1,15 +1,32 @@
 #pragma once
 
 #include "octopus/utils/fast_map/fast_map.hh"
+#include "octopus/utils/symbol/Symbol.hh"
 #include <string>
 #include <cstdint>
+#include <vector>
 
 namespace octopus
 {
 
 struct PlayerUpgrade
 {
-	fast_map<std::string, int64_t> upgrades;
+	fast_map<Symbol, int64_t> upgrades;
+
+	/// @brief satisfaction of the registered requirements indexed by RequirementId
+	/// kept up to date by PlayerUpgradeStep and on set
+	/// @note not serialized
+	std::vector<bool> satisfied;
+
+	/// @brief return true if the registered requirement is met
+	/// @note requirements registered after the last sync are checked on the map
+	bool is_satisfied(uint32_t requirement_p) const;
+
+	/// @brief recompute the requirements depending on the upgrade
+	void update_satisfied(Symbol const &upgrade_p);
+
+	/// @brief recompute every registered requirement
+	void sync_satisfied();
 };
 
 struct PlayerUpgradeMemento {
@@ -17,7 +34,7 @@ struct PlayerUpgradeMemento {
 };
 
 struct PlayerUpgradeStep {
-	std::string upgrade;
+	Symbol upgrade;
 	int64_t delta = 1;
 
 	typedef PlayerUpgrade Data;
@@ -27,14 +44,16 @@ struct PlayerUpgradeStep {
 	{
 		memento.value = d.upgrades[upgrade];
 		d.upgrades[upgrade] += delta;
+		d.update_satisfied(upgrade);
 	}
 
 	void revert_step(Data &d, Memento const &memento) const
 	{
 		d.upgrades[upgrade] = memento.value;
+		d.update_satisfied(upgrade);
 	}
 };
 
-bool check_upgrades(PlayerUpgrade const &upgrades, std::string const &upgrade, int64_t level);
+bool check_upgrades(PlayerUpgrade const &upgrades, Symbol const &upgrade, int64_t level);
 
 } // namespace octopus
@@ -1,7 +1,14 @@
 #include "UpgradeRequirement.hh"
 #include "PlayerUpgrade.hh"
 
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <utility>
+
 #include "octopus/world/player/PlayerInfo.hh"
+#include "octopus/world/player/PlayerRegistry.hh"
 
 namespace octopus
 {
@@ -15,27 +22,132 @@ bool check_requirements(UpgradeRequirement const &req, PlayerUpgrade const &up)
 	return true;
 }
 
-bool check_requirements(flecs::entity entity, flecs::world const &ecs, UpgradeRequirement const &requirements) {
+namespace
+{
+
+/// @brief registered requirements and the dependency index
+/// from upgrades (by symbol id) to requirements
+/// deques are used to keep references valid when registering
+struct RequirementTable
+{
+	std::mutex mutex;
+	std::deque<UpgradeRequirement> requirements;
+	std::deque<std::vector<RequirementId> > dependents;
+	/// @brief sorted (upgrade, level) list to deduplicate requirements
+	std::map<std::vector<std::pair<uint32_t, int64_t> >, RequirementId> ids;
+};
+
+RequirementTable &get_table()
+{
+	static RequirementTable table_l;
+	return table_l;
+}
+
+std::vector<RequirementId> const no_dependents;
+
+} // namespace
+
+RequirementId register_requirement(UpgradeRequirement const &req)
+{
+	std::vector<std::pair<uint32_t, int64_t> > key_l;
+	for(auto &&pair : req.upgrades.data()) {
+		key_l.push_back({pair.first.id, pair.second});
+	}
+	std::sort(key_l.begin(), key_l.end());
+
+	RequirementTable &table_l = get_table();
+	std::lock_guard<std::mutex> lock_l(table_l.mutex);
+	auto &&it = table_l.ids.find(key_l);
+	if(it != table_l.ids.end()) {
+		return it->second;
+	}
+	RequirementId id_l = table_l.requirements.size();
+	table_l.requirements.push_back(req);
+	table_l.ids[key_l] = id_l;
+	for(auto &&pair : key_l) {
+		if(table_l.dependents.size() <= pair.first) {
+			table_l.dependents.resize(pair.first+1);
+		}
+		table_l.dependents[pair.first].push_back(id_l);
+	}
+	return id_l;
+}
+
+uint32_t requirement_count()
+{
+	RequirementTable &table_l = get_table();
+	std::lock_guard<std::mutex> lock_l(table_l.mutex);
+	return table_l.requirements.size();
+}
+
+UpgradeRequirement const &get_requirement(RequirementId id)
+{
+	return get_table().requirements.at(id);
+}
+
+std::vector<RequirementId> const &get_dependent_requirements(Symbol const &upgrade)
+{
+	RequirementTable const &table_l = get_table();
+	if(upgrade.id < table_l.dependents.size()) {
+		return table_l.dependents[upgrade.id];
+	}
+	return no_dependents;
+}
+
+namespace
+{
+
+/// @brief get the upgrades of the player owning the entity
+/// using the player registry when set up
+PlayerUpgrade const *get_player_upgrade(flecs::entity entity, flecs::world const &ecs)
+{
+	if(ecs.try_get<PlayerRegistry>())
+	{
+		PlayerEntry const *entry = get_player_entry(entity, ecs);
+		return entry ? entry->player_upgrade.try_get() : nullptr;
+	}
 	flecs::entity player = get_player_from_appartenance(entity, ecs);
-	if(player.try_get<PlayerUpgrade>()) {
-		return check_requirements(requirements, *player.try_get<PlayerUpgrade>());
+	return player.is_valid() ? player.try_get<PlayerUpgrade>() : nullptr;
+}
+
+} // namespace
+
+bool check_requirements(flecs::entity entity, flecs::world const &ecs, UpgradeRequirement const &requirements) {
+	PlayerUpgrade const *up = get_player_upgrade(entity, ecs);
+	if(up) {
+		return check_requirements(requirements, *up);
 	}
 	return check_requirements(requirements, PlayerUpgrade());
 }
 
+bool check_requirements(flecs::entity entity, flecs::world const &ecs, RequirementId id) {
+	PlayerUpgrade const *up = get_player_upgrade(entity, ecs);
+	if(up) {
+		return up->is_satisfied(id);
+	}
+	return check_requirements(get_requirement(id), PlayerUpgrade());
+}
+
 std::vector<std::string> explain_unmet_requirements(flecs::entity entity, flecs::world const &ecs, UpgradeRequirement const &requirements) {
 	std::vector<std::string> explaination;
-	flecs::entity player = get_player_from_appartenance(entity, ecs);
-	PlayerUpgrade up;
-	if(player.try_get<PlayerUpgrade>()) {
-		up = *player.try_get<PlayerUpgrade>();
+	static PlayerUpgrade const no_upgrade;
+	PlayerUpgrade const *up = get_player_upgrade(entity, ecs);
+	if(!up) {
+		up = &no_upgrade;
 	}
 	for(auto &&pair : requirements.upgrades.data()) {
-		if(!check_upgrades(up, pair.first, pair.second)) {
-			explaination.push_back(pair.first + " " + std::to_string(pair.second));
+		if(!check_upgrades(*up, pair.first, pair.second)) {
+			explaination.push_back(pair.first.name() + " " + std::to_string(pair.second));
 		}
 	}
 	return explaination;
 }
 
+std::vector<std::string> explain_unmet_requirements(flecs::entity entity, flecs::world const &ecs, RequirementId id) {
+	if(check_requirements(entity, ecs, id)) {
+		return {};
+	}
+	return explain_unmet_requirements(entity, ecs, get_requirement(id));
+}
+
 }
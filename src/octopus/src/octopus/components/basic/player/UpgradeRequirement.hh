@@ -1,8 +1,10 @@
 #pragma once
 
 #include "octopus/utils/fast_map/fast_map.hh"
+#include "octopus/utils/symbol/Symbol.hh"
 #include <string>
 #include <cstdint>
+#include <limits>
 #include <vector>
 
 namespace octopus
@@ -11,11 +13,33 @@ struct PlayerUpgrade;
 
 struct UpgradeRequirement
 {
-	fast_map<std::string, int64_t> upgrades;
+	fast_map<Symbol, int64_t> upgrades;
 };
 
+/// @brief index of a requirement in the process wide requirement index
+/// (see register_requirement)
+using RequirementId = uint32_t;
+constexpr RequirementId no_requirement_id = std::numeric_limits<RequirementId>::max();
+
+/// @brief register the requirement so that its satisfaction is cached
+/// in every PlayerUpgrade, identical requirements share the same id
+/// @note requirements are registered by the template libraries and
+/// must not be registered while steps are applied
+RequirementId register_requirement(UpgradeRequirement const &req);
+
+/// @brief number of registered requirements
+uint32_t requirement_count();
+
+/// @brief registered requirement from its id
+UpgradeRequirement const &get_requirement(RequirementId id);
+
+/// @brief ids of the registered requirements depending on the upgrade
+std::vector<RequirementId> const &get_dependent_requirements(Symbol const &upgrade);
+
 bool check_requirements(UpgradeRequirement const &req, PlayerUpgrade const &up);
 bool check_requirements(flecs::entity entity, flecs::world const &ecs, UpgradeRequirement const &requirements);
+bool check_requirements(flecs::entity entity, flecs::world const &ecs, RequirementId id);
 std::vector<std::string> explain_unmet_requirements(flecs::entity entity, flecs::world const &ecs, UpgradeRequirement const &requirements);
+std::vector<std::string> explain_unmet_requirements(flecs::entity entity, flecs::world const &ecs, RequirementId id);
 
 }
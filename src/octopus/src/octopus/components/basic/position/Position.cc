@@ -80,4 +80,43 @@ void StuckInfoStep::revert_step(Data &d, Memento const &memento) const
 	d.stuck_info = memento.old_info;
 }
 
+///////////////////////////
+/// Kinematic STEP
+///////////////////////////
+
+void KinematicStep::apply_step(Data &d, Memento &memento) const
+{
+	memento.old_pos = d.pos;
+	memento.old_velocity = d.velocity;
+	memento.old_step_stuck = d.stuck_info.step_stuck;
+	memento.old_last_pos = d.stuck_info.last_pos;
+	d.pos += delta;
+	d.velocity = new_velocity;
+	d.stuck_info.step_stuck = new_step_stuck;
+	d.stuck_info.last_pos = new_last_pos;
+}
+
+void KinematicStep::revert_step(Data &d, Memento const &memento) const
+{
+	d.pos = memento.old_pos;
+	d.velocity = memento.old_velocity;
+	d.stuck_info.step_stuck = memento.old_step_stuck;
+	d.stuck_info.last_pos = memento.old_last_pos;
+}
+
+///////////////////////////
+/// Sleep STEP
+///////////////////////////
+
+void SleepStep::apply_step(Data &d, Memento &memento) const
+{
+	memento.old_sleeping = d.stuck_info.sleeping;
+	d.stuck_info.sleeping = sleeping;
+}
+
+void SleepStep::revert_step(Data &d, Memento const &memento) const
+{
+	d.stuck_info.sleeping = memento.old_sleeping;
+}
+
 }
@@ -9,9 +9,12 @@ namespace octopus
 
 /// @brief Structure to allow tracking for
 /// stuck entities
+/// @note also used to track idle entities, a sleeping
+/// entity is skipped by the moving systems until woken up
 struct StuckInfo {
 	uint8_t step_stuck = 0;
 	Vector last_pos;
+	bool sleeping = false;
 };
 
 struct Collision {
@@ -121,5 +124,64 @@ struct StuckInfoStep {
 	void revert_step(Data &d, Memento const &memento) const;
 };
 
+///////////////////////////
+/// Kinematic STEP
+///////////////////////////
+
+struct KinematicMemento {
+	Vector old_pos;
+	Vector old_velocity;
+	uint8_t old_step_stuck;
+	Vector old_last_pos;
+};
+
+/// @brief fused step for moving entities
+/// updating position, velocity and stuck info at once
+/// (one reference and one memento instead of three)
+/// @note does not change the sleeping flag (see SleepStep)
+struct KinematicStep {
+	Vector delta;
+	Vector new_velocity;
+	uint8_t new_step_stuck;
+	Vector new_last_pos;
+
+	typedef Position Data;
+	typedef KinematicMemento Memento;
+
+	void apply_step(Data &d, Memento &memento) const;
+
+	void revert_step(Data &d, Memento const &memento) const;
+};
+
+///////////////////////////
+/// Sleep STEP
+///////////////////////////
+
+struct SleepMemento {
+	bool old_sleeping;
+};
+
+/// @brief only change the sleeping flag so that it can
+/// be combined with a KinematicStep on the same entity
+struct SleepStep {
+	bool sleeping;
+
+	typedef Position Data;
+	typedef SleepMemento Memento;
+
+	void apply_step(Data &d, Memento &memento) const;
+
+	void revert_step(Data &d, Memento const &memento) const;
+};
+
+/// @brief add a step to wake up the entity if it is sleeping
+template<class StepContainer_t>
+void wake_up(flecs::entity e, Position const &pos_p, StepContainer_t &container_p)
+{
+	if(pos_p.stuck_info.sleeping)
+	{
+		container_p.template get<SleepStep>().add_step(e, SleepStep{false});
+	}
+}
 
 }
@@ -39,6 +39,8 @@ struct BuffComponentInitStep : BaseComponentStep
             val->init = init;
         }
 	}
+
+	size_t footprint() const override { return sizeof(*this); }
 };
 
 template<typename component_t>
@@ -73,6 +75,8 @@ struct AddBuffComponentStep : BaseComponentStep
 			e.remove<BuffComponent<component_t>>();
 		}
 	}
+
+	size_t footprint() const override { return sizeof(*this); }
 };
 
 template<typename component_t, class StepManager_t>
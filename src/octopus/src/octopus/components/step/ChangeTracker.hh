@@ -0,0 +1,82 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+#include "flecs.h"
+
+#include "Step.hh"
+#include "StepContainer.hh"
+
+namespace octopus
+{
+
+/// @brief Entities which had their component T written
+/// since the last consolidation
+/// Steps are read from the step layers (see add_step_changes)
+/// other writes (component steps, entity creation, set)
+/// are recorded by an OnSet observer (see track_changes)
+/// @note singleton, opt in using track_changes<T>(ecs)
+template<typename T>
+struct ChangeTracker
+{
+	std::vector<flecs::entity> changed;
+};
+
+/// @brief register the tracker singleton and the observer
+/// recording writes not going through steps
+template<typename T>
+void track_changes(flecs::world &ecs)
+{
+	if(ecs.try_get<ChangeTracker<T>>()) { return; }
+	ecs.add<ChangeTracker<T>>();
+	ecs.observer<T const>()
+		.event(flecs::OnSet)
+		.each([](flecs::entity e, T const &) {
+			e.world().template try_get_mut<ChangeTracker<T>>()->changed.push_back(e);
+		});
+}
+
+/// @brief add all entities targeted by the steps of the vector
+template<typename Step_t>
+void add_changes(ChangeTracker<typename Step_t::Data> &tracker_p, StepVector<Step_t> const &vec_p)
+{
+	for(StepTuple<Step_t> const &tuple_l : vec_p.steps)
+	{
+		tracker_p.changed.push_back(tuple_l.data.entity());
+	}
+}
+
+/// @brief add all entities targeted by Step_t in the last
+/// prelayer and layer of the step manager
+/// @note does nothing if the step manager does not handle Step_t
+template<typename Step_t, typename StepManager_t>
+void add_step_changes(ChangeTracker<typename Step_t::Data> &tracker_p, StepManager_t &manager_p)
+{
+	using container_t = std::decay_t<decltype(manager_p.get_last_layer().back())>;
+	if constexpr (has_step_type<Step_t, container_t>::value)
+	{
+		for(auto &container_l : manager_p.get_last_prelayer())
+		{
+			add_changes(tracker_p, container_l.template get<Step_t>());
+		}
+		for(auto &container_l : manager_p.get_last_layer())
+		{
+			add_changes(tracker_p, container_l.template get<Step_t>());
+		}
+	}
+}
+
+/// @brief sort changes by id and remove duplicates
+/// to iterate them in a deterministic order
+template<typename T>
+std::vector<flecs::entity> const & consolidate_changes(ChangeTracker<T> &tracker_p)
+{
+	std::vector<flecs::entity> &changed_l = tracker_p.changed;
+	std::sort(changed_l.begin(), changed_l.end(), [](flecs::entity const &a, flecs::entity const &b) {
+		return a.id() < b.id();
+	});
+	changed_l.erase(std::unique(changed_l.begin(), changed_l.end()), changed_l.end());
+	return changed_l;
+}
+
+} // octopus
@@ -11,6 +11,8 @@ struct BaseComponentStep
 	virtual ~BaseComponentStep() {}
 	virtual void apply_step(flecs::entity e) = 0;
 	virtual void revert_step(flecs::entity e) = 0;
+	/// @brief bytes held by the step (used for history memory accounting)
+	virtual size_t footprint() const { return sizeof(BaseComponentStep); }
 };
 
 struct ComponentStep
@@ -73,6 +75,8 @@ struct AddComponentStep : BaseComponentStep
 			e.set<component_t>(old_value);
 		}
 	}
+
+	size_t footprint() const override { return sizeof(*this); }
 };
 
 template<typename component_t>
@@ -99,6 +103,8 @@ struct RemoveComponentStep : BaseComponentStep
 			e.set<component_t>(old_value);
 		}
 	}
+
+	size_t footprint() const override { return sizeof(*this); }
 };
 
 }
@@ -4,6 +4,8 @@
 #include <flecs.h>
 #include <vector>
 
+#include "octopus/utils/profiler/CostAttribution.hh"
+
 namespace octopus
 {
 
@@ -20,11 +22,13 @@ struct StepVector {
 
 	void add_step(flecs::entity ent, T && step_p)
 	{
+		CostAttribution::count_step();
 		steps.push_back({ent.get_ref<typename T::Data>(), step_p, typename T::Memento()});
 	}
 
 	void add_step(flecs::ref<typename T::Data> ref, T && step_p)
 	{
+		CostAttribution::count_step();
 		steps.push_back({ref, step_p, T::Memento()});
 	}
 };
@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <variant>
+#include <type_traits>
 #include <list>
 #include "flecs.h"
 
@@ -13,6 +14,7 @@
 #include "octopus/components/basic/position/Position.hh"
 
 #include "octopus/utils/ThreadPool.hh"
+#include "octopus/utils/profiler/Profiler.hh"
 
 namespace octopus
 {
@@ -39,6 +41,13 @@ struct StepContainerCascade<T, Ts...> : StepContainerCascade<Ts...> {
 	StepVector<T> steps;
 };
 
+/// @brief tell if the container handles steps of type G
+template <class G, class Container_t>
+struct has_step_type : std::false_type {};
+
+template <class G, class... Ts>
+struct has_step_type<G, StepContainerCascade<Ts...>> : std::disjunction<std::is_same<G, Ts>...> {};
+
 template <class... Ts>
 StepContainerCascade<Ts...> makeStepContainer()
 {
@@ -67,6 +76,7 @@ template<class... Ts> void apply_container(StepContainerCascade<Ts...> &containe
 template<class T, class... Ts> void apply_container(StepContainerCascade<T, Ts...> &container, std::vector<std::function<void()>> &jobs)
 {
 	jobs.push_back([&container]() {
+			OCTOPUS_ZONE(flecs::_::type_name<T>())
 			apply_all(container.steps);
 	});
 
@@ -96,7 +106,7 @@ void dispatch_apply(std::vector<StepContainer_t> &container, ThreadPool &pool)
 
 		apply_container(container[i], jobs_l);
 
-		enqueue_and_wait(pool, jobs_l);
+		enqueue_and_wait(pool, jobs_l, "step.apply");
 	}
 }
 
@@ -109,7 +119,7 @@ void dispatch_revert(std::vector<StepContainer_t> &container, ThreadPool &pool)
 
 		revert_container(container[i-1], jobs_l);
 
-		enqueue_and_wait(pool, jobs_l);
+		enqueue_and_wait(pool, jobs_l, "step.revert");
 	}
 }
 
@@ -4,6 +4,7 @@
 
 #include "flecs.h"
 #include "octopus/utils/ThreadPool.hh"
+#include "octopus/utils/profiler/Profiler.hh"
 #include "octopus/components/step/ComponentStepContainer.hh"
 #include "octopus/components/step/StepContainer.hh"
 #include "octopus/commands/queue/CommandQueue.hh"
@@ -14,6 +15,7 @@ namespace octopus
 
 /// @brief revert a given number of steps and command memento
 /// @note do no clear the containers
+/// @note every kind of step reverted is a profiler zone (revert.*)
 /// @tparam StepManager_t instance of StepManager in StepContainer.hh
 /// @tparam CommandMementoManager_t CommandQueueMementoManager in CommandQueue.hh
 /// @tparam StateStepContainer_t StateStepContainer in StateChangeStep.hh
@@ -29,11 +31,11 @@ void revert_n_steps(flecs::world &ecs, ThreadPool &pool_p, size_t steps_p,
 )
 {
 	// revert entity steps
-	flecs::query<StepEntityManager> query_step_entity_manager_l = ecs.query<StepEntityManager>();
 	size_t entity_steps_reverted = 0;
 
 	if(ecs.try_get<StepEntityManager>())
 	{
+		OCTOPUS_ZONE("revert.entity_creation")
 		StepEntityManager const &step_entity_manager_p = *ecs.try_get<StepEntityManager>();
 		for(auto rit_l = step_entity_manager_p.creation_steps_memento.rbegin() ; entity_steps_reverted < steps_p && rit_l != step_entity_manager_p.creation_steps_memento.rend() ; ++ rit_l)
 		{
@@ -52,63 +54,81 @@ void revert_n_steps(flecs::world &ecs, ThreadPool &pool_p, size_t steps_p,
 	flecs::query<CommandQueue<typename CommandMementoManager_t::variant>> q = ecs.query<CommandQueue<typename CommandMementoManager_t::variant>>();
 
 	size_t memento_reverted = 0;
-	for(auto rit_l = command_memento_p.lMementos.rbegin() ; memento_reverted < steps_p && rit_l != command_memento_p.lMementos.rend() ; ++ rit_l)
 	{
-		// clear queued actions first
-		q.each([](flecs::entity e, CommandQueue<typename CommandMementoManager_t::variant> &queue_p) {
-			queue_p._queuedActions.clear();
-		});
-		// apply all mementos
-		std::vector<CommandQueueMemento<typename CommandMementoManager_t::variant> > const &mementos_l = *rit_l;
-		for(CommandQueueMemento<typename CommandMementoManager_t::variant> const &memento_l : mementos_l)
+		OCTOPUS_ZONE("revert.command_mementos")
+		for(auto rit_l = command_memento_p.lMementos.rbegin() ; memento_reverted < steps_p && rit_l != command_memento_p.lMementos.rend() ; ++ rit_l)
 		{
-			restore(ecs, memento_l);
-		}
+			// clear queued actions first
+			q.each([](flecs::entity e, CommandQueue<typename CommandMementoManager_t::variant> &queue_p) {
+				queue_p._queuedActions.clear();
+			});
+			// apply all mementos (in reverse order since they are deltas)
+			std::vector<CommandQueueMemento<typename CommandMementoManager_t::variant> > const &mementos_l = *rit_l;
+			for(auto rit_memento_l = mementos_l.rbegin() ; rit_memento_l != mementos_l.rend() ; ++ rit_memento_l)
+			{
+				restore(ecs, *rit_memento_l);
+			}
 
-		++memento_reverted;
+			++memento_reverted;
+		}
 	}
 
 	// revert component addition/deletion
 	size_t component_steps_reverted = 0;
-	for(auto rit_l = step_manager_p.component_steps.rbegin() ; component_steps_reverted < steps_p && rit_l != step_manager_p.component_steps.rend() ; ++ rit_l)
 	{
-		std::vector<ComponentStepContainer> &steps_l = *rit_l;
-		revert_all_containers(steps_l);
-		++component_steps_reverted;
+		OCTOPUS_ZONE("revert.component_steps")
+		for(auto rit_l = step_manager_p.component_steps.rbegin() ; component_steps_reverted < steps_p && rit_l != step_manager_p.component_steps.rend() ; ++ rit_l)
+		{
+			std::vector<ComponentStepContainer> &steps_l = *rit_l;
+			revert_all_containers(steps_l);
+			++component_steps_reverted;
+		}
 	}
 
 	// revert component state addition/deletion
 	size_t steps_state_reverted = 0;
-	for(auto rit_l = state_step_container_p.layers.rbegin() ; steps_state_reverted < steps_p && rit_l != state_step_container_p.layers.rend() ; ++ rit_l)
 	{
-		rit_l->revert(ecs);
-		++steps_state_reverted;
+		OCTOPUS_ZONE("revert.state_steps")
+		for(auto rit_l = state_step_container_p.layers.rbegin() ; steps_state_reverted < steps_p && rit_l != state_step_container_p.layers.rend() ; ++ rit_l)
+		{
+			rit_l->revert(ecs);
+			++steps_state_reverted;
+		}
 	}
 
 	// revert components (steps)
 	size_t steps_reverted = 0;
-	for(auto rit_l = step_manager_p.steps.rbegin() ; steps_reverted < steps_p && rit_l != step_manager_p.steps.rend() ; ++ rit_l)
 	{
-		std::vector<typename StepManager_t::StepContainer> &steps_l = *rit_l;
-		dispatch_revert(steps_l, pool_p);
-		++steps_reverted;
+		OCTOPUS_ZONE("revert.steps")
+		for(auto rit_l = step_manager_p.steps.rbegin() ; steps_reverted < steps_p && rit_l != step_manager_p.steps.rend() ; ++ rit_l)
+		{
+			std::vector<typename StepManager_t::StepContainer> &steps_l = *rit_l;
+			dispatch_revert(steps_l, pool_p);
+			++steps_reverted;
+		}
 	}
 
 	// revert component addition/deletion (presteps)
 	size_t presteps_state_reverted = 0;
-	for(auto rit_l = state_step_container_p.prelayers.rbegin() ; presteps_state_reverted < steps_p && rit_l != state_step_container_p.prelayers.rend() ; ++ rit_l)
 	{
-		rit_l->revert(ecs);
-		++presteps_state_reverted;
+		OCTOPUS_ZONE("revert.state_steps")
+		for(auto rit_l = state_step_container_p.prelayers.rbegin() ; presteps_state_reverted < steps_p && rit_l != state_step_container_p.prelayers.rend() ; ++ rit_l)
+		{
+			rit_l->revert(ecs);
+			++presteps_state_reverted;
+		}
 	}
 
 	// revert components (presteps)
 	size_t presteps_reverted = 0;
-	for(auto rit_l = step_manager_p.presteps.rbegin() ; presteps_reverted < steps_p && rit_l != step_manager_p.presteps.rend() ; ++ rit_l)
 	{
-		std::vector<typename StepManager_t::StepContainer> &steps_l = *rit_l;
-		dispatch_revert(steps_l, pool_p);
-		++presteps_reverted;
+		OCTOPUS_ZONE("revert.steps")
+		for(auto rit_l = step_manager_p.presteps.rbegin() ; presteps_reverted < steps_p && rit_l != step_manager_p.presteps.rend() ; ++ rit_l)
+		{
+			std::vector<typename StepManager_t::StepContainer> &steps_l = *rit_l;
+			dispatch_revert(steps_l, pool_p);
+			++presteps_reverted;
+		}
 	}
 
 	// sanity check
@@ -130,6 +150,7 @@ void clear_n_steps(flecs::world &ecs, size_t steps_p, StepManager_t &step_manage
 	CommandMementoManager_t &command_memento_p,
 	StateStepContainer_t & state_step_container_p)
 {
+	OCTOPUS_ZONE("clear_n_steps")
 	for(size_t i = 0 ; i < steps_p; ++i)
 	{
 		step_manager_p.pop_last_layer();
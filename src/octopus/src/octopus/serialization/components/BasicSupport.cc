@@ -54,7 +54,8 @@ void basic_components_support(flecs::world& ecs)
 		.member("ray", &Collision::ray);
 	ecs.component<StuckInfo>()
 		.member("step_stuck", &StuckInfo::step_stuck)
-		.member("last_pos", &StuckInfo::last_pos);
+		.member("last_pos", &StuckInfo::last_pos)
+		.member("sleeping", &StuckInfo::sleeping);
     ecs.component<Position>()
         .member("pos", &Position::pos)
         .member("velocity", &Position::velocity)
@@ -107,6 +108,9 @@ void basic_components_support(flecs::world& ecs)
     ecs.component<std::vector<std::string> >()
         .opaque(std_vector_support<std::string>);
 
+    ecs.component<std::vector<Symbol> >()
+        .opaque(std_vector_support<Symbol>);
+
     ecs.component<std::vector<flecs::entity> >()
         .opaque(std_vector_support<flecs::entity>);
 
@@ -148,6 +152,13 @@ void basic_components_support(flecs::world& ecs)
 	ecs.component<fast_map<std::string, int64_t> >()
 		.opaque(fast_map_support<std::string, int64_t>);
 
+    ecs.component<Entry<Symbol, int64_t>>()
+        .member("key", &Entry<Symbol, int64_t>::key)
+        .member("val", &Entry<Symbol, int64_t>::val);
+
+	ecs.component<fast_map<Symbol, int64_t> >()
+		.opaque(fast_map_support<Symbol, int64_t>);
+
 	ecs.component<PlayerUpgrade>()
 		.member("upgrades", &PlayerUpgrade::upgrades);
 
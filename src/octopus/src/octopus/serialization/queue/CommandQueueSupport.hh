@@ -4,8 +4,10 @@
 #include <list>
 
 #include "octopus/serialization/containers/ListSupport.hh"
+#include "octopus/serialization/containers/VectorSupport.hh"
 #include "octopus/serialization/variant/VariantSupport.hh"
 
+#include "octopus/commands/queue/CommandList.hh"
 #include "octopus/commands/queue/CommandQueue.hh"
 #include "octopus/commands/queue/action/CommandQueueAction.hh"
 
@@ -33,8 +35,10 @@ void command_queue_support(flecs::world& world) {
 
 	typedef std::variant<tArgs...> variant_args;
 
-    world.component<std::list<variant_args> >()
-        .opaque(std_list_support<variant_args>);
+    world.component<octopus::CommandList<variant_args> >()
+        .opaque(std_list_support<variant_args, octopus::CommandList<variant_args> >);
+    world.component<std::vector<variant_args> >()
+        .opaque(std_vector_support<variant_args>);
 
 	////
 	//// Actions
@@ -65,8 +69,8 @@ void command_queue_support(flecs::world& world) {
 		octopus::CommandQueueActionAddBack<variant_args >
 	> variant_actions;
 
-    world.component<std::list<variant_actions> >()
-        .opaque(std_list_support<variant_actions>);
+    world.component<octopus::CommandList<variant_actions> >()
+        .opaque(std_list_support<variant_actions, octopus::CommandList<variant_actions> >);
 
     world.component<octopus::CommandQueue<variant_args> >()
         .member("current", &octopus::CommandQueue<variant_args>::_current)
@@ -6,6 +6,7 @@
 #include "octopus/components/basic/hitpoint/HitPointMax.hh"
 #include "octopus/components/basic/position/Position.hh"
 #include "octopus/components/advanced/buff/DebuffAll.hh"
+#include "octopus/utils/symbol/Symbol.hh"
 
 namespace octopus
 {
@@ -29,6 +30,17 @@ void utils_support(flecs::world& ecs)
             .assign_string([](std::string* data, const char *value) {
                 *data = value; // Assign new value to std::string
             });
+
+    // Symbols are saved as their name and interned on load
+    ecs.component<Symbol>()
+        .opaque(flecs::String)
+            .serialize([](const flecs::serializer *s, const Symbol *data) {
+                const char *str = data->name().c_str();
+                return s->value(flecs::String, &str);
+            })
+            .assign_string([](Symbol* data, const char *value) {
+                *data = Symbol(value);
+            });
 }
 
 std::string save_world(flecs::world &ecs) {
@@ -1,8 +1,39 @@
 #include "Systems.hh"
 
+#include <vector>
+
 namespace octopus
 {
 
+namespace
+{
+
+/// @brief build a pipeline running every system of the world in phase order
+/// except the ones in the skipped phases
+/// @note the query is cached by flecs so switching between pipelines does not
+/// require any rebuild, and phases without system do not appear in the schedule
+void build_phase_pipeline(flecs::world &ecs, flecs::entity pipeline, std::vector<flecs::entity> const &skipped_phases)
+{
+	if(pipeline.has(flecs::Pipeline)) { return; }
+
+	// same terms as the flecs builtin pipeline
+	flecs::pipeline_builder<> builder(ecs, pipeline);
+	builder.with(flecs::System)
+		.with(flecs::Phase).cascade(flecs::DependsOn)
+		.without(flecs::DependsOn, flecs::OnStart).self().up(flecs::DependsOn)
+		.without(flecs::Disabled).up(flecs::DependsOn)
+		.without(flecs::Disabled).up(flecs::ChildOf);
+
+	for(flecs::entity const &phase : skipped_phases)
+	{
+		builder.without(flecs::DependsOn, phase);
+	}
+
+	builder.build();
+}
+
+} // namespace
+
 void set_up_phases(flecs::world &ecs)
 {
 	// set up phases
@@ -86,38 +117,27 @@ void set_up_phases(flecs::world &ecs)
 	/*flecs::entity endCleanupPhase = */ecs.entity(EndCleanUpPhase)
 		.add(flecs::Phase)
 		.depends_on(displaySyncPhase);
+
+	// precompute both schedules so that pausing is only a pipeline switch
+	build_phase_pipeline(ecs, ecs.entity<UnpausedPipeline>(), {});
+	build_phase_pipeline(ecs, ecs.entity<PausedPipeline>(), {updatePhase, postUpdatePhase, movingPhase});
+
+	ecs.set_pipeline(ecs.entity<UnpausedPipeline>());
 }
 
 void pause_phases(flecs::world &ecs)
 {
-	ecs.entity(UpdatePhase).disable();
-	ecs.entity(PostUpdatePhase).disable();
-	ecs.entity(MovingPhase).disable();
-
-    ecs.entity(UpdateUnpausedPhase).add(flecs::DependsOn, ecs.entity(PreUpdatePhase));
-    ecs.entity(UpdateUnpausedPhase).remove(flecs::DependsOn, ecs.entity(UpdatePhase));
-
-    ecs.entity(PostUpdateUnpausedPhase).add(flecs::DependsOn, ecs.entity(UpdateUnpausedPhase));
-    ecs.entity(PostUpdateUnpausedPhase).remove(flecs::DependsOn, ecs.entity(PostUpdatePhase));
-
-    ecs.entity(InputPhase).add(flecs::DependsOn, ecs.entity(EndUpdatePhase));
-    ecs.entity(InputPhase).remove(flecs::DependsOn, ecs.entity(MovingPhase));
+	ecs.set_pipeline(ecs.entity<PausedPipeline>());
 }
 
 void unpause_phases(flecs::world &ecs)
 {
-	ecs.entity(UpdatePhase).enable();
-	ecs.entity(PostUpdatePhase).enable();
-	ecs.entity(MovingPhase).enable();
-
-    ecs.entity(UpdateUnpausedPhase).remove(flecs::DependsOn, ecs.entity(PreUpdatePhase));
-    ecs.entity(UpdateUnpausedPhase).add(flecs::DependsOn, ecs.entity(UpdatePhase));
-
-    ecs.entity(PostUpdateUnpausedPhase).remove(flecs::DependsOn, ecs.entity(UpdateUnpausedPhase));
-    ecs.entity(PostUpdateUnpausedPhase).add(flecs::DependsOn, ecs.entity(PostUpdatePhase));
+	ecs.set_pipeline(ecs.entity<UnpausedPipeline>());
+}
 
-    ecs.entity(InputPhase).remove(flecs::DependsOn, ecs.entity(EndUpdatePhase));
-    ecs.entity(InputPhase).add(flecs::DependsOn, ecs.entity(MovingPhase));
+bool are_phases_paused(flecs::world const &ecs)
+{
+	return ecs.get_pipeline() == ecs.entity<PausedPipeline>();
 }
 
 }
@@ -9,15 +9,21 @@
 #include "octopus/commands/basic/move/AttackCommandSystem.hh"
 #include "octopus/commands/basic/move/MoveCommand.hh"
 #include "octopus/commands/basic/rally_point/SetRallyPointCommand.hh"
+#include "octopus/systems/budget/BudgetSystems.hh"
 #include "octopus/systems/hitpoint/HitPointsSystems.hh"
+#include "octopus/systems/metrics/MetricsSystems.hh"
 #include "octopus/systems/position/PositionSystems.hh"
+#include "octopus/systems/step/HistoryMemorySystems.hh"
 #include "octopus/systems/step/StepSystems.hh"
 #include "octopus/systems/production/ProductionSystem.hh"
 #include "octopus/systems/projectile/ProjectileSystem.hh"
 #include "octopus/systems/input/Input.hh"
+#include "octopus/systems/timer/TimerSystems.hh"
 #include "octopus/systems/timestamp/TimeStampSystems.hh"
 
+#include "octopus/world/player/PlayerRegistry.hh"
 #include "octopus/world/production/ProductionTemplateLibrary.hh"
+#include "octopus/world/resources/ResourceLedger.hh"
 #include "octopus/world/resources/ResourceSpent.hh"
 #include "octopus/world/StepContext.hh"
 #include "octopus/world/WorldContext.hh"
@@ -27,9 +33,18 @@
 namespace octopus
 {
 
+/// @brief tag of the pipeline running all phases
+struct UnpausedPipeline {};
+/// @brief tag of the pipeline skipping the phases disabled during a pause
+/// (Update, PostUpdate and Moving)
+struct PausedPipeline {};
+
 void set_up_phases(flecs::world &ecs);
+/// @brief switch to the paused pipeline (no pipeline rebuild involved)
 void pause_phases(flecs::world &ecs);
+/// @brief switch back to the unpaused pipeline (no pipeline rebuild involved)
 void unpause_phases(flecs::world &ecs);
+bool are_phases_paused(flecs::world const &ecs);
 
 /// @brief Set up all required system for the engine to run
 template<typename StepContext_t>
@@ -41,42 +56,79 @@ void set_up_systems(
 {
 	set_up_phases(world.ecs);
 
+	// phase markers must be the first systems of their phase
+	if(world.metrics)
+	{
+		world.metrics_collector.set_up(world.ecs);
+		if(world.metrics_rest_port > 0)
+		{
+			enable_metrics_rest(world.ecs, world.metrics_rest_port);
+		}
+	}
+
+	// player lookup and resource ledger used by cast, production and input systems
+	set_up_player_registry(world.ecs);
+	set_up_resource_ledger(world.ecs);
+
 	// command handling systems
 	set_up_command_queue_systems<typename StepContext_t::variant>(world.ecs, step_context.memento_manager, step_context.state_step_manager, step_kept_p);
 
 	// position systems
-	set_up_position_systems(world.ecs, world.pool, step_context.step_manager, world.position_context, world.time_stats);
+	set_up_position_systems(world.ecs, world.pool, step_context.step_manager, world.position_context, world.sleep_wait);
 
 	// step systems
 	set_up_step_systems(world.ecs, world.pool, step_context.step_manager, step_context.state_step_manager, step_kept_p);
+	if(world.history_memory_period > 0)
+	{
+		set_up_history_memory_system(world.ecs, step_context, world.history_memory_period);
+	}
 
 	// components systems
 	set_up_hitpoint_systems(world.ecs, world.pool, step_context.step_manager, step_kept_p);
 
+	// budget of the periodic work
+	set_up_budget_systems(world.ecs, world.work_scheduler);
+	BudgetChannel &attack_retarget_l = world.work_scheduler.add_stride("attack_retarget",
+		world.attack_retarget_budget, world.attack_retarget_wait, world.attack_retarget_max_wait);
+	BudgetChannel &projectile_retarget_l = world.work_scheduler.add_stride("projectile_retarget",
+		world.projectile_retarget_budget, world.projectile_retarget_wait, world.projectile_retarget_max_wait);
+
 	// projectile system
-	set_up_projectile_systems(world.ecs, world.pool, step_context.step_manager, world.time_stats);
+	set_up_projectile_systems(world.ecs, world.pool, step_context.step_manager, world.damage_accumulator, projectile_retarget_l);
 
 	// time stamp systems (increment time stamp)
 	set_up_timestamp_systems(world.ecs, step_context.step_manager);
 
+	// timer systems (must be set up before the systems using timers)
+	set_up_timer_systems(world.ecs, step_context.step_manager);
+
 	// commands systems
-	set_up_move_system<typename StepContext_t::step, CommandQueue<typename StepContext_t::variant>>(world.ecs, step_context.step_manager, world.time_stats);
+	set_up_move_system<typename StepContext_t::step, CommandQueue<typename StepContext_t::variant>>(world.ecs, step_context.step_manager);
 	set_up_attack_system<typename StepContext_t::step, CommandQueue<typename StepContext_t::variant>>(
-		world.ecs, step_context.step_manager, world, world.time_stats, world.attack_retarget_wait);
+		world.ecs, step_context.step_manager, world, attack_retarget_l);
 	set_up_rally_point_command_system<typename StepContext_t::step, CommandQueue<typename StepContext_t::variant>>(world.ecs, step_context.step_manager);
 
 	set_up_cast_system<typename StepContext_t::step, CommandQueue<typename StepContext_t::variant>>(
 		world.ecs, step_context.step_manager
 	);
 
+	// damage systems (must be set up after all damage sources)
+	set_up_damage_systems(world.ecs, world.pool, step_context.step_manager, world.damage_accumulator);
+
 	// production systems
-	set_up_production_systems(world.ecs, world.pool, step_context.step_manager, world.time_stats);
+	set_up_production_systems(world.ecs, world.pool, step_context.step_manager);
 
 	// input systems
 	set_up_input_system<typename StepContext_t::variant, typename StepContext_t::step>(world, step_context.step_manager);
 
 	// resource spent system
 	set_up_resource_spent_system(world.ecs);
+
+	// metrics (last system of the tick)
+	if(world.metrics)
+	{
+		set_up_metrics_system(world.ecs, world.metrics_collector, step_context);
+	}
 }
 
 }
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "flecs.h"
+
+#include "octopus/components/basic/timestamp/TimeStamp.hh"
+#include "octopus/systems/phases/Phases.hh"
+#include "octopus/world/budget/WorkBudget.hh"
+
+namespace octopus
+{
+
+/// @brief update the budget channels at the start of every tick
+/// (before any system spending a budget)
+inline void set_up_budget_systems(flecs::world &ecs, WorkScheduler &scheduler_p)
+{
+	ecs.system<>()
+		.kind(ecs.entity(InitializationPhase))
+		.run([&ecs, &scheduler_p](flecs::iter &) {
+			scheduler_p.begin_tick(get_time_stamp(ecs));
+		});
+}
+
+} // namespace octopus
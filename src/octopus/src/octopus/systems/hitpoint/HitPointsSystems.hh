@@ -9,6 +9,7 @@
 #include "octopus/components/basic/hitpoint/HitPoint.hh"
 #include "octopus/components/basic/hitpoint/HitPointMax.hh"
 #include "octopus/components/basic/timestamp/TimeStamp.hh"
+#include "octopus/components/step/ChangeTracker.hh"
 
 #include "octopus/systems/phases/Phases.hh"
 #include "octopus/utils/FixedPoint.hh"
@@ -22,36 +23,47 @@ void set_up_hitpoint_systems(flecs::world &ecs, ThreadPool &pool, StepManager_t
 {
 	// Validators
 
-	// Clamp hitpoints max above 0
-	ecs.system<HitPointMax>()
-		.multi_threaded()
-		.kind(ecs.entity(ValidatePhase))
-		.each([](HitPointMax &max_p) {
-			if(max_p.qty <= Fixed::Zero())
-			{
-				max_p.qty = Fixed::One();
-			}
-		});
+	track_changes<HitPoint>(ecs);
+	track_changes<HitPointMax>(ecs);
 
-	// Clamp hitpoints between 0 and max
-	ecs.system<HitPoint, HitPointMax const>()
-		.multi_threaded()
+	// Clamp hitpoints max above 0 and hitpoints between 0 and max
+	// only for entities changed since the last validation
+	ecs.system<>()
 		.kind(ecs.entity(ValidatePhase))
-		.each([](HitPoint &hp_p, HitPointMax const &max_p) {
-			if(hp_p.qty > max_p.qty)
+		.run([&ecs, &manager_p](flecs::iter &) {
+			ChangeTracker<HitPointMax> &max_tracker_l = *ecs.try_get_mut<ChangeTracker<HitPointMax>>();
+			ChangeTracker<HitPoint> &hp_tracker_l = *ecs.try_get_mut<ChangeTracker<HitPoint>>();
+			add_step_changes<HitPointMaxStep>(max_tracker_l, manager_p);
+			add_step_changes<HitPointStep>(hp_tracker_l, manager_p);
+
+			for(flecs::entity e : consolidate_changes(max_tracker_l))
 			{
-				hp_p.qty = max_p.qty;
+				HitPointMax *max_l = e.is_alive() ? e.try_get_mut<HitPointMax>() : nullptr;
+				if(max_l && max_l->qty <= Fixed::Zero())
+				{
+					max_l->qty = Fixed::One();
+				}
+				// hitpoints must be checked against the new max
+				hp_tracker_l.changed.push_back(e);
 			}
-		});
 
-	ecs.system<HitPoint>()
-		.multi_threaded()
-		.kind(ecs.entity(ValidatePhase))
-		.each([](HitPoint &hp_p) {
-			if(hp_p.qty < Fixed::Zero())
+			for(flecs::entity e : consolidate_changes(hp_tracker_l))
 			{
-				hp_p.qty = Fixed::Zero();
+				HitPoint *hp_l = e.is_alive() ? e.try_get_mut<HitPoint>() : nullptr;
+				if(!hp_l) { continue; }
+				HitPointMax const *max_l = e.try_get<HitPointMax>();
+				if(max_l && hp_l->qty > max_l->qty)
+				{
+					hp_l->qty = max_l->qty;
+				}
+				if(hp_l->qty < Fixed::Zero())
+				{
+					hp_l->qty = Fixed::Zero();
+				}
 			}
+
+			max_tracker_l.changed.clear();
+			hp_tracker_l.changed.clear();
 		});
 
 	// Destroyable handling
@@ -62,7 +74,7 @@ void set_up_hitpoint_systems(flecs::world &ecs, ThreadPool &pool, StepManager_t
 		.each([&ecs, &manager_p](flecs::entity e, HitPoint const &hp_p, Destroyable &destroyable_p) {
 			if(hp_p.qty == Fixed::Zero() && destroyable_p.timestamp == 0)
 			{
-				Logger::getDebug() << "Destroy :: name=" << e.name() << " idx=" << e.id() << std::endl;
+				OCTOPUS_LOG_DEBUG << "Destroy :: name=" << e.name() << " idx=" << e.id() << std::endl;
 				manager_p.get_last_layer().back().template get<DestroyableStep>().add_step(e, {get_time_stamp(ecs)});
 				e.disable();
 				ecs.event<Destroyed>()
@@ -79,7 +91,7 @@ void set_up_hitpoint_systems(flecs::world &ecs, ThreadPool &pool, StepManager_t
 		.each([&ecs, &manager_p](flecs::entity e, Destroyable &destroyable_p) {
 			if(destroyable_p.timestamp == 0)
 			{
-				Logger::getDebug() << "Destroy :: name=" << e.name() << " idx=" << e.id() << std::endl;
+				OCTOPUS_LOG_DEBUG << "Destroy :: name=" << e.name() << " idx=" << e.id() << std::endl;
 				manager_p.get_last_layer().back().template get<DestroyableStep>().add_step(e, {get_time_stamp(ecs)});
 				e.disable();
 				ecs.event<Destroyed>()
@@ -109,7 +121,7 @@ void set_up_hitpoint_systems(flecs::world &ecs, ThreadPool &pool, StepManager_t
 			if(destroyable_p.timestamp != 0
 			&& destroyable_p.timestamp + step_kept_p > get_time_stamp(ecs))
 			{
-				Logger::getDebug() << "Destruct :: name=" << e.name() << " idx=" << e.id() << std::endl;
+				OCTOPUS_LOG_DEBUG << "Destruct :: name=" << e.name() << " idx=" << e.id() << std::endl;
 				e.destruct();
 			}
 		});
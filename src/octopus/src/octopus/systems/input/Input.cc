@@ -15,13 +15,13 @@ FlockHandle register_flock(flecs::entity flock_manager)
 
 void add_flock_information(flecs::entity flock_manager, MoveCommand &cmd)
 {
-	Logger::getDebug() << "adding flock to move command" <<std::endl;
+	OCTOPUS_LOG_DEBUG << "adding flock to move command" <<std::endl;
 	cmd.flock_handle = register_flock(flock_manager);
 }
 
 void add_flock_information(flecs::entity flock_manager, AttackCommand &cmd)
 {
-	Logger::getDebug() << "adding flock to attack command" <<std::endl;
+	OCTOPUS_LOG_DEBUG << "adding flock to attack command" <<std::endl;
 	cmd.flock_handle = register_flock(flock_manager);
 }
 
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "flecs.h"
-#include <mutex>
+#include <algorithm>
 #include <list>
 #include <vector>
 
@@ -11,6 +11,7 @@
 #include "octopus/components/advanced/production/queue/ProductionQueue.hh"
 #include "octopus/components/basic/flock/FlockManager.hh"
 #include "octopus/world/ability/AbilityTemplateLibrary.hh"
+#include "octopus/world/production/ProducerHeap.hh"
 #include "octopus/world/production/ProductionTemplateLibrary.hh"
 #include "octopus/world/player/PlayerInfo.hh"
 #include "octopus/world/resources/ResourceStock.hh"
@@ -19,6 +20,8 @@
 #include "octopus/systems/phases/Phases.hh"
 #include "octopus/systems/production/ProductionSystem.hh"
 #include "octopus/utils/log/Logger.hh"
+#include "octopus/utils/mpsc/MpscQueue.hh"
+#include "octopus/utils/ThreadPool.hh"
 
 #include "InputCast.hh"
 #include "InputCommand.hh"
@@ -55,19 +58,41 @@ void handle_cast(
 	flecs::world &ecs,
 	StepManager_t &manager);
 
+/// @brief inputs are submitted from any thread (network, ui)
+/// through lock free queues and drained in submission order
+/// during the InputPhase (flocks of group commands are registered
+/// when draining so that producers never touch the world)
 template<typename command_variant_t, typename StepManager_t>
 struct Input
 {
 private:
-	std::mutex mutex;
+	MpscQueue<InputCast> pending_cast;
+	MpscQueue<InputProduction> pending_production;
+	MpscQueue<InputAddProduction> pending_add_production;
+	MpscQueue<InputCancelProduction> pending_cancel_production;
+	MpscQueue<InputCommand<command_variant_t> > pending_command;
+	MpscQueue<InputCommandFunctor<command_variant_t, StepManager_t> > pending_command_functor;
 
 	InputContainer<command_variant_t, StepManager_t> container;
 
 	InputLayerContainer<InputCommand<command_variant_t> > container_command;
 	InputLayerContainer<InputCommandFunctor<command_variant_t, StepManager_t> > container_command_functor;
+
+	/// @brief queue of an entity targeted by a command input
+	struct CommandTarget
+	{
+		CommandQueue<command_variant_t> *queue = nullptr;
+		uint32_t input = 0;
+	};
+	/// @brief buffers reused to fan out command inputs
+	std::vector<CommandTarget> targets;
+	std::vector<size_t> target_starts;
 public:
 	flecs::entity flock_manager;
 
+	/// @brief number of targeted queues from which
+	/// command inputs are fanned out in parallel
+	static constexpr size_t parallel_fan_out = 256;
 
 	Input() { stack_input(); }
 
@@ -83,72 +108,139 @@ public:
 
 	void addFrontCommand(std::vector<flecs::entity> const &entities, command_variant_t command_p)
 	{
-		std::lock_guard<std::mutex> lock_l(mutex);
-		Logger::getDebug() << "adding front command" <<std::endl;
-		if(entities.size() > 1)
-		{
-			std::visit([this](auto&& arg) { add_flock_information(flock_manager, arg); }, command_p);
-		}
-		for(auto entity : entities)
-		{
-			container_command.get_back_layer().push_back({entity, command_p, true});
-		}
+		OCTOPUS_LOG_DEBUG << "adding front command" <<std::endl;
+		pending_command.push({entities, std::move(command_p), true});
 	}
 
 	void addBackCommand(std::vector<flecs::entity> const &entities, command_variant_t command_p)
 	{
-		std::lock_guard<std::mutex> lock_l(mutex);
-		Logger::getDebug() << "adding back command" <<std::endl;
-		if(entities.size() > 1)
-		{
-			std::visit([this](auto&& arg) { add_flock_information(flock_manager, arg); }, command_p);
-		}
-		for(auto entity : entities)
-		{
-			container_command.get_back_layer().push_back({entity, command_p, false});
-		}
+		OCTOPUS_LOG_DEBUG << "adding back command" <<std::endl;
+		pending_command.push({entities, std::move(command_p), false});
 	}
 
 	void addStopCommand(flecs::entity entity)
 	{
-		std::lock_guard<std::mutex> lock_l(mutex);
 		InputCommand<command_variant_t> stop;
-		stop.entity = entity;
+		stop.entities.push_back(entity);
 		stop.stop = true;
-		container_command.get_back_layer().push_back(stop);
+		pending_command.push(std::move(stop));
 	}
 
 	void addInputCast(InputCast const &input_p) {
-		std::lock_guard<std::mutex> lock_l(mutex);
-		container.container_cast.get_back_layer().push_back(input_p);
+		pending_cast.push(input_p);
 	}
 	void newProduction(InputProduction const &input_p)
 	{
-		std::lock_guard<std::mutex> lock_l(mutex);
-		container.container_production.get_back_layer().push_back(input_p);
+		pending_production.push(input_p);
 	}
 	void addProduction(InputAddProduction const &input_p)
 	{
-		std::lock_guard<std::mutex> lock_l(mutex);
-		container.container_add_production.get_back_layer().push_back(input_p);
+		pending_add_production.push(input_p);
 	}
 	void cancelProduction(InputCancelProduction const &input_p)
 	{
-		std::lock_guard<std::mutex> lock_l(mutex);
-		container.container_cancel_production.get_back_layer().push_back(input_p);
+		pending_cancel_production.push(input_p);
 	}
 
 	void addFunctorCommand(InputCommandFunctor<command_variant_t, StepManager_t> const &input_p)
 	{
-		std::lock_guard<std::mutex> lock_l(mutex);
-		container_command_functor.get_back_layer().push_back(input_p);
+		pending_command_functor.push(input_p);
+	}
+
+	/// @brief push the actions of the command inputs in the queues
+	/// queues are resolved once then filled in parallel for large groups,
+	/// every queue receiving its actions in input order
+	void fan_out_commands(ThreadPool &pool_p, std::vector<InputCommand<command_variant_t> > const &inputs_p)
+	{
+		targets.clear();
+		for(uint32_t i = 0 ; i < inputs_p.size() ; ++ i)
+		{
+			for(flecs::entity const &entity : inputs_p[i].entities)
+			{
+				if(!entity.is_valid()) { continue; }
+				CommandQueue<command_variant_t> *command_queue = entity.template try_get_mut<CommandQueue<command_variant_t>>();
+				if(!command_queue) { continue; }
+				targets.push_back({command_queue, i});
+			}
+		}
+
+		// group targets by queue keeping the input order of every queue
+		std::stable_sort(targets.begin(), targets.end(), [](CommandTarget const &a, CommandTarget const &b) {
+			return a.queue < b.queue;
+		});
+		target_starts.clear();
+		for(size_t i = 0 ; i < targets.size() ; ++ i)
+		{
+			if(i == 0 || targets[i].queue != targets[i-1].queue)
+			{
+				target_starts.push_back(i);
+			}
+		}
+		target_starts.push_back(targets.size());
+
+		auto &&fill_l = [this, &inputs_p](size_t, size_t start_p, size_t end_p) {
+			for(size_t group_l = start_p ; group_l < end_p ; ++ group_l)
+			{
+				for(size_t i = target_starts[group_l] ; i < target_starts[group_l+1] ; ++ i)
+				{
+					push_actions(*targets[i].queue, inputs_p[targets[i].input]);
+				}
+			}
+		};
+
+		size_t const groups_l = target_starts.size() - 1;
+		if(groups_l < parallel_fan_out)
+		{
+			fill_l(0, 0, groups_l);
+		}
+		else
+		{
+			threading(groups_l, pool_p, fill_l, "input.fan_out");
+		}
+	}
+
+	static void push_actions(CommandQueue<command_variant_t> &command_queue, InputCommand<command_variant_t> const &input)
+	{
+		auto &&queue_l = command_queue._queuedActions;
+		if(input.stop)
+		{
+			// replace queue and finish current action
+			queue_l.push_back(CommandQueueActionReplace<command_variant_t> {{}});
+			queue_l.push_back(CommandQueueActionDone());
+		}
+		else if(input.front)
+		{
+			// replace queue and finish current action
+			queue_l.push_back(CommandQueueActionReplace<command_variant_t> {{input.command}});
+			queue_l.push_back(CommandQueueActionDone());
+		}
+		else
+		{
+			queue_l.push_back(CommandQueueActionAddBack<command_variant_t> {input.command});
+		}
 	}
 
 	void unstack_input(WorldContext<StepManager_t> &world, StepManager_t &manager_p)
 	{
-		std::lock_guard<std::mutex> lock_l(mutex);
 		flecs::world &ecs = world.ecs;
 
+		// gather inputs submitted since last unstack
+		pending_add_production.drain(container.container_add_production.get_front_layer());
+		pending_cancel_production.drain(container.container_cancel_production.get_front_layer());
+		pending_production.drain(container.container_production.get_front_layer());
+		pending_cast.drain(container.container_cast.get_front_layer());
+		pending_command.drain(container_command.get_front_layer());
+		pending_command_functor.drain(container_command_functor.get_front_layer());
+
+		// register flocks of group commands in submission order
+		for(InputCommand<command_variant_t> &input : container_command.get_front_layer())
+		{
+			if(input.entities.size() > 1)
+			{
+				std::visit([this](auto&& arg) { add_flock_information(flock_manager, arg); }, input.command);
+			}
+		}
+
 		// declare all flocks into the ecs
 		if(flock_manager && flock_manager.try_get<FlockManager>())
 		{
@@ -166,30 +258,36 @@ public:
 			{
 				std::visit([this](auto&& arg) { add_flock_information(flock_manager, arg); }, package.command);
 			}
-			for(flecs::entity const &entity : package.entities)
-			{
-				// append to front layer for them to be handled just after this loop
-				container_command.get_front_layer().push_back({entity, package.command, package.front, package.stop});
-			}
+			// append to front layer for them to be handled just after this loop
+			container_command.get_front_layer().push_back({std::move(package.entities), std::move(package.command), package.front, package.stop});
 		}
 
-    	flecs::query<PlayerInfo> query_player = ecs.query<PlayerInfo>();
 		if(prod_lib)
 		{
 			// Input add production
 			for(InputAddProduction const &input_l : container.container_add_production.get_front_layer())
 			{
-				handle_add_production(input_l, *prod_lib, query_player, ecs, manager_p);
+				handle_add_production(input_l, *prod_lib, ecs, manager_p);
 			}
 
 			for(InputCancelProduction const &input_l : container.container_cancel_production.get_front_layer())
 			{
-				handle_cancel_production(input_l, *prod_lib, query_player, ecs, manager_p);
+				handle_cancel_production(input_l, *prod_lib, ecs, manager_p);
 			}
 
-			for(InputProduction const &input_l : container.container_production.get_front_layer())
+			// identical consecutive productions are dispatched together
+			auto const &productions_l = container.container_production.get_front_layer();
+			for(size_t i = 0 ; i < productions_l.size() ;)
 			{
-				handle_new_production(input_l, *prod_lib, ecs, manager_p);
+				size_t next_l = i+1;
+				while(next_l < productions_l.size()
+				&& productions_l[next_l].production == productions_l[i].production
+				&& productions_l[next_l].candidates == productions_l[i].candidates)
+				{
+					++next_l;
+				}
+				handle_new_productions(productions_l[i], next_l-i, *prod_lib, ecs, manager_p);
+				i = next_l;
 			}
 		}
 		if(ability_lib) {
@@ -199,29 +297,7 @@ public:
 		}
 
 		// Handling command inputs
-		for(InputCommand<command_variant_t> const & input : container_command.get_front_layer())
-		{
-			if(!input.entity.is_valid()) { continue; }
-			auto &&command_queue = input.entity.template try_get_mut<CommandQueue<command_variant_t>>();
-			if(!command_queue) { continue; }
-			auto &&queue_l = command_queue->_queuedActions;
-			if(input.stop)
-			{
-				// replace queue and finish current action
-				queue_l.push_back(CommandQueueActionReplace<command_variant_t> {{}});
-				queue_l.push_back(CommandQueueActionDone());
-			}
-			else if(input.front)
-			{
-				// replace queue and finish current action
-				queue_l.push_back(CommandQueueActionReplace<command_variant_t> {{input.command}});
-				queue_l.push_back(CommandQueueActionDone());
-			}
-			else
-			{
-				queue_l.push_back(CommandQueueActionAddBack<command_variant_t> {input.command});
-			}
-		}
+		fan_out_commands(world.pool, container_command.get_front_layer());
 
 		container.container_add_production.pop_layer();
 		container.container_cancel_production.pop_layer();
@@ -231,9 +307,9 @@ public:
 		container_command_functor.pop_layer();
 	}
 
+	/// @note only called from the input system (single consumer)
 	void stack_input()
 	{
-		std::lock_guard<std::mutex> lock_l(mutex);
 		container.container_add_production.push_layer();
 		container.container_cancel_production.push_layer();
 		container.container_production.push_layer();
@@ -255,10 +331,10 @@ void set_up_input_system(WorldContext<StepManager_t> &world, StepManager_t &mana
 	world.ecs.template system<Input<command_variant_t, StepManager_t>>()
 		.kind(world.ecs.entity(InputPhase))
 		.each([&](flecs::entity e, Input<command_variant_t, StepManager_t> &input_p) {
-			Logger::getDebug() << "Input :: start" << std::endl;
+			OCTOPUS_LOG_DEBUG << "Input :: start" << std::endl;
 			input_p.stack_input();
 			input_p.unstack_input(world, manager);
-			Logger::getDebug() << "Input :: end" << std::endl;
+			OCTOPUS_LOG_DEBUG << "Input :: end" << std::endl;
 		});
 }
 
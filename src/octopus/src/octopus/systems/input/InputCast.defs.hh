@@ -1,15 +1,21 @@
 
 namespace octopus {
 
-inline bool is_caster(flecs::world const &ecs,
-					 flecs::entity e,
-					 std::string const &cast_name) {
+/// @brief check if the entity is a caster of the ability component
+/// (the component resolved from the ability name)
+inline bool is_caster(flecs::entity e, flecs::entity cast_component) {
 	if (!e.is_valid()) {
 		return false;
 	}
 	auto caster = e.try_get<octopus::Caster>();
 	return caster
-		&& e.has<octopus::Caster>(ecs.component(cast_name.c_str()));
+		&& e.has<octopus::Caster>(cast_component);
+}
+
+inline bool is_caster(flecs::world const &ecs,
+					 flecs::entity e,
+					 std::string const &cast_name) {
+	return is_caster(e, ecs.component(cast_name.c_str()));
 }
 
 template<typename StepManager_t>
@@ -21,6 +27,8 @@ flecs::entity find_best_entity_for_casting(flecs::world const &ecs,
 											InputStatus &status) {
 	using namespace octopus;
 	octopus::AbilityTemplate<StepManager_t> const &ability = ability_library.get(cast_name);
+	// resolve the ability component once
+	flecs::entity const cast_component = ecs.component(cast_name.c_str());
 
 	bool found_missing_resource = false;
 	bool found_cooldown = false;
@@ -32,7 +40,7 @@ flecs::entity find_best_entity_for_casting(flecs::world const &ecs,
 	/// - Pas de cast du même sort dans la queue (sauf si reload = 0) (sauf si aucun autre candidat)
 	/// - Resource check (en prenant en compte tous les cast dans la queue si booléen queued = true [add])
 	for(flecs::entity const &e : group) {
-		if(!is_caster(ecs, e, cast_name)) {
+		if(!is_caster(e, cast_component)) {
 			continue;
 		}
 		ResourceStock const *stock = e.try_get<ResourceStock>();
@@ -78,15 +86,14 @@ InputStatus get_input_status(flecs::world &ecs, AbilityTemplateLibrary<StepManag
 		return status;
 	}
 
-	flecs::entity candidate = find_best_entity_for_casting(ecs, ability_lib, input.candidates, input.cast_command.ability, input.cast_command.point_target, status);
+	flecs::entity candidate = find_best_entity_for_casting(ecs, ability_lib, input.candidates, input.cast_command.ability.name(), input.cast_command.point_target, status);
 	if (!candidate.is_valid()) {
 		return status;
 	}
 	status.entity = candidate;
 
 	// Get player from candidate
-	flecs::entity player = get_player_from_appartenance(candidate, ecs);
-	if (!player.is_valid()) {
+	if (!get_player_entry(candidate, ecs)) {
 		status.ok = false;
 		const std::string reason = "NO_PLAYER_APPARTENANCE";
 		status.other_explanations.push_back(reason);
@@ -94,7 +101,7 @@ InputStatus get_input_status(flecs::world &ecs, AbilityTemplateLibrary<StepManag
 	}
 
 	// Check upgrades requirements
-	status.missing_upgrades = explain_unmet_requirements(candidate, ecs, ability->get_requirements());
+	status.missing_upgrades = ability->explain_unmet_requirements(candidate, ecs);
 	status.ok &= status.missing_upgrades.empty();
 
 	return status;
@@ -117,7 +124,7 @@ void handle_cast(
 		// for(auto str : status.other_explanations) {
 		// 	std::cout<<str<<std::endl;
 		// }
-		Logger::getDebug() << "Can't cast "<<input.cast_command.ability<<std::endl;
+		OCTOPUS_LOG_DEBUG << "Can't cast "<<input.cast_command.ability.name()<<std::endl;
 		return;
 	}
 
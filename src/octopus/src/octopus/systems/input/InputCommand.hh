@@ -3,10 +3,12 @@
 namespace octopus
 {
 
+/// @brief command given to a group of entities
+/// the command is stored once for the whole group
 template<typename command_variant_t>
 struct InputCommand
 {
-	flecs::entity entity;
+	std::vector<flecs::entity> entities;
 	command_variant_t command;
 	bool front = false;
 	bool stop = false;
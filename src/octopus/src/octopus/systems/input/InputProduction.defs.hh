@@ -2,68 +2,96 @@
 namespace octopus {
 
 
+/// @brief fill the heap with the entities able to produce the production
+/// ordered by the end of their queue, explain in the status why there is none
 template<typename StepManager_t>
-flecs::entity find_best_entity_for_production(
+void fill_producer_heap(
 	flecs::world const &ecs,
 	std::vector<flecs::entity> const &entities,
-	std::string const &production_name_p,
-	InputStatus &status
+	ProductionTemplate<StepManager_t> const &prod_template,
+	InputStatus &status,
+	ProducerHeap &heap
 ) {
-	using namespace octopus;
-	auto &&prod_library = ecs.try_get<ProductionTemplateLibrary<StepManager_t> >();
-	if(!prod_library) {
-		return flecs::entity();
-	}
-	ProductionTemplate<StepManager_t> const & prod_template = prod_library->get(production_name_p);
+	// resolve the production component once
+	flecs::entity const production_component = ecs.component(prod_template.name().c_str());
 
-	flecs::entity best_ent;
-	int64_t best_end_time = -1;
-	bool found_with_production_queue = false;
-	bool found_can_produce = false;
+	// kept to get explaination later if no entity can produce the production
+	flecs::entity first_with_production_queue;
 	for(flecs::entity const &e : entities) {
 		if(!e.is_valid()) {
 			continue;
 		}
 		octopus::ProductionQueue const * prod_queue = e.try_get<octopus::ProductionQueue>();
-		bool has_prod_queue = prod_queue;
-		bool can_produce = prod_template.can_produce(e, ecs) && e.has<octopus::ProductionQueue>(ecs.component(production_name_p.c_str()));
-		if(has_prod_queue && can_produce) {
-			int64_t const queue_duration = octopus::get_queue_duration(*prod_library, prod_queue->queue);
-			int64_t const start = prod_queue->start_timestamp;
-			if(best_end_time < 0 || start + queue_duration < best_end_time) {
-				best_end_time = start + queue_duration;
-				best_ent = e;
-			}
+		if(!prod_queue) {
+			continue;
 		}
-		if (!found_with_production_queue && has_prod_queue) {
-			// store best entity to get explaination later if no entity can produce the production
-			best_ent = e;
-			found_with_production_queue = true;
+		if(!first_with_production_queue.is_valid()) {
+			first_with_production_queue = e;
 		}
-		if (!found_can_produce && can_produce) {
-			found_can_produce = true;
+		if(prod_template.can_produce(e, ecs) && e.has<octopus::ProductionQueue>(production_component)) {
+			heap.push(e, prod_queue->queue_end());
 		}
 	}
-	status.entity = best_ent;
-	if (!found_with_production_queue) {
+	status.entity = heap.empty() ? first_with_production_queue : heap.top();
+	if (!first_with_production_queue.is_valid()) {
 		status.ok = false;
 		const std::string reason = "NO_PRODUCTION_QUEUE";
 		status.other_explanations.push_back(reason);
-	} else if (!found_can_produce) {
+	} else if (heap.empty()) {
 		status.ok = false;
 		const std::string reason = "CAN_NOT_PRODUCE";
-		const std::string explaination = prod_template.get_production_explaination(best_ent, ecs);
+		const std::string explaination = prod_template.get_production_explaination(first_with_production_queue, ecs);
 		status.other_explanations.push_back(reason);
 		if (explaination != "") {
 			status.other_explanations.push_back(explaination);
 		}
-	} else {
-		return best_ent;
 	}
-	// best_ent may be valid to get explaination of why the production can't be produced,
+}
+
+template<typename StepManager_t>
+flecs::entity find_best_entity_for_production(
+	flecs::world const &ecs,
+	std::vector<flecs::entity> const &entities,
+	std::string const &production_name_p,
+	InputStatus &status
+) {
+	auto &&prod_library = ecs.try_get<ProductionTemplateLibrary<StepManager_t> >();
+	if(!prod_library) {
+		return flecs::entity();
+	}
+	ProducerHeap heap;
+	fill_producer_heap(ecs, entities, prod_library->get(production_name_p), status, heap);
+	// status.entity may be valid to get explaination of why the production can't be produced,
 	// but it can't produce the production right now, so we return an invalid entity to
 	// indicate that no entity can produce the production right now
-	return flecs::entity();
+	return heap.empty() ? flecs::entity() : heap.top();
+}
+
+/// @brief check the requirements and resources of the player
+/// owning the candidate picked in status.entity
+template<typename StepManager_t>
+void check_production_candidate(flecs::world &ecs, ProductionTemplate<StepManager_t> const &prod, InputStatus &status) {
+	flecs::entity candidate = status.entity;
+
+	// Get player from candidate
+	PlayerEntry const * player = get_player_entry(candidate, ecs);
+	if (!player) {
+		status.ok = false;
+		const std::string reason = "NO_PLAYER_APPARTENANCE";
+		status.other_explanations.push_back(reason);
+		return;
+	}
+
+	// Check upgrades requirements
+	status.missing_upgrades = prod.explain_unmet_requirements(candidate, ecs);
+	status.ok &= status.missing_upgrades.empty();
+
+	// Check player resources
+	ReductionLibrary const * reduction_library = player->reduction_library.try_get();
+	status.resource_cost = reduction_library ? get_required_resources(reduction_library->reductions[prod.name()], prod.resource_consumption()) : prod.resource_consumption();
+	status.ok &= get_resource_ledger(player).can_afford(prod.symbol(), prod.dense_cost());
+	const std::string reason = "MISSING_RESOURCES";
+	status.other_explanations.push_back(reason);
 }
 
 template<typename StepManager_t>
@@ -87,33 +115,37 @@ InputStatus get_input_status(flecs::world &ecs, ProductionTemplateLibrary<StepMa
 		return status;
 	}
 
-	// Get player from candidate
-	flecs::entity player = get_player_from_appartenance(candidate, ecs);
-	if (!player.is_valid()) {
-		status.ok = false;
-		const std::string reason = "NO_PLAYER_APPARTENANCE";
-		status.other_explanations.push_back(reason);
-		return status;
-	}
+	check_production_candidate(ecs, *prod, status);
 
-	// Check upgrades requirements
-	status.missing_upgrades = explain_unmet_requirements(candidate, ecs, prod->get_requirements());
-	status.ok &= status.missing_upgrades.empty();
+	return status;
+}
 
-	// Check player resources
-	ResourceStock const * resource_stock = player.try_get<ResourceStock>();
-	ReductionLibrary const * reduction_library = player.try_get<ReductionLibrary>();
-	ResourceSpent * resource_spent = player.try_get_mut<ResourceSpent>();
-	status.resource_cost = reduction_library ? get_required_resources(reduction_library->reductions[prod->name()], prod->resource_consumption()) : prod->resource_consumption();
-	status.ok &= check_resources(
-		resource_stock ? resource_stock->resource : fast_map<std::string, ResourceInfo>{},
-		resource_spent ? resource_spent->resources_spent : std::unordered_map<std::string, Fixed>{},
-		status.resource_cost
-		);
-	const std::string reason = "MISSING_RESOURCES";
-	status.other_explanations.push_back(reason);
+/// @brief add the steps to enqueue the production on status.entity
+/// and consume the resources of its player
+template<typename StepManager_t>
+void enqueue_production(
+	ProductionTemplate<StepManager_t> const &prod,
+	flecs::world &ecs,
+	StepManager_t &manager,
+	InputStatus const &status) {
+	PlayerEntry const * player_entry = get_player_entry(status.entity, ecs);
+	flecs::entity player = player_entry->player;
+	ResourceSpent * resource_spent = player_entry->resource_spent.try_get();
 
-	return status;
+	// add step for production queue
+	manager.get_last_layer().back().template get<ProductionQueueOperationStep>().add_step(status.entity, {prod.symbol(), -1, prod.duration()});
+	add_timer(ecs, manager, status.entity, get_time_stamp(ecs)+1, production_timer_kind);
+	prod.enqueue(status.entity, ecs, manager);
+
+	// consume resources
+	for(auto &&pair : status.resource_cost)
+	{
+		std::string const &resource = pair.first;
+		Fixed resource_consumed = pair.second;
+
+		// add step for consumption
+		octopus::spend_resources(manager, resource_spent, player, resource_consumed, resource);
+	}
 }
 
 template<typename StepManager_t>
@@ -133,26 +165,44 @@ void handle_new_production(
 		// for(auto str : status.other_explanations) {
 		// 	std::cout<<str<<std::endl;
 		// }
-		Logger::getDebug() << "Can't produce "<<input.production<<std::endl;
+		OCTOPUS_LOG_DEBUG << "Can't produce "<<input.production<<std::endl;
 		return;
 	}
-	// get production information
-	ProductionTemplate<StepManager_t> const * prod = prod_lib.try_get(input.production);
-	flecs::entity player = get_player_from_appartenance(status.entity, ecs);
-	ResourceSpent * resource_spent = player.try_get_mut<ResourceSpent>();
-
-	// add step for production queue
-	manager.get_last_layer().back().template get<ProductionQueueOperationStep>().add_step(status.entity, {input.production, -1});
-	prod->enqueue(status.entity, ecs, manager);
-
-	// consume resources
-	for(auto &&pair : status.resource_cost)
-	{
-		std::string const &resource = pair.first;
-		Fixed resource_consumed = pair.second;
+	enqueue_production(*prod_lib.try_get(input.production), ecs, manager, status);
+}
 
-		// add step for consumption
-		octopus::spend_resources(manager, resource_spent, player, resource_consumed, resource);
+/// @brief handle count identical production inputs dispatching them
+/// over the candidates, each one going to the producer whose queue ends first
+template<typename StepManager_t>
+void handle_new_productions(
+	InputProduction const &input,
+	size_t count,
+	ProductionTemplateLibrary<StepManager_t> const &prod_lib,
+	flecs::world &ecs,
+	StepManager_t &manager) {
+	ProductionTemplate<StepManager_t> const * prod = prod_lib.try_get(input.production);
+	ProducerHeap heap;
+	InputStatus heap_status;
+	if (prod) {
+		fill_producer_heap(ecs, input.candidates, *prod, heap_status, heap);
+	}
+	// no producer : handle them one by one to get the explainations
+	if (heap.empty()) {
+		for(size_t i = 0 ; i < count ; ++ i) {
+			handle_new_production(input, prod_lib, ecs, manager);
+		}
+		return;
+	}
+	for(size_t i = 0 ; i < count ; ++ i) {
+		InputStatus status;
+		status.entity = heap.top();
+		check_production_candidate(ecs, *prod, status);
+		if (!status.ok) {
+			OCTOPUS_LOG_DEBUG << "Can't produce "<<input.production<<std::endl;
+			continue;
+		}
+		enqueue_production(*prod, ecs, manager, status);
+		heap.delay_top(prod->duration());
 	}
 }
 
@@ -3,6 +3,9 @@
 #include "flecs.h"
 #include <string>
 #include "InputStatus.hh"
+#include "octopus/world/player/PlayerRegistry.hh"
+#include "octopus/world/resources/ResourceLedger.hh"
+#include "octopus/world/timer/TimerWheel.hh"
 
 namespace octopus
 {
@@ -28,7 +31,6 @@ template<typename StepManager_t>
 void handle_add_production(
 	InputAddProduction const &input,
 	ProductionTemplateLibrary<StepManager_t> const &prod_lib,
-	flecs::query<PlayerInfo> &query_player,
 	flecs::world &ecs,
 	StepManager_t &manager
 )
@@ -42,36 +44,24 @@ void handle_add_production(
 	ProductionTemplate<StepManager_t> const * prod = prod_lib.try_get(input.production);
 
 	// get player info
-	flecs::entity player = query_player.find([&input](PlayerInfo& p) {
-		return p.idx == input.producer.try_get<PlayerAppartenance>()->idx;
-	});
-	if(!player.is_valid() || !prod) { return; }
-	PlayerInfo const * player_info = player.try_get<PlayerInfo>();
-	ResourceStock const * resource_stock = player.try_get<ResourceStock>();
-	ReductionLibrary const * reductionibrary = player.try_get<ReductionLibrary>();
-	ResourceSpent * resource_spent = player.try_get_mut<ResourceSpent>();
+	PlayerEntry const * player_entry = get_player_entry(input.producer, ecs);
+	if(!player_entry || !prod) { return; }
+	flecs::entity player = player_entry->player;
+	ResourceSpent * resource_spent = player_entry->resource_spent.try_get();
+	ResourceLedger const ledger = get_resource_ledger(player_entry);
 
-	auto resource_cost = prod->resource_consumption();
-	if(reductionibrary && reductionibrary->reductions.has(prod->name()))
-	{
-		resource_cost = get_required_resources(reductionibrary->reductions[prod->name()], resource_cost);
-	}
-
-	if(player_info
-	&& resource_stock
+	if(ledger.stock
 	&& resource_spent
 	&& prod->check_requirement(input.producer, ecs)
-	&& check_resources(resource_stock->resource, resource_spent->resources_spent, resource_cost))
+	&& ledger.can_afford(prod->symbol(), prod->dense_cost()))
 	{
-		manager.get_last_layer().back().template get<ProductionQueueOperationStep>().add_step(input.producer, {input.production, -1});
+		manager.get_last_layer().back().template get<ProductionQueueOperationStep>().add_step(input.producer, {prod->symbol(), -1, prod->duration()});
+		add_timer(ecs, manager, input.producer, get_time_stamp(ecs)+1, production_timer_kind);
 		prod->enqueue(input.producer, ecs, manager);
-		for(auto &&pair : resource_cost)
+		for(ResourceAmount const &amount : prod->dense_cost())
 		{
-			std::string const &resource = pair.first;
-			Fixed resource_consumed = pair.second;
-
 			// add step for consumption
-			octopus::spend_resources(manager, resource_spent, player, resource_consumed, resource);
+			octopus::spend_resources(manager, resource_spent, player, ledger.price(prod->symbol(), amount), resource_name(amount.resource));
 		}
 	}
 }
@@ -80,7 +70,6 @@ template<typename StepManager_t>
 void handle_cancel_production(
 	InputCancelProduction const &input,
 	ProductionTemplateLibrary<StepManager_t> const &prod_lib,
-	flecs::query<PlayerInfo> &query_player,
 	flecs::world &ecs,
 	StepManager_t &manager
 )
@@ -94,12 +83,10 @@ void handle_cancel_production(
 	}
 
 	// get player info
-	flecs::entity player = query_player.find([&input](PlayerInfo& p) {
-		return p.idx == input.producer.try_get<PlayerAppartenance>()->idx;
-	});
-	if(!player.is_valid()) { return; }
+	PlayerEntry const * player_entry = get_player_entry(input.producer, ecs);
+	if(!player_entry) { return; }
 
-	cancel_production(&prod_lib, input.producer, *prod_queue, player, input.idx, ecs, manager);
+	cancel_production(&prod_lib, input.producer, *prod_queue, player_entry->player, input.idx, ecs, manager);
 }
 
 }
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "flecs.h"
+
+#include "octopus/systems/phases/Phases.hh"
+#include "octopus/world/metrics/EngineMetrics.hh"
+#include "octopus/world/step/HistoryMemory.hh"
+
+namespace octopus
+{
+
+/// @brief update the metric components at the end of every tick
+/// @note must be the last system of the EndCleanUpPhase to time it
+template<typename StepContext_t>
+void set_up_metrics_system(flecs::world &ecs, EngineMetricsCollector &collector_p, StepContext_t &step_context_p)
+{
+	ecs.system<EngineMetrics>("octopus::metrics::end_tick")
+		.kind(ecs.entity(EndCleanUpPhase))
+		.each([&collector_p, &step_context_p](flecs::entity e, EngineMetrics &metrics_p) {
+			// steps of the tick
+			HistoryMemory &steps_l = collector_p.steps_memory;
+			steps_l.clear();
+			auto const &manager_l = step_context_p.step_manager;
+			if(!manager_l.steps.empty())
+			{
+				account_history(steps_l, manager_l.steps.back(), 0);
+				account_history(steps_l, manager_l.presteps.back(), 0);
+				account_history(steps_l, manager_l.component_steps.back(), 0);
+			}
+			flecs::world world_l = e.world();
+			collector_p.end_tick(world_l, metrics_p, steps_l);
+		});
+}
+
+} // namespace octopus
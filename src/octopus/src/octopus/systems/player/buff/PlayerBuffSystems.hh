@@ -5,6 +5,7 @@
 #include "octopus/components/advanced/player/buff/PlayerBuff.hh"
 #include "octopus/components/basic/hitpoint/Destroyable.hh"
 #include "octopus/world/player/PlayerInfo.hh"
+#include "octopus/world/player/PlayerRegistry.hh"
 
 namespace octopus
 {
@@ -21,21 +22,34 @@ void declare_player_buff_systems(flecs::world &ecs, bool add_debuff_all_system =
 		.member("buff", &PlayerBuff<TargetType, BuffType, ComponentTypes...>::buff)
 	;
 
-	flecs::query query_player = ecs.query<PlayerInfo const, PlayerBuff<TargetType, BuffType, ComponentTypes...> const>();
+	set_up_player_registry(ecs);
+
+	// units grouped by player so that buffing a player only visits its tables
 	flecs::query query_units = ecs.query_builder<PlayerAppartenance const, ComponentTypes...>()
 		.template with<TargetType>()
+		.template group_by<PlayerGroup>()
+		.cached()
 		.build();
 
+	// apply or revert the buff on every unit of the player
+	auto for_each_unit = [query_units, &ecs](PlayerInfo const &player, auto &&func) {
+		query_units.set_group(get_player_group(ecs, player.idx)).each(func);
+		// units whose group has not been set yet (deferred) are checked by index
+		query_units.set_group(0).each([&](flecs::entity e, PlayerAppartenance const &player_appartenance, ComponentTypes&... component)
+		{
+			if(player_appartenance.idx == player.idx)
+			{
+				func(e, player_appartenance, component...);
+			}
+		});
+	};
+
 	// buff all units when buff is added
 	ecs.observer<PlayerInfo const, PlayerBuff<TargetType, BuffType, ComponentTypes...> const >()
 		.event(flecs::OnSet)
-		.each([query_units] (PlayerInfo const &player, PlayerBuff<TargetType, BuffType, ComponentTypes...> const &player_buff) {
-			query_units.each([&](flecs::entity e, PlayerAppartenance const &player_appartenance, ComponentTypes&... component)
+		.each([for_each_unit] (PlayerInfo const &player, PlayerBuff<TargetType, BuffType, ComponentTypes...> const &player_buff) {
+			for_each_unit(player, [&](flecs::entity e, PlayerAppartenance const &, ComponentTypes&... component)
 			{
-				if(player_appartenance.idx != player.idx)
-				{
-					return;
-				}
 				player_buff.buff.apply(e, component ...);
 			});
 		});
@@ -45,13 +59,9 @@ void declare_player_buff_systems(flecs::world &ecs, bool add_debuff_all_system =
 		// revert buff all units Debuff event is emited (usually before a save)
 		ecs.observer<PlayerInfo const, PlayerBuff<TargetType, BuffType, ComponentTypes...> const >()
 			.template event<DebuffAll>()
-			.each([query_units] (PlayerInfo const &player, PlayerBuff<TargetType, BuffType, ComponentTypes...> const &player_buff) {
-				query_units.each([&](flecs::entity e, PlayerAppartenance const &player_appartenance, ComponentTypes&... component)
+			.each([for_each_unit] (PlayerInfo const &player, PlayerBuff<TargetType, BuffType, ComponentTypes...> const &player_buff) {
+				for_each_unit(player, [&](flecs::entity e, PlayerAppartenance const &, ComponentTypes&... component)
 				{
-					if(player_appartenance.idx != player.idx)
-					{
-						return;
-					}
 					player_buff.buff.revert(e, component ...);
 				});
 			});
@@ -60,13 +70,9 @@ void declare_player_buff_systems(flecs::world &ecs, bool add_debuff_all_system =
 	// revert buff all units when buff is removed
 	ecs.observer<PlayerInfo const, PlayerBuff<TargetType, BuffType, ComponentTypes...> const >()
 		.event(flecs::OnRemove)
-		.each([query_units] (PlayerInfo const &player, PlayerBuff<TargetType, BuffType, ComponentTypes...> const &player_buff) {
-			query_units.each([&](flecs::entity e, PlayerAppartenance const &player_appartenance, ComponentTypes&... component)
+		.each([for_each_unit] (PlayerInfo const &player, PlayerBuff<TargetType, BuffType, ComponentTypes...> const &player_buff) {
+			for_each_unit(player, [&](flecs::entity e, PlayerAppartenance const &, ComponentTypes&... component)
 			{
-				if(player_appartenance.idx != player.idx)
-				{
-					return;
-				}
 				player_buff.buff.revert(e, component ...);
 			});
 		});
@@ -74,17 +80,17 @@ void declare_player_buff_systems(flecs::world &ecs, bool add_debuff_all_system =
 	// buff new unit when created
 	ecs.observer<PlayerAppartenance const, TargetType const, ComponentTypes...>()
 		.event(flecs::OnSet)
-		.each([query_player](flecs::entity e, PlayerAppartenance const &player_appartenance, TargetType const &, ComponentTypes&... component) {
-			query_player.each([&]
-				(PlayerInfo const &player, PlayerBuff<TargetType, BuffType, ComponentTypes...> const &player_buff)
-				{
-					if(player_appartenance.idx != player.idx)
-					{
-						return;
-					}
-					player_buff.buff.apply(e, component ...);
-				}
-			);
+		.each([&ecs](flecs::entity e, PlayerAppartenance const &player_appartenance, TargetType const &, ComponentTypes&... component) {
+			PlayerEntry const *entry_l = get_player_entry(ecs, player_appartenance.idx);
+			if(!entry_l)
+			{
+				return;
+			}
+			PlayerBuff<TargetType, BuffType, ComponentTypes...> const *player_buff = entry_l->player.template try_get<PlayerBuff<TargetType, BuffType, ComponentTypes...>>();
+			if(player_buff)
+			{
+				player_buff->buff.apply(e, component ...);
+			}
 		});
 }
 
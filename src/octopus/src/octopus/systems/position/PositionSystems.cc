@@ -7,20 +7,43 @@ namespace octopus
 
 Vector seek_force(Vector const &direction_p, Vector const &velocity_p, Fixed const &max_speed_p)
 {
-	Logger::getDebug() << "seek_force :: direction = "<<direction_p<<std::endl;
-	Logger::getDebug() << "seek_force :: velocity = "<<velocity_p<<std::endl;
-	Logger::getDebug() << "seek_force :: max_speed = "<<max_speed_p<<std::endl;
+	OCTOPUS_LOG_DEBUG << "seek_force :: direction = "<<direction_p<<std::endl;
+	OCTOPUS_LOG_DEBUG << "seek_force :: velocity = "<<velocity_p<<std::endl;
+	OCTOPUS_LOG_DEBUG << "seek_force :: max_speed = "<<max_speed_p<<std::endl;
 	Vector force;
 	if(square_length(direction_p) > Fixed::Zero())
 	{
 		force = direction_p/length(direction_p) * max_speed_p;
 		force = force - velocity_p;
 	}
-	Logger::getDebug() << "seek_force :: force = "<<force<<std::endl;
+	OCTOPUS_LOG_DEBUG << "seek_force :: force = "<<force<<std::endl;
 	return force;
 }
 
-Vector separation_force(flecs::entity const &ref_ent, PositionContext const &posContext_p, Position const &pos_ref_p, Collision const &col_ref_p)
+StuckInfo next_stuck_info(Position const &pos_p, Vector const &move_p, uint8_t sleep_wait_p)
+{
+	StuckInfo info = pos_p.stuck_info;
+	// woken up
+	if(info.sleeping)
+	{
+		return StuckInfo{0, pos_p.pos, false};
+	}
+	if(square_length(info.last_pos - pos_p.pos) > 0.5)
+	{
+		info.step_stuck = 0;
+		info.last_pos = pos_p.pos;
+	}
+	else
+	{
+		info.step_stuck += 1;
+	}
+	// put to sleep if idle for long enough
+	info.sleeping = sleep_wait_p > 0 && info.step_stuck >= sleep_wait_p
+		&& pos_p.velocity == Vector() && move_p == Vector();
+	return info;
+}
+
+Vector separation_force(flecs::entity const &ref_ent, PositionContext const &posContext_p, Position const &pos_ref_p, Collision const &col_ref_p, std::vector<flecs::entity> *sleeping_p)
 {
 	Vector force;
 	Fixed force_factor = 500;
@@ -28,20 +51,24 @@ Vector separation_force(flecs::entity const &ref_ent, PositionContext const &pos
 	std::function<bool(int32_t, flecs::entity)> func_l = [&](int32_t idx_l, flecs::entity e) -> bool {
 		Position const *pos_l = e.try_get<Position>();
 		Collision const *col_l = e.try_get<Collision>();
-		Logger::getDebug() << "separation_force :: with name=" << e.name()<<" id="<<e.id()<<std::endl;
+		OCTOPUS_LOG_DEBUG << "separation_force :: with name=" << e.name()<<" id="<<e.id()<<std::endl;
 		assert(pos_l);
 		assert(col_l);
 		if(!col_l->collision || col_l->mass == Fixed::Zero() || e.id() == ref_ent.id())
 		{
-			Logger::getDebug() << "separation_force :: skipped"<<std::endl;
+			OCTOPUS_LOG_DEBUG << "separation_force :: skipped"<<std::endl;
 			return true;
 		}
 		Vector diff = pos_ref_p.pos - pos_l->pos;
 		Fixed length_squared = square_length(diff);
 		Fixed ray_squared = (col_ref_p.ray + col_l->ray)*(col_ref_p.ray + col_l->ray);
-		Logger::getDebug() << "separation_force :: col_ref_p.ray ="<<col_ref_p.ray<<std::endl;
-		Logger::getDebug() << "separation_force :: col_l->ray ="<<col_l->ray<<std::endl;
+		OCTOPUS_LOG_DEBUG << "separation_force :: col_ref_p.ray ="<<col_ref_p.ray<<std::endl;
+		OCTOPUS_LOG_DEBUG << "separation_force :: col_l->ray ="<<col_l->ray<<std::endl;
 		Fixed max_range_squared = ray_squared * 2;
+		if(sleeping_p && pos_l->stuck_info.sleeping && length_squared <= max_range_squared)
+		{
+			sleeping_p->push_back(e);
+		}
 		if(length_squared <= ray_squared && length_squared > 0.001)
 		{
 			Vector local_force = diff/length(diff) * force_factor * 10 / length_squared;
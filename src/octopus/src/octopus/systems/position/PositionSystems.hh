@@ -6,7 +6,9 @@
 
 #include "octopus/utils/log/Logger.hh"
 #include "octopus/utils/ThreadPool.hh"
+#include "octopus/utils/profiler/CostAttribution.hh"
 #include "octopus/utils/aabb/aabb_tree.hh"
+#include "octopus/utils/metrics/EngineCounters.hh"
 #include "octopus/utils/log/Logger.hh"
 #include "octopus/world/position/PositionContext.hh"
 
@@ -15,14 +17,20 @@
 #include "octopus/components/basic/position/Move.hh"
 #include "octopus/components/basic/hitpoint/Destroyable.hh"
 #include "octopus/systems/phases/Phases.hh"
-#include "octopus/world/stats/TimeStats.hh"
 
 namespace octopus
 {
 
 Vector seek_force(Vector const &direction_p, Vector const &velocity_p, Fixed const &max_speed_p);
 
-Vector separation_force(flecs::entity const &ref_ent, PositionContext const &posContext_p, Position const &pos_ref_p, Collision const &col_ref_p);
+/// @brief compute the stuck info after this step
+/// @note a sleeping entity is woken up
+/// @param move_p the move about to be applied
+StuckInfo next_stuck_info(Position const &pos_p, Vector const &move_p, uint8_t sleep_wait_p);
+
+/// @brief compute the separation force from the neighbours
+/// @param sleeping_p if not null filled with the sleeping neighbours in range
+Vector separation_force(flecs::entity const &ref_ent, PositionContext const &posContext_p, Position const &pos_ref_p, Collision const &col_ref_p, std::vector<flecs::entity> *sleeping_p=nullptr);
 
 template<class StepManager_t>
 void add_to_tree(uint32_t idx_tree, flecs::entity e, Position const &pos, Collision const &col, StepManager_t &manager, PositionContext &pos_context)
@@ -33,6 +41,7 @@ void add_to_tree(uint32_t idx_tree, flecs::entity e, Position const &pos, Collis
 	aabb box {pos.pos, pos.pos};
 	box = expand_aabb(box, 2*col.ray);
 	int32_t idx_l = add_new_leaf(pos_context.trees[idx_tree], box, e);
+	EngineCounters::add(EngineCounter::TreeInserts);
 	manager.get_last_layer().back().template get<PositionInTreeStep>().add_step(e, PositionInTreeStep{idx_l, idx_tree});
 }
 
@@ -44,11 +53,12 @@ void update_tree(uint32_t idx_tree, flecs::entity e, Position const &pos, Collis
 
 	aabb box {pos.pos, pos.pos};
 	box = expand_aabb(box, col.ray);
-	update_leaf(pos_context.trees[idx_tree], pos_in_tree.idx_leaf[idx_tree], box, col.ray);
+	bool const reinserted_l = update_leaf(pos_context.trees[idx_tree], pos_in_tree.idx_leaf[idx_tree], box, col.ray);
+	EngineCounters::add(reinserted_l ? EngineCounter::TreeReinserts : EngineCounter::TreeKept);
 }
 
 template<class StepManager_t>
-void set_up_position_systems(flecs::world &ecs, ThreadPool &pool, StepManager_t &manager, PositionContext &pos_context, TimeStats &time_stats_p)
+void set_up_position_systems(flecs::world &ecs, ThreadPool &pool, StepManager_t &manager, PositionContext &pos_context, uint8_t sleep_wait_p=0)
 {
 	// Move system
 
@@ -56,12 +66,10 @@ void set_up_position_systems(flecs::world &ecs, ThreadPool &pool, StepManager_t
 	ecs.system<PositionInTree const, Position const, Collision const>()
 		.kind(ecs.entity(UpdatePhase))
 		.each([&](flecs::entity e, PositionInTree const &pos_in_tree, Position const &pos, Collision const& col) {
-			Logger::getDebug() << "Positon system :: start name=" << e.name()<<" id="<<e.id()<<std::endl;
-			time_stats_p.moving_entities += 1;
-			START_TIME(tree_update)
+			OCTOPUS_LOG_DEBUG << "Positon system :: start name=" << e.name()<<" id="<<e.id()<<std::endl;
 			if(pos_in_tree.idx_leaf[0] < 0)
 			{
-				Logger::getDebug() << "\tnew" << std::endl;
+				OCTOPUS_LOG_DEBUG << "\tnew" << std::endl;
 				for(uint32_t i = 0 ; i < pos_context.trees.size() ; ++i )
 				{
 					add_to_tree(i, e, pos, col, manager, pos_context);
@@ -69,25 +77,24 @@ void set_up_position_systems(flecs::world &ecs, ThreadPool &pool, StepManager_t
 			}
 			else
 			{
-				Logger::getDebug() << "\tupdate" << std::endl;
+				OCTOPUS_LOG_DEBUG << "\tupdate" << std::endl;
 				for(uint32_t i = 0 ; i < pos_context.trees.size() ; ++i )
 				{
 					update_tree(i, e, pos, col, pos_in_tree, manager, pos_context);
 				}
 			}
-			END_TIME(tree_update)
-			Logger::getDebug() << "Positon system :: end" << std::endl;
+			OCTOPUS_LOG_DEBUG << "Positon system :: end" << std::endl;
 		});
 
 	ecs.observer<Destroyable const, PositionInTree const>()
 		.event<Destroyed>()
 		.each([&pos_context](flecs::entity e, Destroyable const&, PositionInTree const &pos_in_tree) {
-			Logger::getDebug() << "Removed from tree name=" << e.name() << " idx=" << e.id() << std::endl;
+			OCTOPUS_LOG_DEBUG << "Removed from tree name=" << e.name() << " idx=" << e.id() << std::endl;
 			for(size_t i = 0 ; i < pos_context.trees.size() ; ++i )
 			{
 				remove_leaf(pos_context.trees[i], pos_in_tree.idx_leaf[i]);
 			}
-			Logger::getDebug() << "Removed from tree :: end" << std::endl;
+			OCTOPUS_LOG_DEBUG << "Removed from tree :: end" << std::endl;
 		});
 
 	static Fixed max_force = 100;
@@ -97,15 +104,21 @@ void set_up_position_systems(flecs::world &ecs, ThreadPool &pool, StepManager_t
 	ecs.system<Position const, Collision const, Move>()
 		.kind(ecs.entity(MovingPhase))
 		.multi_threaded()
-		.each([&](flecs::entity e, Position const &pos_p, Collision const &col_p, Move &move_p) {
-			Logger::getDebug() << "Flocking :: start name=" << e.name() << " idx=" << e.id() << std::endl;
-			START_TIME(position_system)
+		.each([&](flecs::iter &it, size_t i, Position const &pos_p, Collision const &col_p, Move &move_p) {
+			flecs::entity e = it.entity(i);
+			OCTOPUS_LOG_DEBUG << "Flocking :: start name=" << e.name() << " idx=" << e.id() << std::endl;
+
+			// sleeping with nothing to do
+			if(pos_p.stuck_info.sleeping && move_p.move == Vector())
+			{
+				return;
+			}
 
 			if(!col_p.collision || col_p.mass == Fixed::Zero() || col_p.mass > 999 || move_p.speed == Fixed::Zero())
 			{
-				END_TIME(position_system)
 				return;
 			}
+			OCTOPUS_ENTITY_COST("flocking", e, nullptr)
 
 			Vector f;  // forces
 			Vector a;  // acceleration
@@ -115,79 +128,97 @@ void set_up_position_systems(flecs::world &ecs, ThreadPool &pool, StepManager_t
 
 			// steering to target
 			Vector seek_l = seek_force(move_p.move, v, max_speed);
-			Logger::getDebug() << "Flocking :: seeking force = "<<seek_l<<std::endl;
+			OCTOPUS_LOG_DEBUG << "Flocking :: seeking force = "<<seek_l<<std::endl;
 			f = seek_l;
 			// separation force
-			Vector sep_l = separation_force(e, pos_context, pos_p, col_p);
-			Logger::getDebug() << "Flocking :: separation force = "<<sep_l<<std::endl;
+			std::vector<flecs::entity> sleeping_l;
+			Vector sep_l = separation_force(e, pos_context, pos_p, col_p, &sleeping_l);
+			OCTOPUS_LOG_DEBUG << "Flocking :: separation force = "<<sep_l<<std::endl;
 			f += sep_l;
 
 			if(pos_p.stuck_info.step_stuck > 25)
 			{
-				Logger::getDebug() << "Flocking :: unstuck speed = "<<Vector(-seek_l.y, seek_l.x)<<std::endl;
+				OCTOPUS_LOG_DEBUG << "Flocking :: unstuck speed = "<<Vector(-seek_l.y, seek_l.x)<<std::endl;
 				f += Vector(-seek_l.y, seek_l.x);
 			}
 
 			limit_length(f, max_force);
-			Logger::getDebug() << "Flocking :: total force = "<<f<<std::endl;
+			OCTOPUS_LOG_DEBUG << "Flocking :: total force = "<<f<<std::endl;
 
 			a = f / col_p.mass;
-			Logger::getDebug() << "Flocking :: acceleration = "<<a<<std::endl;
+			OCTOPUS_LOG_DEBUG << "Flocking :: acceleration = "<<a<<std::endl;
 			// tail force (to slow down when no other force)
 			if(manhattan_length(a) < Fixed(10, true) )
 			{
-				Logger::getDebug() << "Flocking :: reset acceleration"<<std::endl;
+				OCTOPUS_LOG_DEBUG << "Flocking :: reset acceleration"<<std::endl;
 				a = Vector(0,0)-v;
 			}
 
 			v += a;
 			limit_length(v, col_p.mass > 999 ? Fixed::Zero() : max_speed);
-			Logger::getDebug() << "Flocking :: v = "<<v<<std::endl;
+			OCTOPUS_LOG_DEBUG << "Flocking :: v = "<<v<<std::endl;
 
 			move_p.move = v * move_p.speed / max_speed;
 			limit_length(move_p.move, move_p.speed);
-			Logger::getDebug() << "Flocking :: move = "<<move_p.move<<std::endl;
-			END_TIME(position_system)
-			Logger::getDebug() << "Flocking :: end" << std::endl;
+			OCTOPUS_LOG_DEBUG << "Flocking :: move = "<<move_p.move<<std::endl;
+
+			// wake up sleeping neighbours if moving
+			if(move_p.move != Vector())
+			{
+				for(flecs::entity const &neighbour_l : sleeping_l)
+				{
+					wake_up(neighbour_l, *neighbour_l.try_get<Position>(), manager.get_last_layer()[it.world().get_stage_id()]);
+				}
+			}
+			OCTOPUS_LOG_DEBUG << "Flocking :: end" << std::endl;
 		});
 
+	// stuck info of entities not moving by themselves
 	ecs.system<Position>()
 		.kind(ecs.entity(MovingPhase))
+		.without<Move>()
 		.multi_threaded()
-		.run([&manager, &time_stats_p](flecs::iter &it)
+		.run([&manager, sleep_wait_p](flecs::iter &it)
 		{
-			START_TIME(position_system)
 		    while (it.next())
 			{
 				auto pos = it.field<Position const>(0);
 				size_t thread_idx = it.world().get_stage_id();
 				for(size_t ent_idx = 0; ent_idx < it.count(); ++ ent_idx)
 				{
-					flecs::entity e = it.entity(ent_idx);
-					StuckInfo info = pos[ent_idx].stuck_info;
-					if(square_length(info.last_pos - pos[ent_idx].pos) > 0.5)
-					{
-						info.step_stuck = 0;
-						info.last_pos = pos[ent_idx].pos;
-					}
-					else
+					// sleeping entities do not change
+					if(pos[ent_idx].stuck_info.sleeping)
 					{
-						info.step_stuck += 1;
+						continue;
 					}
+					flecs::entity e = it.entity(ent_idx);
+					StuckInfo info = next_stuck_info(pos[ent_idx], Vector(), sleep_wait_p);
 					manager.get_last_layer()[thread_idx].template get<StuckInfoStep>().add_step(e, {info});
 				}
 			}
-			END_TIME(position_system)
 		});
 
-	ecs.system<Move>()
+	// apply move, velocity and stuck info in one step
+	ecs.system<Position const, Move>()
 		.kind(ecs.entity(MovingPhase))
-		.each([&ecs, &manager](flecs::entity e, Move &move_p) {
-			Logger::getDebug() << "Apply move :: start name=" << e.name() << " idx=" << e.id() << std::endl;
-			manager.get_last_layer().back().template get<PositionStep>().add_step(e, PositionStep{move_p.move});
-			manager.get_last_layer().back().template get<VelocityStep>().add_step(e, VelocityStep{move_p.move});
+		.multi_threaded()
+		.each([&manager, sleep_wait_p](flecs::iter &it, size_t i, Position const &pos_p, Move &move_p) {
+			flecs::entity e = it.entity(i);
+			OCTOPUS_LOG_DEBUG << "Apply move :: start name=" << e.name() << " idx=" << e.id() << std::endl;
+			// sleeping with nothing to do
+			if(pos_p.stuck_info.sleeping && move_p.move == Vector())
+			{
+				return;
+			}
+			auto &container_l = manager.get_last_layer()[it.world().get_stage_id()];
+			StuckInfo info = next_stuck_info(pos_p, move_p.move, sleep_wait_p);
+			container_l.template get<KinematicStep>().add_step(e, KinematicStep{move_p.move, move_p.move, info.step_stuck, info.last_pos});
+			if(info.sleeping != pos_p.stuck_info.sleeping)
+			{
+				container_l.template get<SleepStep>().add_step(e, SleepStep{info.sleeping});
+			}
 			move_p.move = Vector();
-			Logger::getDebug() << "Apply move :: end" << std::endl;
+			OCTOPUS_LOG_DEBUG << "Apply move :: end" << std::endl;
 		});
 
 	// Validators
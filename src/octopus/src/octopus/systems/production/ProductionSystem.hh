@@ -9,7 +9,9 @@
 #include "octopus/components/advanced/production/queue/ProductionQueue.hh"
 #include "octopus/world/production/ProductionTemplateLibrary.hh"
 #include "octopus/world/player/PlayerInfo.hh"
+#include "octopus/world/player/PlayerRegistry.hh"
 #include "octopus/world/resources/ResourceStock.hh"
+#include "octopus/world/timer/TimerWheel.hh"
 #include "octopus/utils/log/Logger.hh"
 
 namespace octopus
@@ -25,10 +27,10 @@ void cancel_production(
     flecs::world &ecs,
     StepManager_t &manager)
 {
-    Logger::getDebug() << "  cancel_production idx = " << idx_canceled << std::endl;
+    OCTOPUS_LOG_DEBUG << "  cancel_production idx = " << idx_canceled << std::endl;
     if(long(idx_canceled) >= long(prod_queue.queue.size()))
     {
-        Logger::getDebug() << "    skipped" << std::endl;
+        OCTOPUS_LOG_DEBUG << "    skipped" << std::endl;
         return;
     }
 
@@ -36,15 +38,17 @@ void cancel_production(
     ProductionTemplate<StepManager_t> const * prod_l = prod_lib->try_get(prod_queue.queue[idx_canceled]);
     if(!prod_l)
     {
-        Logger::getDebug() << "    no prod" << std::endl;
+        OCTOPUS_LOG_DEBUG << "    no prod" << std::endl;
         return;
     }
 
-    manager.get_last_layer().back().template get<ProductionQueueOperationStep>().add_step(producer, {"", idx_canceled});
+    manager.get_last_layer().back().template get<ProductionQueueOperationStep>().add_step(producer, {Symbol(), idx_canceled, 0, prod_l->duration()});
     prod_l->dequeue(producer, ecs, manager);
     if(idx_canceled == 0)
     {
         manager.get_last_layer().back().template get<ProductionQueueTimestampStep>().add_step(producer, {0});
+        // start the next production
+        add_timer(ecs, manager, producer, get_time_stamp(ecs)+1, production_timer_kind);
     }
     for(auto &&pair_l : prod_l->resource_consumption())
     {
@@ -53,55 +57,87 @@ void cancel_production(
         // add step for consumption
         manager.get_last_layer().back().template get<ResourceStockStep>().add_step(player, {resource_consumed_l, resource_l});
     }
-    Logger::getDebug() << "    canceled" << std::endl;
+    OCTOPUS_LOG_DEBUG << "    canceled" << std::endl;
 }
 
 template<class StepManager_t>
-void set_up_production_systems(flecs::world &ecs, ThreadPool &pool, StepManager_t &manager_p, TimeStats &time_stats_p)
+void set_up_production_systems(flecs::world &ecs, ThreadPool &pool, StepManager_t &manager_p)
 {
 	auto &&production_library = ecs.try_get<ProductionTemplateLibrary<StepManager_t> >();
     if(!production_library) { return; }
 
-	// update position tree
-	ecs.system<ProductionQueue const>()
-		.kind(ecs.entity(PostUpdatePhase))
-		.each([&, production_library](flecs::entity e, ProductionQueue const &queue_p) {
-			Logger::getDebug() << "Production System :: start name=" << e.name() << " idx=" << e.id() << std::endl;
-
-            if(queue_p.queue.empty()) { return; }
-
-            ProductionTemplate<StepManager_t> const & prod_template_l = production_library->get(queue_p.queue[0]);
-
-            // start == 0 means we need to start producing
-            if(queue_p.start_timestamp  == 0)
-            {
-                manager_p.get_last_layer().back().template get<ProductionQueueTimestampStep>().add_step(e, ProductionQueueTimestampStep{get_time_stamp(ecs) });
-            }
-            // prod is done
-            else if(queue_p.start_timestamp + prod_template_l.duration() <= get_time_stamp(ecs) + 1)
-            {
-                // add production step
-                prod_template_l.produce(e, ecs, manager_p);
-
-                // remove first element
-				manager_p.get_last_layer().back().template get<ProductionQueueOperationStep>().add_step(e, ProductionQueueOperationStep{"", 0});
-                // reset timestamp
-                manager_p.get_last_layer().back().template get<ProductionQueueTimestampStep>().add_step(e, ProductionQueueTimestampStep{0});
-            }
-			Logger::getDebug() << "Production System :: end" << std::endl;
-        });
+	// queues set outside of steps (creation, loading) get their
+	// cached duration and are checked at the next update
+	ecs.observer<ProductionQueue>()
+		.event(flecs::OnSet)
+		.yield_existing()
+		.each([&ecs, production_library](flecs::entity e, ProductionQueue &queue_p) {
+			queue_p.queue_duration = get_queue_duration(*production_library, queue_p.queue);
+			TimerWheel *wheel_l = ecs.try_get_mut<TimerWheel>();
+			if(wheel_l && !queue_p.queue.empty())
+			{
+				wheel_l->add({e, 0, production_timer_kind});
+			}
+		});
 
-    flecs::query<PlayerInfo> query_player = ecs.query<PlayerInfo>();
+	// update production queues
+	// only producers with a due timer are checked : timers are added
+	// when a production is enqueued, started, done or canceled
+	ecs.system<>()
+		.kind(ecs.entity(PostUpdatePhase))
+		.run([&, production_library](flecs::iter &) {
+			int64_t const time_l = get_time_stamp(ecs);
+			for(flecs::entity e : get_due_entities(ecs, production_timer_kind))
+			{
+				// skip destroyed producers
+				if(!e.is_alive() || e.has(flecs::Disabled)) { continue; }
+				ProductionQueue const *queue_l = e.try_get<ProductionQueue>();
+				if(!queue_l || queue_l->queue.empty()) { continue; }
+
+				OCTOPUS_LOG_DEBUG << "Production System :: start name=" << e.name() << " idx=" << e.id() << std::endl;
+
+				ProductionTemplate<StepManager_t> const & prod_template_l = production_library->get(queue_l->queue[0]);
+
+				// start == 0 means we need to start producing
+				if(queue_l->start_timestamp  == 0)
+				{
+					manager_p.get_last_layer().back().template get<ProductionQueueTimestampStep>().add_step(e, ProductionQueueTimestampStep{time_l});
+					// first tick where start + duration <= time + 1
+					add_timer(ecs, manager_p, e, std::max<int64_t>(time_l + 1, time_l + prod_template_l.duration() - 1), production_timer_kind);
+				}
+				// prod is done
+				else if(queue_l->start_timestamp + prod_template_l.duration() <= time_l + 1)
+				{
+					// add production step
+					prod_template_l.produce(e, ecs, manager_p);
+
+					// remove first element
+					manager_p.get_last_layer().back().template get<ProductionQueueOperationStep>().add_step(e, ProductionQueueOperationStep{Symbol(), 0, 0, prod_template_l.duration()});
+					// reset timestamp
+					manager_p.get_last_layer().back().template get<ProductionQueueTimestampStep>().add_step(e, ProductionQueueTimestampStep{0});
+					// start the next production
+					if(queue_l->queue.size() > 1)
+					{
+						add_timer(ecs, manager_p, e, time_l + 1, production_timer_kind);
+					}
+				}
+				// not done yet (producer checked by an outdated timer or loaded)
+				else
+				{
+					add_timer(ecs, manager_p, e, queue_l->start_timestamp + prod_template_l.duration() - 1, production_timer_kind);
+				}
+				OCTOPUS_LOG_DEBUG << "Production System :: end" << std::endl;
+			}
+		});
 
 	ecs.observer<Destroyable const, ProductionQueue const, PlayerAppartenance const>()
 		.event<Destroyed>()
-		.each([&, production_library, query_player](flecs::entity e, Destroyable const&, ProductionQueue const &queue, PlayerAppartenance const &player_app) {
-			Logger::getDebug() << "Production Destroyed :: start name=" << e.name() << " idx=" << e.id() << std::endl;
+		.each([&, production_library](flecs::entity e, Destroyable const&, ProductionQueue const &queue, PlayerAppartenance const &player_app) {
+			OCTOPUS_LOG_DEBUG << "Production Destroyed :: start name=" << e.name() << " idx=" << e.id() << std::endl;
 
             // get player info
-            flecs::entity player = query_player.find([&player_app](PlayerInfo& p) {
-                return p.idx == player_app.idx;
-            });
+            PlayerEntry const *player_entry = get_player_entry(ecs, player_app.idx);
+            flecs::entity player = player_entry ? player_entry->player : flecs::entity();
 
             for(int idx = 0 ; (size_t)idx < queue.queue.size() ; ++idx)
             {
@@ -9,21 +9,23 @@
 #include "octopus/components/basic/position/Position.hh"
 #include "octopus/components/basic/projectile/Projectile.hh"
 #include "octopus/utils/log/Logger.hh"
+#include "octopus/world/budget/WorkBudget.hh"
+#include "octopus/world/damage/DamageAccumulator.hh"
 
 namespace octopus
 {
 
 template<class StepManager_t>
-void set_up_projectile_systems(flecs::world &ecs, ThreadPool &pool, StepManager_t &manager_p, TimeStats &)
+void set_up_projectile_systems(flecs::world &ecs, ThreadPool &pool, StepManager_t &manager_p, DamageAccumulator &damage_accumulator_p,
+	BudgetChannel &retarget_p)
 {
-	constexpr int64_t proj_retarget_wait = 32;
-
 	// update target position
 	ecs.system<Projectile const, ProjectileConstants const>()
 		.kind(ecs.entity(PostUpdatePhase))
-		.each([&, proj_retarget_wait](flecs::entity e, Projectile const &proj, ProjectileConstants const &proj_info) {
+		.each([&](flecs::entity e, Projectile const &proj, ProjectileConstants const &proj_info) {
+			retarget_p.add_demand(1);
 			// update position
-			if((get_time_stamp(ecs) + e.id()) % proj_retarget_wait == 0)
+			if(retarget_p.is_due(get_time_stamp(ecs), e.id()))
 			{
 				HitPoint const * hp = proj.target ? proj.target.try_get<HitPoint>() : nullptr;
 				Position const * pos = proj.target ? proj.target.try_get<Position>() : nullptr;
@@ -37,7 +39,7 @@ void set_up_projectile_systems(flecs::world &ecs, ThreadPool &pool, StepManager_
 	// update position based on taget pos and trigger
 	ecs.system<Projectile const, ProjectileConstants const, Position const>()
 		.kind(ecs.entity(PostUpdatePhase))
-		.each([&, proj_retarget_wait](flecs::entity e, Projectile const &proj, ProjectileConstants const &proj_info, Position const &pos) {
+		.each([&](flecs::entity e, Projectile const &proj, ProjectileConstants const &proj_info, Position const &pos) {
 			Vector diff = proj.pos_target - pos.pos;
 			Vector move = diff;
 			Fixed length = octopus::length(diff);
@@ -56,9 +58,13 @@ void set_up_projectile_systems(flecs::world &ecs, ThreadPool &pool, StepManager_
 	ecs.system<ProjectileTrigger const, Projectile const>()
 		.kind(ecs.entity(EndUpdatePhase))
 		.without<NoInstantDamage>()
-		.each([&manager_p](flecs::entity e, ProjectileTrigger const& trigger, Projectile const &proj) {
+		.each([&manager_p, &damage_accumulator_p](flecs::entity e, ProjectileTrigger const& trigger, Projectile const &proj) {
 			if (trigger.target) {
-				manager_p.get_last_layer().back().template get<HitPointStep>().add_step(trigger.target, {-proj.damage});
+				damage_accumulator_p.add(e, trigger.target, proj.damage);
+				if(Position const *pos_l = trigger.target.try_get<Position>())
+				{
+					wake_up(trigger.target, *pos_l, manager_p.get_last_layer().back());
+				}
 			}
 		});
 
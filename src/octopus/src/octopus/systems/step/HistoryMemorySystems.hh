@@ -0,0 +1,40 @@
+#pragma once
+
+#include "flecs.h"
+
+#include "octopus/components/basic/timestamp/TimeStamp.hh"
+#include "octopus/systems/phases/Phases.hh"
+#include "octopus/utils/profiler/Profiler.hh"
+#include "octopus/world/step/HistoryMemory.hh"
+#include "octopus/world/step/StepEntityManager.hh"
+
+namespace octopus
+{
+
+/// @brief refresh the HistoryMemory singleton every period_p steps
+/// once every step of the tick has been added
+template<typename StepContext_t>
+void set_up_history_memory_system(flecs::world &ecs, StepContext_t &step_context_p, uint32_t period_p)
+{
+	ecs.add<HistoryMemory>();
+
+	ecs.system<HistoryMemory>()
+		.kind(ecs.entity(EndCleanUpPhase))
+		.each([&ecs, &step_context_p, period_p](HistoryMemory &memory_p) {
+			if(period_p == 0 || get_time_stamp(ecs) % period_p != 0)
+			{
+				return;
+			}
+			OCTOPUS_ZONE("history_memory")
+			memory_p.clear();
+			account_history(memory_p, step_context_p.step_manager);
+			account_history(memory_p, step_context_p.state_step_manager);
+			account_history(memory_p, step_context_p.memento_manager);
+			if(StepEntityManager const *entity_manager_l = ecs.try_get<StepEntityManager>())
+			{
+				account_history(memory_p, *entity_manager_l);
+			}
+		});
+}
+
+} // namespace octopus
@@ -21,7 +21,7 @@ void set_up_step_systems(flecs::world &ecs, ThreadPool &pool, StepManager_t &man
 	ecs.system<>()
 		.kind(ecs.entity(InitializationPhase))
 		.run([&, step_kept_p](flecs::iter& ) {
-			Logger::getDebug() << "New Step Layer :: start" << std::endl;
+			OCTOPUS_LOG_DEBUG << "New Step Layer :: start" << std::endl;
 			manager_p.add_layer(pool.size());
 			state_step_container_p.add_layer();
 			if(step_kept_p != 0 && manager_p.steps.size() > step_kept_p)
@@ -29,19 +29,19 @@ void set_up_step_systems(flecs::world &ecs, ThreadPool &pool, StepManager_t &man
 				manager_p.pop_layer();
 				state_step_container_p.pop_layer();
 			}
-			Logger::getDebug() << "New Step Layer :: end" << std::endl;
+			OCTOPUS_LOG_DEBUG << "New Step Layer :: end" << std::endl;
 		});
 
 	ecs.system<StepEntityManager>()
 		.kind(ecs.entity(InitializationPhase))
 		.each([step_kept_p](StepEntityManager &step_entity_manager_p) {
-			Logger::getDebug() << "New Step Entity Layer :: start" << std::endl;
+			OCTOPUS_LOG_DEBUG << "New Step Entity Layer :: start" << std::endl;
 			step_entity_manager_p.add_layer();
 			if(step_kept_p != 0 && step_entity_manager_p.creation_steps.size() > step_kept_p)
 			{
 				step_entity_manager_p.pop_layer();
 			}
-			Logger::getDebug() << "New Step Entity Layer :: end" << std::endl;
+			OCTOPUS_LOG_DEBUG << "New Step Entity Layer :: end" << std::endl;
 		});
 
 	// apply state steps and clean up steps
@@ -49,12 +49,12 @@ void set_up_step_systems(flecs::world &ecs, ThreadPool &pool, StepManager_t &man
         .immediate()
 		.kind(ecs.entity(PreUpdatePhase))
 		.run([&](flecs::iter& ) {
-			Logger::getDebug() << "Apply Pre Steps :: start" << std::endl;
+			OCTOPUS_LOG_DEBUG << "Apply Pre Steps :: start" << std::endl;
 			ecs.defer_suspend();
 			dispatch_apply(manager_p.get_last_prelayer(), pool);
 			state_step_container_p.get_last_prelayer().apply(ecs);
 			ecs.defer_resume();
-			Logger::getDebug() << "Apply Pre Steps :: end" << std::endl;
+			OCTOPUS_LOG_DEBUG << "Apply Pre Steps :: end" << std::endl;
 		});
 
 	// apply steps
@@ -62,12 +62,12 @@ void set_up_step_systems(flecs::world &ecs, ThreadPool &pool, StepManager_t &man
         .immediate()
 		.kind(ecs.entity(SteppingPhase))
 		.run([&](flecs::iter&) {
-			Logger::getDebug() << "Apply Steps :: start" << std::endl;
+			OCTOPUS_LOG_DEBUG << "Apply Steps :: start" << std::endl;
 			ecs.defer_suspend();
 			dispatch_apply(manager_p.get_last_layer(), pool);
 			state_step_container_p.get_last_layer().apply(ecs);
 			ecs.defer_resume();
-			Logger::getDebug() << "Apply Steps :: end" << std::endl;
+			OCTOPUS_LOG_DEBUG << "Apply Steps :: end" << std::endl;
 		});
 
 	// apply component step
@@ -75,18 +75,18 @@ void set_up_step_systems(flecs::world &ecs, ThreadPool &pool, StepManager_t &man
         .immediate()
 		.kind(ecs.entity(SteppingPhase))
 		.run([&](flecs::iter&) {
-			Logger::getDebug() << "Apply Component Steps :: start" << std::endl;
+			OCTOPUS_LOG_DEBUG << "Apply Component Steps :: start" << std::endl;
 			ecs.defer_suspend();
 			apply_all_containers(manager_p.get_last_component_layer());
 			ecs.defer_resume();
-			Logger::getDebug() << "Apply Component Steps :: end" << std::endl;
+			OCTOPUS_LOG_DEBUG << "Apply Component Steps :: end" << std::endl;
 		});
 
 	ecs.system<StepEntityManager>()
 		.immediate()
 		.kind(ecs.entity(SteppingPhase))
 		.each([&ecs](StepEntityManager &step_entity_manager_p) {
-			Logger::getDebug() << "Apply Entity Steps :: start" << std::endl;
+			OCTOPUS_LOG_DEBUG << "Apply Entity Steps :: start" << std::endl;
 			step_entity_manager_p.get_last_memento_layer().reserve(step_entity_manager_p.get_last_layer().size());
 			ecs.defer_suspend();
 			for(EntityCreationStep const &step_l : step_entity_manager_p.get_last_layer())
@@ -96,7 +96,7 @@ void set_up_step_systems(flecs::world &ecs, ThreadPool &pool, StepManager_t &man
 				step_entity_manager_p.get_last_memento_layer().push_back(memento_l);
 			}
 			ecs.defer_resume();
-			Logger::getDebug() << "Apply Entity Steps :: end" << std::endl;
+			OCTOPUS_LOG_DEBUG << "Apply Entity Steps :: end" << std::endl;
 		});
 }
 
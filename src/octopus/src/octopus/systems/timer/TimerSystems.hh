@@ -0,0 +1,36 @@
+#pragma once
+
+#include "flecs.h"
+
+#include "octopus/components/basic/timestamp/TimeStamp.hh"
+#include "octopus/world/timer/TimerWheel.hh"
+#include "octopus/systems/phases/Phases.hh"
+#include "octopus/utils/log/Logger.hh"
+
+namespace octopus
+{
+
+/// @brief set up the timer wheel and the system collecting due timers
+/// @note must be set up before the systems using timers (PostUpdatePhase)
+template<class StepManager_t>
+void set_up_timer_systems(flecs::world &ecs, StepManager_t &manager_p)
+{
+	if(!ecs.try_get<TimerWheel>()) { ecs.add<TimerWheel>(); }
+	ecs.add<DueTimers>();
+
+	// collect due timers and remove them from the wheel
+	ecs.system<TimerWheel const>()
+		.kind(ecs.entity(PostUpdatePhase))
+		.each([&ecs, &manager_p](flecs::entity e, TimerWheel const &wheel_p) {
+			DueTimers &due_l = *ecs.try_get_mut<DueTimers>();
+			due_l.timers.clear();
+			wheel_p.get_due(get_time_stamp(ecs), due_l.timers);
+			for(Timer const &timer_l : due_l.timers)
+			{
+				manager_p.get_last_layer().back().template get<TimerStep>().add_step(e, {timer_l, false});
+			}
+			OCTOPUS_LOG_DEBUG << "Timer System :: due=" << due_l.timers.size() << std::endl;
+		});
+}
+
+} // namespace octopus
@@ -17,7 +17,7 @@ void set_up_timestamp_systems(flecs::world &ecs, StepManager_t &manager_p)
 	ecs.system<TimeStamp const>()
 		.kind(ecs.entity(UpdatePhase))
 		.each([&](flecs::entity e, TimeStamp const &ts) {
-			Logger::getDebug() << "TimeStamp System :: " <<ts.time<< std::endl;
+			OCTOPUS_LOG_DEBUG << "TimeStamp System :: " <<ts.time<< std::endl;
             manager_p.get_last_layer().back().template get<TimeStampIncrementStep>().add_step(e, TimeStampIncrementStep());
         });
 }
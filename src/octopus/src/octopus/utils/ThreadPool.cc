@@ -1,5 +1,7 @@
 #include "ThreadPool.hh"
 
+#include "octopus/utils/profiler/Profiler.hh"
+
 
 ThreadPool::ThreadPool(uint32_t num_threads) {
     //const uint32_t num_threads = std::thread::hardware_concurrency(); // Max # of threads the system supports
@@ -57,7 +59,7 @@ void ThreadPool::stop() {
     threads.clear();
 }
 
-void enqueue_and_wait(ThreadPool &pool_p, std::vector<std::function<void()>> const &jobs_p)
+void enqueue_and_wait(ThreadPool &pool_p, std::vector<std::function<void()>> const &jobs_p, char const *zone_p)
 {
 	int finished_l = 0;
 	std::mutex terminationMutex_l;
@@ -67,9 +69,12 @@ void enqueue_and_wait(ThreadPool &pool_p, std::vector<std::function<void()>> con
 
 	for(int n = 0 ; n < nbJobs_l ; ++ n)
 	{
-		pool_p.queueJob([&finished_l, &termination_l, &terminationMutex_l, &jobs_p, n]()
+		pool_p.queueJob([&finished_l, &termination_l, &terminationMutex_l, &jobs_p, n, zone_p]()
 		{
-			jobs_p[n]();
+			{
+				OCTOPUS_ZONE(zone_p)
+				jobs_p[n]();
+			}
 			std::unique_lock<std::mutex> lock_l(terminationMutex_l);
 			finished_l++;
 			termination_l.notify_all();
@@ -105,7 +110,7 @@ std::vector<std::function<void()>> split_job(size_t size, ThreadPool const &pool
 	return jobs_l;
 }
 
-void threading(size_t size, ThreadPool &pool, std::function<void(size_t, size_t, size_t)> &&func)
+void threading(size_t size, ThreadPool &pool, std::function<void(size_t, size_t, size_t)> &&func, char const *zone_p)
 {
-	enqueue_and_wait(pool, split_job(size, pool, std::move(func)));
+	enqueue_and_wait(pool, split_job(size, pool, std::move(func)), zone_p);
 }
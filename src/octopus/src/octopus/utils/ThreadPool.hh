@@ -31,10 +31,12 @@ private:
 	std::atomic_int working = 0;
 };
 
-void enqueue_and_wait(ThreadPool &pool_p, std::vector<std::function<void()>> const &jobs_p);
+/// @brief run the jobs on the pool and wait for all of them
+/// @param zone_p name of the profiler zone of every job
+void enqueue_and_wait(ThreadPool &pool_p, std::vector<std::function<void()>> const &jobs_p, char const *zone_p="thread_pool.job");
 
 std::vector<std::function<void()>> split_job(size_t size, ThreadPool const &pool, std::function<void(size_t, size_t, size_t)> &&func);
 
-void threading(size_t size, ThreadPool &pool, std::function<void(size_t, size_t, size_t)> &&func);
+void threading(size_t size, ThreadPool &pool, std::function<void(size_t, size_t, size_t)> &&func, char const *zone_p="thread_pool.job");
 
 #endif
@@ -67,8 +67,10 @@ int32_t add_new_leaf( aabb_tree<data_t>& tree, aabb const &new_box, data_t const
 template<typename data_t>
 void remove_leaf( aabb_tree<data_t>& tree, int32_t leaf );
 
+/// @brief reinsert the leaf if the new box is out of its box
+/// @return true if the leaf was reinserted
 template<typename data_t>
-void update_leaf( aabb_tree<data_t>& tree, int32_t leaf, aabb const &new_box, octopus::Fixed const &margin_p );
+bool update_leaf( aabb_tree<data_t>& tree, int32_t leaf, aabb const &new_box, octopus::Fixed const &margin_p );
 
 template<typename data_t>
 void tree_box_query( const aabb_tree<data_t> &tree, aabb const &box, std::function<bool(int32_t, data_t)> callback);
@@ -5,6 +5,8 @@
 #include <cassert>
 #include <functional>
 
+#include "octopus/utils/metrics/EngineCounters.hh"
+
 enum rotate_type
 {
 	rotateNone,
@@ -617,7 +619,7 @@ void remove_leaf( aabb_tree<data_t>& tree, int32_t leaf )
 }
 
 template<typename data_t>
-void update_leaf( aabb_tree<data_t>& tree, int32_t leaf, aabb const &new_box, octopus::Fixed const &margin_p )
+bool update_leaf( aabb_tree<data_t>& tree, int32_t leaf, aabb const &new_box, octopus::Fixed const &margin_p )
 {
 	if(!included_aabb(new_box, tree.nodes[leaf].box))
 	{
@@ -627,12 +629,15 @@ void update_leaf( aabb_tree<data_t>& tree, int32_t leaf, aabb const &new_box, oc
 
 		bool shouldRotate = false;
 		insert_leaf( tree, leaf, shouldRotate );
+		return true;
 	}
+	return false;
 }
 
 template<typename data_t>
 void tree_box_query( const aabb_tree<data_t> &tree, aabb const &box, std::function<bool(int32_t, data_t)> callback)
 {
+	octopus::EngineCounters::add(octopus::EngineCounter::SpatialQueries);
 	constexpr size_t stack_size = 1024;
 	int32_t stack[stack_size];
 	int32_t stackCount = 0;
@@ -675,6 +680,7 @@ void tree_box_query( const aabb_tree<data_t> &tree, aabb const &box, std::functi
 template<typename data_t>
 void tree_circle_query( const aabb_tree<data_t> &tree, octopus::Vector const &center, octopus::Fixed const &ray, std::function<bool(int32_t, data_t)> callback)
 {
+	octopus::EngineCounters::add(octopus::EngineCounter::SpatialQueries);
 	constexpr int32_t stack_size = 1024;
 	int32_t stack[stack_size];
 	int32_t stackCount = 0;
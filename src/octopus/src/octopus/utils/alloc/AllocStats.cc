@@ -0,0 +1,218 @@
+#include "AllocStats.hh"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "flecs.h"
+
+namespace octopus
+{
+
+namespace
+{
+
+constexpr size_t alloc_sources = 2;
+/// @brief threads share a slot when there are more threads than slots
+constexpr uint32_t alloc_slots = 64;
+
+/// @brief counters of the threads of the slot (one cache line per slot)
+struct alignas(64) AllocSlot
+{
+	std::atomic<uint64_t> allocations[alloc_sources];
+	std::atomic<uint64_t> deallocations[alloc_sources];
+	std::atomic<uint64_t> bytes[alloc_sources];
+};
+
+// zero initialized (static storage)
+AllocSlot slots[alloc_slots];
+std::atomic<uint32_t> next_slot {0};
+
+// constant initialized so that they are usable in any allocation
+thread_local uint32_t thread_slot = alloc_slots;
+thread_local AllocCounters thread_counters;
+
+AllocSlot &get_slot()
+{
+	if(thread_slot == alloc_slots)
+	{
+		thread_slot = next_slot.fetch_add(1, std::memory_order_relaxed) % alloc_slots;
+	}
+	return slots[thread_slot];
+}
+
+void *tracked_flecs_malloc(ecs_size_t size_p)
+{
+	AllocStats::record_allocation(AllocSource::Flecs, size_t(size_p));
+	return std::malloc(size_t(size_p));
+}
+
+void *tracked_flecs_calloc(ecs_size_t size_p)
+{
+	AllocStats::record_allocation(AllocSource::Flecs, size_t(size_p));
+	return std::calloc(1, size_t(size_p));
+}
+
+void *tracked_flecs_realloc(void *ptr_p, ecs_size_t size_p)
+{
+	// a reallocation is counted as a new allocation
+	if(ptr_p)
+	{
+		AllocStats::record_deallocation(AllocSource::Flecs);
+	}
+	AllocStats::record_allocation(AllocSource::Flecs, size_t(size_p));
+	return std::realloc(ptr_p, size_t(size_p));
+}
+
+void tracked_flecs_free(void *ptr_p)
+{
+	if(ptr_p)
+	{
+		AllocStats::record_deallocation(AllocSource::Flecs);
+	}
+	std::free(ptr_p);
+}
+
+} // namespace
+
+bool AllocStats::tracks_new()
+{
+#ifdef OCTOPUS_ALLOC_TRACKING
+	return true;
+#else
+	return false;
+#endif
+}
+
+AllocCounters AllocStats::thread()
+{
+	return thread_counters;
+}
+
+AllocCounters AllocStats::total(AllocSource source_p)
+{
+	size_t const idx_l = size_t(source_p);
+	AllocCounters counters_l;
+	for(AllocSlot const &slot_l : slots)
+	{
+		counters_l.allocations += slot_l.allocations[idx_l].load(std::memory_order_relaxed);
+		counters_l.deallocations += slot_l.deallocations[idx_l].load(std::memory_order_relaxed);
+		counters_l.bytes += slot_l.bytes[idx_l].load(std::memory_order_relaxed);
+	}
+	return counters_l;
+}
+
+AllocCounters AllocStats::total()
+{
+	AllocCounters counters_l = total(AllocSource::New);
+	counters_l += total(AllocSource::Flecs);
+	return counters_l;
+}
+
+void AllocStats::record_allocation(AllocSource source_p, size_t size_p)
+{
+	++thread_counters.allocations;
+	thread_counters.bytes += size_p;
+	AllocSlot &slot_l = get_slot();
+	slot_l.allocations[size_t(source_p)].fetch_add(1, std::memory_order_relaxed);
+	slot_l.bytes[size_t(source_p)].fetch_add(size_p, std::memory_order_relaxed);
+}
+
+void AllocStats::record_deallocation(AllocSource source_p)
+{
+	++thread_counters.deallocations;
+	get_slot().deallocations[size_t(source_p)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void AllocStats::install_flecs_hooks()
+{
+	// compatible with the defaults (malloc/free) so memory allocated
+	// before the installation can be freed by the hooks
+	ecs_os_api.malloc_ = tracked_flecs_malloc;
+	ecs_os_api.calloc_ = tracked_flecs_calloc;
+	ecs_os_api.realloc_ = tracked_flecs_realloc;
+	ecs_os_api.free_ = tracked_flecs_free;
+}
+
+} // namespace octopus
+
+#ifdef OCTOPUS_ALLOC_TRACKING
+
+/////////////////////////////////////////////////
+/// Replacement of the global operator new/delete
+/////////////////////////////////////////////////
+
+namespace
+{
+
+void *tracked_malloc(std::size_t size_p, bool nothrow_p)
+{
+	if(size_p == 0) { size_p = 1; }
+	void *ptr_l = std::malloc(size_p);
+	while(!ptr_l && !nothrow_p)
+	{
+		std::new_handler handler_l = std::get_new_handler();
+		// no exceptions
+		if(!handler_l) { std::abort(); }
+		handler_l();
+		ptr_l = std::malloc(size_p);
+	}
+	if(ptr_l)
+	{
+		octopus::AllocStats::record_allocation(octopus::AllocSource::New, size_p);
+	}
+	return ptr_l;
+}
+
+void *tracked_aligned_malloc(std::size_t size_p, std::align_val_t align_p, bool nothrow_p)
+{
+	std::size_t const align_l = std::size_t(align_p);
+	// aligned_alloc requires a multiple of the alignment
+	std::size_t const size_l = size_p == 0 ? align_l : (size_p + align_l - 1) / align_l * align_l;
+	void *ptr_l = std::aligned_alloc(align_l, size_l);
+	while(!ptr_l && !nothrow_p)
+	{
+		std::new_handler handler_l = std::get_new_handler();
+		if(!handler_l) { std::abort(); }
+		handler_l();
+		ptr_l = std::aligned_alloc(align_l, size_l);
+	}
+	if(ptr_l)
+	{
+		octopus::AllocStats::record_allocation(octopus::AllocSource::New, size_l);
+	}
+	return ptr_l;
+}
+
+void tracked_free(void *ptr_p)
+{
+	if(!ptr_p) { return; }
+	octopus::AllocStats::record_deallocation(octopus::AllocSource::New);
+	std::free(ptr_p);
+}
+
+} // namespace
+
+void *operator new(std::size_t size_p) { return tracked_malloc(size_p, false); }
+void *operator new[](std::size_t size_p) { return tracked_malloc(size_p, false); }
+void *operator new(std::size_t size_p, std::nothrow_t const &) noexcept { return tracked_malloc(size_p, true); }
+void *operator new[](std::size_t size_p, std::nothrow_t const &) noexcept { return tracked_malloc(size_p, true); }
+void *operator new(std::size_t size_p, std::align_val_t align_p) { return tracked_aligned_malloc(size_p, align_p, false); }
+void *operator new[](std::size_t size_p, std::align_val_t align_p) { return tracked_aligned_malloc(size_p, align_p, false); }
+void *operator new(std::size_t size_p, std::align_val_t align_p, std::nothrow_t const &) noexcept { return tracked_aligned_malloc(size_p, align_p, true); }
+void *operator new[](std::size_t size_p, std::align_val_t align_p, std::nothrow_t const &) noexcept { return tracked_aligned_malloc(size_p, align_p, true); }
+
+void operator delete(void *ptr_p) noexcept { tracked_free(ptr_p); }
+void operator delete[](void *ptr_p) noexcept { tracked_free(ptr_p); }
+void operator delete(void *ptr_p, std::size_t) noexcept { tracked_free(ptr_p); }
+void operator delete[](void *ptr_p, std::size_t) noexcept { tracked_free(ptr_p); }
+void operator delete(void *ptr_p, std::nothrow_t const &) noexcept { tracked_free(ptr_p); }
+void operator delete[](void *ptr_p, std::nothrow_t const &) noexcept { tracked_free(ptr_p); }
+void operator delete(void *ptr_p, std::align_val_t) noexcept { tracked_free(ptr_p); }
+void operator delete[](void *ptr_p, std::align_val_t) noexcept { tracked_free(ptr_p); }
+void operator delete(void *ptr_p, std::size_t, std::align_val_t) noexcept { tracked_free(ptr_p); }
+void operator delete[](void *ptr_p, std::size_t, std::align_val_t) noexcept { tracked_free(ptr_p); }
+void operator delete(void *ptr_p, std::align_val_t, std::nothrow_t const &) noexcept { tracked_free(ptr_p); }
+void operator delete[](void *ptr_p, std::align_val_t, std::nothrow_t const &) noexcept { tracked_free(ptr_p); }
+
+#endif
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace octopus
+{
+
+/// @brief allocation counters
+/// bytes are the allocated volume (frees are only counted)
+struct AllocCounters
+{
+	uint64_t allocations = 0;
+	uint64_t deallocations = 0;
+	uint64_t bytes = 0;
+
+	AllocCounters operator-(AllocCounters const &other_p) const
+	{
+		return {allocations - other_p.allocations, deallocations - other_p.deallocations, bytes - other_p.bytes};
+	}
+	AllocCounters &operator+=(AllocCounters const &other_p)
+	{
+		allocations += other_p.allocations;
+		deallocations += other_p.deallocations;
+		bytes += other_p.bytes;
+		return *this;
+	}
+};
+
+/// @brief where the allocation comes from
+enum class AllocSource : uint8_t
+{
+	/// @brief global operator new/delete (octopus, std containers, std::function...)
+	New = 0,
+	/// @brief flecs os api allocator
+	Flecs = 1
+};
+
+/// @brief Allocation accounting
+/// global operator new/delete are replaced when OCTOPUS_ALLOC_TRACKING is defined
+/// and flecs allocations are counted once the flecs os api hooks are installed.
+/// Counters are kept per thread (exact, for the calling thread) and per source
+/// in per thread slots summed on demand (process wide).
+/// Profiler zones record the allocations of their thread.
+class AllocStats
+{
+public:
+	/// @brief true if global operator new is tracked
+	static bool tracks_new();
+
+	/// @brief counters of the calling thread (every source)
+	static AllocCounters thread();
+	/// @brief counters of every thread for the source
+	static AllocCounters total(AllocSource source_p);
+	/// @brief counters of every thread and every source
+	static AllocCounters total();
+
+	static void record_allocation(AllocSource source_p, size_t size_p);
+	static void record_deallocation(AllocSource source_p);
+
+	/// @brief count flecs allocations (must be called once flecs os api is initialized
+	/// ie after the creation of a world since flecs would reset them)
+	static void install_flecs_hooks();
+};
+
+/// @brief count the allocations of every thread in a scope
+/// used to check that a steady state tick does not allocate
+class AllocScope
+{
+public:
+	AllocScope() : _start_new(AllocStats::total(AllocSource::New)), _start_flecs(AllocStats::total(AllocSource::Flecs)) {}
+
+	AllocCounters allocated(AllocSource source_p) const
+	{
+		return AllocStats::total(source_p) - (source_p == AllocSource::New ? _start_new : _start_flecs);
+	}
+	AllocCounters allocated() const
+	{
+		AllocCounters counters_l = allocated(AllocSource::New);
+		counters_l += allocated(AllocSource::Flecs);
+		return counters_l;
+	}
+private:
+	AllocCounters const _start_new;
+	AllocCounters const _start_flecs;
+};
+
+} // namespace octopus
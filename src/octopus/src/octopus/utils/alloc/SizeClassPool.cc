@@ -0,0 +1,67 @@
+#include "SizeClassPool.hh"
+
+#include <new>
+
+namespace octopus
+{
+
+SizeClassPool::~SizeClassPool()
+{
+	for(void *chunk_l : _chunks)
+	{
+		::operator delete(chunk_l);
+	}
+}
+
+void *SizeClassPool::allocate(size_t size_p)
+{
+	if(size_p == 0) { size_p = 1; }
+	if(size_p > max_size)
+	{
+		return ::operator new(size_p);
+	}
+	size_t const class_l = class_idx(size_p);
+	if(!_free[class_l])
+	{
+		refill(class_l);
+	}
+	Block *block_l = _free[class_l];
+	_free[class_l] = block_l->next;
+	return block_l;
+}
+
+void SizeClassPool::deallocate(void *ptr_p, size_t size_p)
+{
+	if(!ptr_p) { return; }
+	if(size_p == 0) { size_p = 1; }
+	if(size_p > max_size)
+	{
+		::operator delete(ptr_p);
+		return;
+	}
+	size_t const class_l = class_idx(size_p);
+	Block *block_l = static_cast<Block *>(ptr_p);
+	block_l->next = _free[class_l];
+	_free[class_l] = block_l;
+}
+
+void SizeClassPool::refill(size_t class_p)
+{
+	size_t const block_size_l = (class_p + 1) * granularity;
+	char *chunk_l = static_cast<char *>(::operator new(chunk_size));
+	_chunks.push_back(chunk_l);
+	for(size_t offset_l = 0 ; offset_l + block_size_l <= chunk_size ; offset_l += block_size_l)
+	{
+		Block *block_l = reinterpret_cast<Block *>(chunk_l + offset_l);
+		block_l->next = _free[class_p];
+		_free[class_p] = block_l;
+	}
+}
+
+SizeClassPool &thread_size_class_pool()
+{
+	thread_local SizeClassPool pool_l;
+	return pool_l;
+}
+
+} // namespace octopus
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace octopus
+{
+
+/// @brief free lists of blocks by size class
+/// blocks up to max_size bytes are taken from chunks and recycled on deallocation,
+/// bigger ones are forwarded to operator new. Chunks are released with the pool.
+/// @note not thread safe
+class SizeClassPool
+{
+public:
+	static constexpr size_t granularity = 16;
+	static constexpr size_t max_size = 256;
+	static constexpr size_t classes = max_size / granularity;
+	static constexpr size_t chunk_size = 16384;
+
+	SizeClassPool() = default;
+	~SizeClassPool();
+	SizeClassPool(SizeClassPool const &) = delete;
+	SizeClassPool &operator=(SizeClassPool const &) = delete;
+
+	void *allocate(size_t size_p);
+	void deallocate(void *ptr_p, size_t size_p);
+
+	/// @brief number of chunks allocated
+	size_t chunks() const { return _chunks.size(); }
+
+private:
+	struct Block
+	{
+		Block *next;
+	};
+
+	static size_t class_idx(size_t size_p) { return (size_p + granularity - 1) / granularity - 1; }
+
+	/// @brief split a new chunk in blocks of the class
+	void refill(size_t class_p);
+
+	std::array<Block *, classes> _free {};
+	std::vector<void *> _chunks;
+};
+
+/// @brief pool of the calling thread (released when the thread exits)
+SizeClassPool &thread_size_class_pool();
+
+/// @brief std allocator taking its memory from the pool of the calling thread
+/// to plug in std containers of hot paths (set, list, map nodes)
+/// @note the container must be created, used and destroyed by the same thread
+template<typename T>
+struct PoolAllocator
+{
+	static_assert(alignof(T) <= SizeClassPool::granularity, "PoolAllocator blocks are aligned on 16 bytes");
+
+	using value_type = T;
+
+	PoolAllocator() = default;
+	template<typename U>
+	PoolAllocator(PoolAllocator<U> const &) {}
+
+	T *allocate(size_t n)
+	{
+		return static_cast<T *>(thread_size_class_pool().allocate(n * sizeof(T)));
+	}
+
+	void deallocate(T *ptr_p, size_t n)
+	{
+		thread_size_class_pool().deallocate(ptr_p, n * sizeof(T));
+	}
+
+	template<typename U>
+	bool operator==(PoolAllocator<U> const &) const { return true; }
+	template<typename U>
+	bool operator!=(PoolAllocator<U> const &) const { return false; }
+};
+
+} // namespace octopus
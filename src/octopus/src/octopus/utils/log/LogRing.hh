@@ -0,0 +1,100 @@
+#ifndef __LOG_RING__
+#define __LOG_RING__
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace octopus
+{
+
+	/// @brief lock free single producer single consumer ring of variable size records
+	/// each entry is [entry size][record size][record] aligned on 8 bytes,
+	/// a padding entry is written when a record does not fit before the end
+	/// so that records are always contiguous
+	class LogRing
+	{
+	public:
+		/// @param capacity_p in bytes, must be a power of two
+		explicit LogRing(uint32_t capacity_p)
+			: _capacity(capacity_p), _data(new char[capacity_p]) {}
+
+		/// @brief producer side : copy a record in the ring
+		/// @return false if there is not enough room (the record is dropped)
+		bool push(char const *record_p, uint32_t size_p)
+		{
+			uint32_t const entry_l = align(header_size + size_p);
+			uint64_t head_l = _head.load(std::memory_order_relaxed);
+			uint64_t const tail_l = _tail.load(std::memory_order_acquire);
+			uint32_t pos_l = uint32_t(head_l & (_capacity - 1));
+			uint32_t const to_end_l = _capacity - pos_l;
+			uint32_t const padding_l = to_end_l < entry_l ? to_end_l : 0;
+			if(entry_l > _capacity || head_l + padding_l + entry_l - tail_l > _capacity)
+			{
+				_dropped.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+			if(padding_l > 0)
+			{
+				uint32_t const marker_l = padding_l | padding_flag;
+				std::memcpy(&_data[pos_l], &marker_l, sizeof(uint32_t));
+				head_l += padding_l;
+				pos_l = 0;
+			}
+			uint32_t const header_l[2] = {entry_l, size_p};
+			std::memcpy(&_data[pos_l], header_l, header_size);
+			std::memcpy(&_data[pos_l + header_size], record_p, size_p);
+			_head.store(head_l + entry_l, std::memory_order_release);
+			return true;
+		}
+
+		/// @brief consumer side : call func_p(record, size) on every available record
+		/// @note the record is only valid during the call
+		/// @return the number of records consumed
+		template<typename Func>
+		size_t drain(Func &&func_p)
+		{
+			uint64_t tail_l = _tail.load(std::memory_order_relaxed);
+			uint64_t const head_l = _head.load(std::memory_order_acquire);
+			size_t count_l = 0;
+			while(tail_l < head_l)
+			{
+				uint32_t const pos_l = uint32_t(tail_l & (_capacity - 1));
+				uint32_t header_l[2];
+				std::memcpy(header_l, &_data[pos_l], sizeof(uint32_t));
+				if(header_l[0] & padding_flag)
+				{
+					tail_l += header_l[0] & ~padding_flag;
+					continue;
+				}
+				std::memcpy(header_l, &_data[pos_l], header_size);
+				func_p(&_data[pos_l + header_size], header_l[1]);
+				tail_l += header_l[0];
+				++count_l;
+			}
+			_tail.store(tail_l, std::memory_order_release);
+			return count_l;
+		}
+
+		/// @brief number of records dropped because the ring was full
+		uint64_t dropped() const { return _dropped.load(std::memory_order_relaxed); }
+
+	private:
+		static constexpr uint32_t header_size = 2 * sizeof(uint32_t);
+		static constexpr uint32_t padding_flag = uint32_t(1) << 31;
+
+		static uint32_t align(uint32_t size_p) { return (size_p + 7) & ~uint32_t(7); }
+
+		uint32_t const _capacity;
+		std::unique_ptr<char[]> const _data;
+		/// @brief bytes written (producer)
+		std::atomic<uint64_t> _head {0};
+		/// @brief bytes consumed (consumer)
+		std::atomic<uint64_t> _tail {0};
+		std::atomic<uint64_t> _dropped {0};
+	};
+
+}
+
+#endif
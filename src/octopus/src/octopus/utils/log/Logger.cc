@@ -1,38 +1,391 @@
 #include "Logger.hh"
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "LogRing.hh"
+
 namespace octopus
 {
-bool Logger::_debug = false;
-std::mutex Logger::_mutex;
-std::ofstream Logger::_logFile = std::ofstream("octopus.log");
+std::atomic<bool> Logger::_debug {false};
+
+namespace
+{
+
+/// @brief bytes of the ring of every thread logging
+constexpr uint32_t log_ring_capacity = uint32_t(1) << 20;
+/// @brief the writer thread wakes up at least this often
+constexpr std::chrono::milliseconds log_writer_period(2);
+
+/// @brief record header : sequence number (global order) and level
+constexpr size_t log_record_header = sizeof(uint64_t) + sizeof(LogLevel);
+
+struct LogThreadRing
+{
+	LogThreadRing() : ring(log_ring_capacity) {}
+	LogRing ring;
+	/// @brief set when the thread exits, the ring is released once drained
+	std::atomic<bool> retired {false};
+};
+
+/// @brief owns the rings and the writer thread
+class LogBackend
+{
+public:
+	static LogBackend &get()
+	{
+		static LogBackend backend_l;
+		return backend_l;
+	}
+
+	LogBackend() : _writer([this]() { run(); }) {}
+
+	~LogBackend()
+	{
+		{
+			std::lock_guard<std::mutex> lock_l(_mutex);
+			_stop = true;
+		}
+		_cv.notify_all();
+		_writer.join();
+	}
+
+	std::shared_ptr<LogThreadRing> register_ring()
+	{
+		std::shared_ptr<LogThreadRing> ring_l = std::make_shared<LogThreadRing>();
+		std::lock_guard<std::mutex> lock_l(_rings_mutex);
+		_rings.push_back(ring_l);
+		return ring_l;
+	}
+
+	uint64_t next_sequence() { return _sequence.fetch_add(1, std::memory_order_relaxed); }
+
+	void flush()
+	{
+		std::unique_lock<std::mutex> lock_l(_mutex);
+		uint64_t const request_l = ++_flush_requested;
+		_cv.notify_all();
+		_flushed_cv.wait(lock_l, [this, request_l]() { return _flush_done >= request_l; });
+	}
+
+	void redirect(std::ostream *os_p)
+	{
+		flush();
+		std::lock_guard<std::mutex> lock_l(_output_mutex);
+		_redirect = os_p;
+	}
+
+	uint64_t dropped()
+	{
+		std::lock_guard<std::mutex> lock_l(_rings_mutex);
+		return _dropped_retired + count_dropped();
+	}
+
+private:
+	struct RecordRef
+	{
+		uint64_t sequence;
+		size_t offset;
+		size_t size;
+	};
+
+	void run()
+	{
+		std::unique_lock<std::mutex> lock_l(_mutex);
+		while(true)
+		{
+			_cv.wait_for(lock_l, log_writer_period, [this]() { return _stop || _flush_requested > _flush_done; });
+			bool const stop_l = _stop;
+			uint64_t const request_l = _flush_requested;
+			lock_l.unlock();
+
+			write(drain());
+
+			lock_l.lock();
+			_flush_done = request_l;
+			_flushed_cv.notify_all();
+			if(stop_l) { break; }
+		}
+	}
+
+	/// @brief move every record of every ring in _batch
+	std::vector<RecordRef> drain()
+	{
+		_batch.clear();
+		std::vector<RecordRef> records_l;
+		std::lock_guard<std::mutex> lock_l(_rings_mutex);
+		for(size_t i = 0 ; i < _rings.size() ; )
+		{
+			// no push after retirement so the ring is empty once drained
+			bool const retired_l = _rings[i]->retired.load(std::memory_order_acquire);
+			_rings[i]->ring.drain([this, &records_l](char const *record_p, uint32_t size_p) {
+				uint64_t sequence_l;
+				std::memcpy(&sequence_l, record_p, sizeof(sequence_l));
+				records_l.push_back({sequence_l, _batch.size(), size_p});
+				_batch.insert(_batch.end(), record_p, record_p + size_p);
+			});
+			if(retired_l)
+			{
+				_dropped_retired += _rings[i]->ring.dropped();
+				_rings[i] = _rings.back();
+				_rings.pop_back();
+				continue;
+			}
+			++i;
+		}
+		std::sort(records_l.begin(), records_l.end(), [](RecordRef const &a, RecordRef const &b) {
+			return a.sequence < b.sequence;
+		});
+		uint64_t const dropped_l = _dropped_retired + count_dropped();
+		if(dropped_l > _dropped_reported)
+		{
+			_dropped_to_report = dropped_l - _dropped_reported;
+			_dropped_reported = dropped_l;
+		}
+		return records_l;
+	}
+
+	uint64_t count_dropped() const
+	{
+		uint64_t dropped_l = 0;
+		for(std::shared_ptr<LogThreadRing> const &ring_l : _rings)
+		{
+			dropped_l += ring_l->ring.dropped();
+		}
+		return dropped_l;
+	}
+
+	void decode(std::ostream &os_p, char const *record_p, size_t size_p)
+	{
+		LogManipulator const endl_l = std::endl<char, std::char_traits<char> >;
+		LogManipulator const flush_l = std::flush<char, std::char_traits<char> >;
+		char const *cur_l = record_p + log_record_header;
+		char const *end_l = record_p + size_p;
+		while(cur_l < end_l)
+		{
+			LogArg arg_l;
+			std::memcpy(&arg_l, cur_l, sizeof(arg_l));
+			cur_l += sizeof(arg_l);
+			if(arg_l == LogArg::Literal)
+			{
+				char const *str_l;
+				std::memcpy(&str_l, cur_l, sizeof(str_l));
+				cur_l += sizeof(str_l);
+				os_p << str_l;
+			}
+			else if(arg_l == LogArg::String)
+			{
+				uint32_t length_l;
+				std::memcpy(&length_l, cur_l, sizeof(length_l));
+				cur_l += sizeof(length_l);
+				os_p.write(cur_l, length_l);
+				cur_l += length_l;
+			}
+			else if(arg_l == LogArg::Binary)
+			{
+				LogPrinter printer_l;
+				uint32_t length_l;
+				std::memcpy(&printer_l, cur_l, sizeof(printer_l));
+				cur_l += sizeof(printer_l);
+				std::memcpy(&length_l, cur_l, sizeof(length_l));
+				cur_l += sizeof(length_l);
+				printer_l(os_p, cur_l);
+				cur_l += length_l;
+			}
+			else if(arg_l == LogArg::FormatManipulator)
+			{
+				LogFormatManipulator manipulator_l;
+				std::memcpy(&manipulator_l, cur_l, sizeof(manipulator_l));
+				cur_l += sizeof(manipulator_l);
+				manipulator_l(os_p);
+			}
+			else
+			{
+				LogManipulator manipulator_l;
+				std::memcpy(&manipulator_l, cur_l, sizeof(manipulator_l));
+				cur_l += sizeof(manipulator_l);
+				// streams are flushed once per batch
+				if(manipulator_l == endl_l) { os_p << '\n'; }
+				else if(manipulator_l != flush_l) { manipulator_l(os_p); }
+			}
+		}
+	}
+
+	void write(std::vector<RecordRef> const &records_p)
+	{
+		if(records_p.empty() && _dropped_to_report == 0) { return; }
+		_text.str(std::string());
+		for(RecordRef const &record_l : records_p)
+		{
+			// manipulators must not leak from one record to the other
+			_text.flags(std::ios_base::fmtflags());
+			_text.precision(6);
+			_text.fill(' ');
+			decode(_text, &_batch[record_l.offset], record_l.size);
+		}
+		if(_dropped_to_report > 0)
+		{
+			_text << "Logger :: " << _dropped_to_report << " records dropped (ring full)\n";
+			_dropped_to_report = 0;
+		}
+		std::string const text_l = _text.str();
+
+		std::lock_guard<std::mutex> lock_l(_output_mutex);
+		if(_redirect)
+		{
+			*_redirect << text_l << std::flush;
+			return;
+		}
+		if(!_file.is_open())
+		{
+			_file.open("octopus.log");
+		}
+		std::cout << text_l << std::flush;
+		_file << text_l << std::flush;
+	}
+
+	std::mutex _rings_mutex;
+	std::vector<std::shared_ptr<LogThreadRing> > _rings;
+	uint64_t _dropped_retired = 0;
+	uint64_t _dropped_reported = 0;
+	uint64_t _dropped_to_report = 0;
+
+	std::atomic<uint64_t> _sequence {0};
+
+	/// @brief writer thread only
+	std::vector<char> _batch;
+	std::ostringstream _text;
+
+	/// @brief protects the outputs
+	std::mutex _output_mutex;
+	std::ofstream _file;
+	std::ostream *_redirect = nullptr;
+
+	/// @brief protects stop and flush
+	std::mutex _mutex;
+	std::condition_variable _cv;
+	std::condition_variable _flushed_cv;
+	bool _stop = false;
+	uint64_t _flush_requested = 0;
+	uint64_t _flush_done = 0;
+
+	/// @brief must be last to start once every member is initialized
+	std::thread _writer;
+};
+
+/// @brief ring of the thread, retired when the thread exits
+struct LogThreadHandle
+{
+	~LogThreadHandle()
+	{
+		if(ring) { ring->retired.store(true, std::memory_order_release); }
+	}
+	std::shared_ptr<LogThreadRing> ring;
+};
 
+thread_local LogThreadHandle log_thread_handle;
 
-LoggerHandler::LoggerHandler(std::mutex &mutex_p, std::ofstream &logFile_p, bool shouldLog_p) : _mutex(mutex_p), _logFile(logFile_p), _shouldLog(shouldLog_p) {}
-LoggerHandler::LoggerHandler(LoggerHandler const &other_p) : _mutex(other_p._mutex), _logFile(other_p._logFile), _shouldLog(other_p._shouldLog) {}
+/// @brief scratch buffer reused by the records of the thread
+struct LogScratch
+{
+	std::string buffer;
+	bool used = false;
+};
 
-LoggerHandler::~LoggerHandler()
+thread_local LogScratch log_scratch;
+
+} // namespace
+
+LogRecord::LogRecord(LogLevel level_p) : _active(Logger::is_enabled(level_p)), _level(level_p)
 {
-	if(_shouldLog)
+	if(!_active) { return; }
+	if(log_scratch.used)
 	{
-		std::lock_guard<std::mutex> lock_l(_mutex);
-		std::cout<<this->str()<<std::flush;
-		_logFile<<this->str()<<std::flush;
+		// record built while formatting another one
+		_buffer = &_own;
 	}
+	else
+	{
+		log_scratch.used = true;
+		_buffer = &log_scratch.buffer;
+		_buffer->clear();
+	}
+	// sequence is set on commit
+	_buffer->resize(log_record_header);
+	std::memcpy(&(*_buffer)[sizeof(uint64_t)], &_level, sizeof(_level));
 }
 
-LoggerHandler Logger::getNormal()
+LogRecord::~LogRecord()
 {
-	return LoggerHandler(_mutex, _logFile, true);
+	if(!_active) { return; }
+	LogBackend &backend_l = LogBackend::get();
+	if(!log_thread_handle.ring)
+	{
+		log_thread_handle.ring = backend_l.register_ring();
+	}
+	uint64_t const sequence_l = backend_l.next_sequence();
+	std::memcpy(&(*_buffer)[0], &sequence_l, sizeof(sequence_l));
+	log_thread_handle.ring->ring.push(_buffer->data(), uint32_t(_buffer->size()));
+	if(_buffer != &_own)
+	{
+		log_scratch.used = false;
+	}
 }
 
-DebugLoggerHandler Logger::getDebug()
+LogRecord &LogRecord::operator<<(LogManipulator manipulator_p)
 {
-	return DebugLoggerHandler(_mutex, _logFile, _debug);
+	if(!_active) { return *this; }
+	append(LogArg::Manipulator);
+	append_bytes(&manipulator_p, sizeof(manipulator_p));
+	return *this;
 }
 
+LogRecord &LogRecord::operator<<(LogFormatManipulator manipulator_p)
+{
+	if(!_active) { return *this; }
+	append(LogArg::FormatManipulator);
+	append_bytes(&manipulator_p, sizeof(manipulator_p));
+	return *this;
 }
 
-octopus::LoggerVoider operator<<(octopus::LoggerVoider voider_p, std::ostream& (*pf)(std::ostream&))
+void LogRecord::append_bytes(void const *data_p, size_t size_p)
 {
-	return voider_p;
+	_buffer->append(static_cast<char const *>(data_p), size_p);
+}
+
+void LogRecord::append_string(char const *str_p)
+{
+	if(!str_p) { str_p = "(null)"; }
+	append_string(str_p, uint32_t(std::strlen(str_p)));
+}
+
+void LogRecord::append_string(char const *str_p, uint32_t size_p)
+{
+	append(LogArg::String);
+	append_bytes(&size_p, sizeof(size_p));
+	append_bytes(str_p, size_p);
+}
+
+void Logger::flush()
+{
+	LogBackend::get().flush();
+}
+
+void Logger::redirect(std::ostream *os_p)
+{
+	LogBackend::get().redirect(os_p);
+}
+
+uint64_t Logger::dropped()
+{
+	return LogBackend::get().dropped();
+}
+
 }
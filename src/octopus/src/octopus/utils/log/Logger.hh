@@ -1,65 +1,179 @@
 #ifndef __LOGGER__
 #define __LOGGER__
 
-#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
 #include <sstream>
-#include <iostream>
-#include <fstream>
+#include <string>
+#include <type_traits>
+
+#include "octopus/utils/FixedPoint.hh"
+#include "octopus/utils/Vector.hh"
+
+/// @brief lowest log level compiled in (0 debug, 1 normal, 2 none)
+/// statements of a lower level are removed at compile time
+/// and their arguments are never evaluated
+#ifndef OCTOPUS_LOG_LEVEL
+#define OCTOPUS_LOG_LEVEL 1
+#endif
 
 namespace octopus
 {
 
-	/// @brief Logger handler used to log
-	/// it handles mutex
-	class LoggerHandler : public std::ostringstream
+	enum class LogLevel : uint8_t
 	{
-	public:
-		explicit LoggerHandler(std::mutex &mutex_p, std::ofstream &logFile_p, bool shouldLog_p);
-		LoggerHandler(LoggerHandler const &other_p);
+		Debug = 0,
+		Normal = 1
+	};
 
-		~LoggerHandler();
+	/// @brief types copied as raw bytes in the records and formatted by the writer thread
+	/// other types are formatted when logged
+	template<typename T>
+	struct LogBinary : std::integral_constant<bool, std::is_arithmetic<T>::value || std::is_enum<T>::value> {};
+	template<int64_t e>
+	struct LogBinary<FixedPoint<e> > : std::true_type {};
+	template<>
+	struct LogBinary<Vector> : std::true_type {};
 
-	private:
-		std::mutex &_mutex;
-		bool _shouldLog;
-		std::ofstream &_logFile;
+	/// @brief tag of every argument of a record
+	enum class LogArg : uint8_t
+	{
+		/// @brief pointer to a string literal
+		Literal,
+		/// @brief copied string
+		String,
+		/// @brief printer + raw bytes
+		Binary,
+		/// @brief stream manipulator (std::endl...)
+		Manipulator,
+		/// @brief format manipulator (std::hex...)
+		FormatManipulator
 	};
 
-	class LoggerVoider {
+	using LogPrinter = void (*)(std::ostream &, char const *);
+	using LogManipulator = std::ostream &(*)(std::ostream &);
+	using LogFormatManipulator = std::ios_base &(*)(std::ios_base &);
+
+	template<typename T>
+	void log_print(std::ostream &os_p, char const *data_p)
+	{
+		T value_l;
+		std::memcpy(static_cast<void *>(&value_l), data_p, sizeof(T));
+		os_p << value_l;
+	}
+
+	/// @brief one log statement, arguments are encoded in a binary record
+	/// pushed in the ring of the calling thread on destruction
+	/// and written by the logger thread
+	class LogRecord
+	{
 	public:
-		explicit LoggerVoider(std::mutex &, std::ofstream &, bool) {}
-		LoggerVoider(LoggerVoider const &) {}
-	};
+		explicit LogRecord(LogLevel level_p);
+		~LogRecord();
 
-	/// @brief use this if you want to be able to switch from debug to normal without rebuilding (slower at execution)
-	// typedef LoggerHandler DebugLoggerHandler;
+		LogRecord(LogRecord const &) = delete;
+		LogRecord &operator=(LogRecord const &) = delete;
 
-	/// @brief use this if you want fastest execution (but debug log wont be possible)
-	typedef LoggerVoider DebugLoggerHandler;
+		template<typename T>
+		LogRecord &operator<<(T &&arg_p)
+		{
+			if(!_active) { return *this; }
+			using type_t = std::remove_cv_t<std::remove_reference_t<T> >;
+			using elem_t = std::remove_extent_t<std::remove_reference_t<T> >;
+			if constexpr (std::is_array<type_t>::value && std::is_same<elem_t, char const>::value)
+			{
+				// char const arrays are string literals
+				char const *str_l = arg_p;
+				append(LogArg::Literal);
+				append_bytes(&str_l, sizeof(str_l));
+			}
+			else if constexpr (std::is_convertible<type_t, char const *>::value)
+			{
+				// char arrays, pointers and flecs strings
+				append_string(static_cast<char const *>(arg_p));
+			}
+			else if constexpr (std::is_same<type_t, std::string>::value)
+			{
+				append_string(arg_p.c_str(), uint32_t(arg_p.size()));
+			}
+			else if constexpr (LogBinary<type_t>::value && std::is_trivially_copyable<type_t>::value)
+			{
+				LogPrinter printer_l = &log_print<type_t>;
+				uint32_t const size_l = sizeof(type_t);
+				append(LogArg::Binary);
+				append_bytes(&printer_l, sizeof(printer_l));
+				append_bytes(&size_l, sizeof(size_l));
+				append_bytes(&arg_p, sizeof(type_t));
+			}
+			else
+			{
+				// formatted now since the argument may not be valid later
+				std::ostringstream oss_l;
+				oss_l << arg_p;
+				std::string const str_l = oss_l.str();
+				append_string(str_l.c_str(), uint32_t(str_l.size()));
+			}
+			return *this;
+		}
 
+		/// @brief to handle std::endl
+		LogRecord &operator<<(LogManipulator manipulator_p);
+		/// @brief to handle std::hex
+		LogRecord &operator<<(LogFormatManipulator manipulator_p);
+
+	private:
+		void append(LogArg arg_p) { append_bytes(&arg_p, sizeof(arg_p)); }
+		void append_bytes(void const *data_p, size_t size_p);
+		void append_string(char const *str_p);
+		void append_string(char const *str_p, uint32_t size_p);
+
+		bool const _active;
+		LogLevel const _level;
+		/// @brief thread scratch buffer (or _own when the scratch is already in use)
+		std::string *_buffer = nullptr;
+		std::string _own;
+	};
+
+	/// @brief Asynchronous logger
+	/// every thread logs binary records in its own lock free ring,
+	/// records are formatted and written to std::cout and octopus.log
+	/// by a background thread
+	/// @note use the OCTOPUS_LOG_DEBUG and OCTOPUS_LOG_NORMAL macros
+	/// so that arguments are not evaluated when the level is disabled
 	class Logger
 	{
 	public:
-		static LoggerHandler getNormal();
-		static DebugLoggerHandler getDebug();
+		static LogRecord getNormal() { return LogRecord(LogLevel::Normal); }
+		static LogRecord getDebug() { return LogRecord(LogLevel::Debug); }
+
+		static bool is_enabled(LogLevel level_p)
+		{
+			return int(level_p) >= OCTOPUS_LOG_LEVEL
+				&& (level_p != LogLevel::Debug || _debug.load(std::memory_order_relaxed));
+		}
 
-		static void enable_debug() { _debug = true; }
-		static void disable_debug() { _debug = false; }
+		static void enable_debug() { _debug.store(true, std::memory_order_relaxed); }
+		static void disable_debug() { _debug.store(false, std::memory_order_relaxed); }
+
+		/// @brief wait for every record logged before the call to be written
+		static void flush();
+
+		/// @brief write the records to os_p instead of std::cout and octopus.log
+		/// @param os_p nullptr to restore the default outputs
+		static void redirect(std::ostream *os_p);
+
+		/// @brief number of records dropped because a ring was full
+		static uint64_t dropped();
 
 	private:
-		static bool _debug;
-		static std::mutex _mutex;
-		static std::ofstream _logFile;
+		static std::atomic<bool> _debug;
 	};
 }
 
-template<typename T>
-octopus::LoggerVoider operator<<(octopus::LoggerVoider voider_p, T)
-{
-	return voider_p;
-}
-
-// to handle std::endl
-octopus::LoggerVoider operator<<(octopus::LoggerVoider voider_p, std::ostream& (*pf)(std::ostream&));
+#define OCTOPUS_LOG(level) if(!octopus::Logger::is_enabled(level)) {} else octopus::LogRecord(level)
+#define OCTOPUS_LOG_DEBUG OCTOPUS_LOG(octopus::LogLevel::Debug)
+#define OCTOPUS_LOG_NORMAL OCTOPUS_LOG(octopus::LogLevel::Normal)
 
 #endif
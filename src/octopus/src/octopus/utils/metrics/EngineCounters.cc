@@ -0,0 +1,53 @@
+#include "EngineCounters.hh"
+
+#include <atomic>
+
+namespace octopus
+{
+
+namespace
+{
+
+constexpr size_t counters = size_t(EngineCounter::Count);
+/// @brief threads share a slot when there are more threads than slots
+constexpr uint32_t counter_slots = 64;
+
+/// @brief counters of the threads of the slot (one cache line per slot)
+struct alignas(64) CounterSlot
+{
+	std::atomic<uint64_t> values[counters];
+};
+
+// zero initialized (static storage)
+CounterSlot slots[counter_slots];
+std::atomic<uint32_t> next_slot {0};
+
+thread_local uint32_t thread_slot = counter_slots;
+
+CounterSlot &get_slot()
+{
+	if(thread_slot == counter_slots)
+	{
+		thread_slot = next_slot.fetch_add(1, std::memory_order_relaxed) % counter_slots;
+	}
+	return slots[thread_slot];
+}
+
+} // namespace
+
+void EngineCounters::add(EngineCounter counter_p, uint64_t value_p)
+{
+	get_slot().values[size_t(counter_p)].fetch_add(value_p, std::memory_order_relaxed);
+}
+
+uint64_t EngineCounters::total(EngineCounter counter_p)
+{
+	uint64_t total_l = 0;
+	for(CounterSlot const &slot_l : slots)
+	{
+		total_l += slot_l.values[size_t(counter_p)].load(std::memory_order_relaxed);
+	}
+	return total_l;
+}
+
+} // namespace octopus
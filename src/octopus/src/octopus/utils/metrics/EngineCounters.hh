@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+
+namespace octopus
+{
+
+/// @brief internal counters of the engine
+enum class EngineCounter : uint8_t
+{
+	/// @brief queries of the position trees
+	SpatialQueries = 0,
+	/// @brief leaves added to the position trees
+	TreeInserts,
+	/// @brief leaves moved out of their box and reinserted
+	TreeReinserts,
+	/// @brief leaves still in their box (no tree update)
+	TreeKept,
+	/// @brief path requests queued in the PathFindingCache
+	PathRequests,
+	Count
+};
+
+/// @brief Process wide counters incremented from any thread
+/// Counters are kept in per thread slots (relaxed atomics, one cache line
+/// per slot) and summed on demand, they are never reset : readers compute
+/// the difference between two totals (see EngineMetricsCollector)
+class EngineCounters
+{
+public:
+	static void add(EngineCounter counter_p, uint64_t value_p=1);
+	/// @brief sum of every thread
+	static uint64_t total(EngineCounter counter_p);
+};
+
+} // namespace octopus
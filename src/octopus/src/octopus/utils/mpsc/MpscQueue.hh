@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+namespace octopus
+{
+
+/// @brief Lock free multiple producers single consumer queue
+/// producers push on an intrusive stack with a compare and swap,
+/// the consumer takes the whole stack at once and reverses it
+/// so that contents are drained in push order
+/// @note only one thread may drain at a time
+template<typename content_t>
+struct MpscQueue
+{
+	MpscQueue() = default;
+	MpscQueue(MpscQueue const &) = delete;
+	MpscQueue &operator=(MpscQueue const &) = delete;
+
+	~MpscQueue()
+	{
+		free_nodes(head.exchange(nullptr));
+	}
+
+	void push(content_t &&content_p)
+	{
+		Node *node_l = new Node{std::move(content_p), head.load(std::memory_order_relaxed)};
+		while(!head.compare_exchange_weak(node_l->next, node_l, std::memory_order_release, std::memory_order_relaxed)) {}
+	}
+
+	void push(content_t const &content_p)
+	{
+		push(content_t(content_p));
+	}
+
+	/// @brief append all pushed contents to the vector in push order
+	void drain(std::vector<content_t> &out_p)
+	{
+		Node *node_l = head.exchange(nullptr, std::memory_order_acquire);
+		// reverse the stack to get the push order
+		Node *reversed_l = nullptr;
+		while(node_l)
+		{
+			Node *next_l = node_l->next;
+			node_l->next = reversed_l;
+			reversed_l = node_l;
+			node_l = next_l;
+		}
+		while(reversed_l)
+		{
+			out_p.push_back(std::move(reversed_l->content));
+			Node *next_l = reversed_l->next;
+			delete reversed_l;
+			reversed_l = next_l;
+		}
+	}
+
+	bool empty() const { return head.load(std::memory_order_acquire) == nullptr; }
+
+private:
+	struct Node
+	{
+		content_t content;
+		Node *next = nullptr;
+	};
+
+	static void free_nodes(Node *node_p)
+	{
+		while(node_p)
+		{
+			Node *next_l = node_p->next;
+			delete node_p;
+			node_p = next_l;
+		}
+	}
+
+	std::atomic<Node *> head {nullptr};
+};
+
+} // namespace octopus
@@ -0,0 +1,181 @@
+#include "CostAttribution.hh"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace octopus
+{
+
+namespace
+{
+
+thread_local CostThreadBuffer *local_cost_buffer = nullptr;
+
+bool more_expensive(EntityCost const &a_p, EntityCost const &b_p)
+{
+	if(a_p.ns != b_p.ns)
+	{
+		return a_p.ns > b_p.ns;
+	}
+	// deterministic order for equal costs
+	return a_p.entity < b_p.entity;
+}
+
+/// @brief keep the k most expensive costs sorted
+void keep_top(std::vector<EntityCost> &costs_p, size_t k_p)
+{
+	size_t const size_l = std::min(k_p, costs_p.size());
+	std::partial_sort(costs_p.begin(), costs_p.begin() + size_l, costs_p.end(), more_expensive);
+	costs_p.resize(size_l);
+}
+
+char const *or_none(char const *name_p)
+{
+	return name_p ? name_p : "none";
+}
+
+} // namespace
+
+CostAttribution &CostAttribution::get()
+{
+	static CostAttribution attribution_l;
+	return attribution_l;
+}
+
+void CostAttribution::enable(uint32_t period_p, size_t top_k_p)
+{
+	_enabled = true;
+	_period = std::max<uint32_t>(1, period_p);
+	_top_k = top_k_p;
+	_tick = 0;
+	_sampling.store(true, std::memory_order_relaxed);
+}
+
+void CostAttribution::disable()
+{
+	_enabled = false;
+	_sampling.store(false, std::memory_order_relaxed);
+}
+
+CostThreadBuffer &CostAttribution::thread_buffer()
+{
+	// registered once per thread
+	if(!local_cost_buffer)
+	{
+		std::lock_guard<std::mutex> lock_l(_buffers_mutex);
+		_buffers.push_back(std::make_unique<CostThreadBuffer>());
+		_buffers.back()->samples.reserve(1024);
+		local_cost_buffer = _buffers.back().get();
+	}
+	return *local_cost_buffer;
+}
+
+void CostAttribution::record(EntityCost const &cost_p)
+{
+	thread_buffer().samples.push_back(cost_p);
+}
+
+void CostAttribution::collect()
+{
+	std::lock_guard<std::mutex> lock_l(_buffers_mutex);
+
+	if(_sampling.load(std::memory_order_relaxed))
+	{
+		// merge the runs of an entity in a system
+		std::unordered_map<uint64_t, std::vector<EntityCost> > merged_l;
+		for(std::unique_ptr<CostThreadBuffer> &buffer_l : _buffers)
+		{
+			for(EntityCost const &sample_l : buffer_l->samples)
+			{
+				CommandCost &command_l = _commands[{sample_l.system, or_none(sample_l.command)}];
+				command_l.ns += sample_l.ns;
+				command_l.steps += sample_l.steps;
+				command_l.calls += sample_l.calls;
+
+				std::vector<EntityCost> &costs_l = merged_l[sample_l.entity];
+				auto it_l = std::find_if(costs_l.begin(), costs_l.end(), [&sample_l](EntityCost const &cost_p) {
+					return cost_p.system == sample_l.system && cost_p.command == sample_l.command;
+				});
+				if(it_l == costs_l.end())
+				{
+					costs_l.push_back(sample_l);
+					costs_l.back().tick = _tick;
+				}
+				else
+				{
+					it_l->ns += sample_l.ns;
+					it_l->steps += sample_l.steps;
+					it_l->calls += sample_l.calls;
+				}
+			}
+		}
+
+		_last_top.clear();
+		for(auto &&pair_l : merged_l)
+		{
+			_last_top.insert(_last_top.end(), pair_l.second.begin(), pair_l.second.end());
+		}
+		keep_top(_last_top, _top_k);
+
+		_worst.insert(_worst.end(), _last_top.begin(), _last_top.end());
+		keep_top(_worst, _top_k);
+		++_sampled_ticks;
+	}
+
+	for(std::unique_ptr<CostThreadBuffer> &buffer_l : _buffers)
+	{
+		buffer_l->samples.clear();
+	}
+
+	++_tick;
+	_sampling.store(_enabled && _tick % _period == 0, std::memory_order_relaxed);
+}
+
+void CostAttribution::reset()
+{
+	std::lock_guard<std::mutex> lock_l(_buffers_mutex);
+	for(std::unique_ptr<CostThreadBuffer> &buffer_l : _buffers)
+	{
+		buffer_l->samples.clear();
+	}
+	_last_top.clear();
+	_worst.clear();
+	_commands.clear();
+	_sampled_ticks = 0;
+	_tick = 0;
+}
+
+void CostAttribution::write_json(std::ostream &os_p) const
+{
+	os_p << "{\"sampled_ticks\": " << _sampled_ticks << ",\n";
+
+	// cumulated over the sampled ticks
+	os_p << "    \"commands\": [\n";
+	for(auto it_l = _commands.begin() ; it_l != _commands.end() ; ++ it_l)
+	{
+		os_p << "      {\"system\": \"" << it_l->first.first
+			<< "\", \"command\": \"" << it_l->first.second
+			<< "\", \"calls\": " << it_l->second.calls
+			<< ", \"ns\": " << it_l->second.ns
+			<< ", \"steps\": " << it_l->second.steps
+			<< "}" << (std::next(it_l) == _commands.end() ? "\n" : ",\n");
+	}
+	os_p << "    ],\n";
+
+	os_p << "    \"worst\": [\n";
+	for(size_t i = 0 ; i < _worst.size() ; ++ i)
+	{
+		EntityCost const &cost_l = _worst[i];
+		os_p << "      {\"tick\": " << cost_l.tick
+			<< ", \"entity\": " << cost_l.entity
+			<< ", \"system\": \"" << cost_l.system
+			<< "\", \"command\": \"" << or_none(cost_l.command)
+			<< "\", \"calls\": " << cost_l.calls
+			<< ", \"ns\": " << cost_l.ns
+			<< ", \"steps\": " << cost_l.steps
+			<< "}" << (i + 1 == _worst.size() ? "\n" : ",\n");
+	}
+	os_p << "    ]}";
+}
+
+} // namespace octopus
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace octopus
+{
+
+/// @brief cost of an entity in a system
+/// @note system and command must be literals
+struct EntityCost
+{
+	uint64_t entity = 0;
+	char const *system = nullptr;
+	/// @brief command type run by the system (nullptr out of command systems)
+	char const *command = nullptr;
+	/// @brief sampled tick
+	uint64_t tick = 0;
+	uint64_t ns = 0;
+	/// @brief steps added while running the entity
+	uint64_t steps = 0;
+	/// @brief number of runs (merged per tick)
+	uint64_t calls = 0;
+};
+
+/// @brief cumulated cost of a command type in a system over the sampled ticks
+struct CommandCost
+{
+	uint64_t ns = 0;
+	uint64_t steps = 0;
+	uint64_t calls = 0;
+};
+
+/// @brief samples of one thread
+/// only written by its thread, read by CostAttribution::collect
+struct CostThreadBuffer
+{
+	std::vector<EntityCost> samples;
+};
+
+/// @brief Attribute time and steps to entities and command types
+/// Systems open an entity scope (OCTOPUS_ENTITY_COST) for every entity they run,
+/// once enabled one tick every period is sampled. Samples are collected between
+/// two progress : costs are merged per entity and system, the top K offenders
+/// of the tick are kept and command costs are accumulated.
+/// @note process wide like the Profiler
+class CostAttribution
+{
+public:
+	static CostAttribution &get();
+
+	/// @brief sample one tick every period_p ticks (starting with the next one)
+	/// @param top_k_p number of offenders kept
+	void enable(uint32_t period_p=1, size_t top_k_p=10);
+	void disable();
+	bool is_enabled() const { return _enabled; }
+	/// @brief true if the running tick is sampled
+	bool is_sampling() const { return _sampling.load(std::memory_order_relaxed); }
+
+	void record(EntityCost const &cost_p);
+
+	/// @brief merge the samples of the tick and decide if the next tick is sampled
+	/// @note must be called between two progress
+	void collect();
+
+	/// @brief clear samples, offenders and command costs
+	void reset();
+
+	/// @brief top K offenders of the last sampled tick (most expensive first)
+	std::vector<EntityCost> const &last_top() const { return _last_top; }
+	/// @brief top K offenders of every sampled tick (most expensive first)
+	std::vector<EntityCost> const &worst() const { return _worst; }
+	/// @brief cost per system and command type
+	std::map<std::pair<std::string, std::string>, CommandCost> const &commands() const { return _commands; }
+	uint64_t sampled_ticks() const { return _sampled_ticks; }
+
+	/// @brief export offenders and command costs as json
+	void write_json(std::ostream &os_p) const;
+
+	/// @brief count a step added by the calling thread
+	static void count_step() { ++_thread_steps; }
+	static uint64_t thread_steps() { return _thread_steps; }
+
+private:
+	CostAttribution() = default;
+
+	CostThreadBuffer &thread_buffer();
+
+	static inline thread_local uint64_t _thread_steps = 0;
+
+	bool _enabled = false;
+	std::atomic<bool> _sampling {false};
+	uint32_t _period = 1;
+	size_t _top_k = 10;
+	/// @brief ticks collected since enabled
+	uint64_t _tick = 0;
+	uint64_t _sampled_ticks = 0;
+
+	std::mutex _buffers_mutex;
+	std::vector<std::unique_ptr<CostThreadBuffer> > _buffers;
+
+	std::vector<EntityCost> _last_top;
+	std::vector<EntityCost> _worst;
+	std::map<std::pair<std::string, std::string>, CommandCost> _commands;
+};
+
+/// @brief scoped entity cost, does nothing when the tick is not sampled
+class EntityCostScope
+{
+public:
+	EntityCostScope(char const *system_p, uint64_t entity_p, char const *command_p)
+		: _active(CostAttribution::get().is_sampling())
+	{
+		if(_active)
+		{
+			_cost.entity = entity_p;
+			_cost.system = system_p;
+			_cost.command = command_p;
+			_start_steps = CostAttribution::thread_steps();
+			_start = std::chrono::steady_clock::now();
+		}
+	}
+	~EntityCostScope()
+	{
+		if(_active)
+		{
+			_cost.ns = uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _start).count());
+			_cost.steps = CostAttribution::thread_steps() - _start_steps;
+			_cost.calls = 1;
+			CostAttribution::get().record(_cost);
+		}
+	}
+	EntityCostScope(EntityCostScope const &) = delete;
+	EntityCostScope &operator=(EntityCostScope const &) = delete;
+private:
+	bool const _active;
+	EntityCost _cost;
+	uint64_t _start_steps = 0;
+	std::chrono::steady_clock::time_point _start;
+};
+
+} // namespace octopus
+
+#define OCTOPUS_COST_CONCAT_IMPL(a, b) a##b
+#define OCTOPUS_COST_CONCAT(a, b) OCTOPUS_COST_CONCAT_IMPL(a, b)
+/// @brief attribute the enclosing scope to the entity
+/// (command is the command type name or nullptr)
+#define OCTOPUS_ENTITY_COST(system, entity, command) octopus::EntityCostScope OCTOPUS_COST_CONCAT(octopus_cost_, __LINE__)(system, (entity).id(), command);
@@ -0,0 +1,236 @@
+#include "Profiler.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <unordered_map>
+
+#include "flecs.h"
+
+namespace octopus
+{
+
+namespace
+{
+
+thread_local ZoneThreadBuffer *local_buffer = nullptr;
+
+bool is_flecs_internal(char const *name_p)
+{
+	return name_p && std::strncmp(name_p, "flecs.", 6) == 0;
+}
+
+void flecs_trace_push(char const *, size_t, char const *name_p)
+{
+	Profiler &profiler_l = Profiler::get();
+	if(!profiler_l.is_enabled()) { return; }
+	if(!profiler_l.records_flecs_internals() && is_flecs_internal(name_p)) { return; }
+	profiler_l.begin(name_p);
+}
+
+void flecs_trace_pop(char const *, size_t, char const *name_p)
+{
+	Profiler &profiler_l = Profiler::get();
+	if(!profiler_l.is_enabled()) { return; }
+	if(!profiler_l.records_flecs_internals() && is_flecs_internal(name_p)) { return; }
+	profiler_l.end();
+}
+
+/// @brief write ns as us with three decimals
+void write_us(std::ostream &os_p, int64_t ns_p)
+{
+	os_p << ns_p / 1000 << '.' << std::setw(3) << std::setfill('0') << ns_p % 1000 << std::setfill(' ');
+}
+
+void write_escaped(std::ostream &os_p, std::string const &str_p)
+{
+	for(char c : str_p)
+	{
+		if(c == '"' || c == '\\') { os_p << '\\'; }
+		os_p << c;
+	}
+}
+
+} // namespace
+
+void ZoneHistogram::add(uint64_t duration_ns_p, uint64_t allocations_p, uint64_t alloc_bytes_p)
+{
+	size_t bucket_l = 0;
+	while(bucket_l + 1 < buckets && (duration_ns_p >> (bucket_l + 1)) > 0)
+	{
+		++bucket_l;
+	}
+	++counts[bucket_l];
+	++count;
+	total_ns += duration_ns_p;
+	max_ns = std::max(max_ns, duration_ns_p);
+	allocations += allocations_p;
+	alloc_bytes += alloc_bytes_p;
+}
+
+uint64_t ZoneHistogram::percentile(uint32_t percent_p) const
+{
+	if(count == 0) { return 0; }
+	// rank of the percentile (1 based)
+	uint64_t const rank_l = std::max<uint64_t>(1, (count * percent_p + 99) / 100);
+	uint64_t seen_l = 0;
+	for(size_t i = 0 ; i < buckets ; ++ i)
+	{
+		seen_l += counts[i];
+		if(seen_l >= rank_l)
+		{
+			return std::min(max_ns, (uint64_t(2) << i) - 1);
+		}
+	}
+	return max_ns;
+}
+
+Profiler::Profiler() : _epoch(std::chrono::steady_clock::now()) {}
+
+Profiler &Profiler::get()
+{
+	static Profiler profiler_l;
+	return profiler_l;
+}
+
+void Profiler::enable(bool trace_p, bool flecs_internals_p)
+{
+	_keep_trace = trace_p;
+	_flecs_internals = flecs_internals_p;
+	// zones left open when disabled are dropped
+	{
+		std::lock_guard<std::mutex> lock_l(_buffers_mutex);
+		for(std::unique_ptr<ZoneThreadBuffer> &buffer_l : _buffers)
+		{
+			buffer_l->stack.clear();
+		}
+	}
+	_enabled.store(true, std::memory_order_relaxed);
+}
+
+void Profiler::disable()
+{
+	_enabled.store(false, std::memory_order_relaxed);
+}
+
+int64_t Profiler::now() const
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _epoch).count();
+}
+
+ZoneThreadBuffer &Profiler::thread_buffer()
+{
+	// registered once per thread
+	if(!local_buffer)
+	{
+		std::lock_guard<std::mutex> lock_l(_buffers_mutex);
+		_buffers.push_back(std::make_unique<ZoneThreadBuffer>());
+		_buffers.back()->thread_idx = uint32_t(_buffers.size() - 1);
+		// avoid counting the growth of the buffers in the zones
+		_buffers.back()->events.reserve(1024);
+		_buffers.back()->stack.reserve(64);
+		local_buffer = _buffers.back().get();
+	}
+	return *local_buffer;
+}
+
+void Profiler::begin(char const *name_p)
+{
+	ZoneThreadBuffer &buffer_l = thread_buffer();
+	AllocCounters const allocs_l = AllocStats::thread();
+	buffer_l.stack.push_back({name_p, now(), 0, allocs_l.allocations, allocs_l.bytes});
+}
+
+void Profiler::end()
+{
+	ZoneThreadBuffer &buffer_l = thread_buffer();
+	// zone opened before the profiler was enabled
+	if(buffer_l.stack.empty()) { return; }
+	AllocCounters const allocs_l = AllocStats::thread();
+	ZoneEvent event_l = buffer_l.stack.back();
+	buffer_l.stack.pop_back();
+	event_l.end_ns = now();
+	event_l.allocations = allocs_l.allocations - event_l.allocations;
+	event_l.alloc_bytes = allocs_l.bytes - event_l.alloc_bytes;
+	buffer_l.events.push_back(event_l);
+}
+
+void Profiler::collect()
+{
+	std::lock_guard<std::mutex> lock_l(_buffers_mutex);
+	// names are mostly the same pointers from one event to another
+	std::unordered_map<char const *, ZoneHistogram *> histograms_l;
+	std::unordered_map<char const *, uint32_t> trace_names_l;
+	for(std::unique_ptr<ZoneThreadBuffer> &buffer_l : _buffers)
+	{
+		for(ZoneEvent const &event_l : buffer_l->events)
+		{
+			char const *name_l = event_l.name ? event_l.name : "unknown";
+			ZoneHistogram *&histogram_l = histograms_l[name_l];
+			if(!histogram_l)
+			{
+				histogram_l = &_histograms[name_l];
+			}
+			histogram_l->add(uint64_t(event_l.end_ns - event_l.start_ns), event_l.allocations, event_l.alloc_bytes);
+
+			if(!_keep_trace) { continue; }
+			auto it_l = trace_names_l.find(name_l);
+			if(it_l == trace_names_l.end())
+			{
+				auto inserted_l = _trace_name_idx.insert({name_l, uint32_t(_trace_names.size())});
+				if(inserted_l.second)
+				{
+					_trace_names.push_back(name_l);
+				}
+				it_l = trace_names_l.insert({name_l, inserted_l.first->second}).first;
+			}
+			_trace.push_back({it_l->second, buffer_l->thread_idx, event_l.start_ns, event_l.end_ns, event_l.allocations});
+		}
+		buffer_l->events.clear();
+	}
+}
+
+void Profiler::reset()
+{
+	std::lock_guard<std::mutex> lock_l(_buffers_mutex);
+	for(std::unique_ptr<ZoneThreadBuffer> &buffer_l : _buffers)
+	{
+		buffer_l->events.clear();
+		buffer_l->stack.clear();
+	}
+	_histograms.clear();
+	_trace.clear();
+	_trace_names.clear();
+	_trace_name_idx.clear();
+}
+
+void Profiler::write_chrome_trace(std::ostream &os_p) const
+{
+	os_p << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+	for(size_t i = 0 ; i < _trace.size() ; ++ i)
+	{
+		ZoneTraceEvent const &event_l = _trace[i];
+		os_p << (i == 0 ? "\n" : ",\n");
+		os_p << "{\"name\": \"";
+		write_escaped(os_p, _trace_names[event_l.name_idx]);
+		os_p << "\", \"ph\": \"X\", \"pid\": 0, \"tid\": " << event_l.thread_idx << ", \"ts\": ";
+		write_us(os_p, event_l.start_ns);
+		os_p << ", \"dur\": ";
+		write_us(os_p, event_l.end_ns - event_l.start_ns);
+		if(event_l.allocations > 0)
+		{
+			os_p << ", \"args\": {\"allocations\": " << event_l.allocations << "}";
+		}
+		os_p << "}";
+	}
+	os_p << "\n]}\n";
+}
+
+void Profiler::install_flecs_hooks()
+{
+	// not reset by the flecs os api defaults
+	ecs_os_api.perf_trace_push_ = flecs_trace_push;
+	ecs_os_api.perf_trace_pop_ = flecs_trace_pop;
+}
+
+} // namespace octopus
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "octopus/utils/alloc/AllocStats.hh"
+
+namespace octopus
+{
+
+/// @brief a zone run on a thread
+/// @note name must outlive the next Profiler::collect (literals, flecs system names)
+struct ZoneEvent
+{
+	char const *name = nullptr;
+	int64_t start_ns = 0;
+	int64_t end_ns = 0;
+	/// @brief allocations of the thread during the zone (counters at start while open)
+	uint64_t allocations = 0;
+	uint64_t alloc_bytes = 0;
+};
+
+/// @brief a collected zone kept for the trace export
+struct ZoneTraceEvent
+{
+	/// @brief index in Profiler::trace_names
+	uint32_t name_idx = 0;
+	uint32_t thread_idx = 0;
+	int64_t start_ns = 0;
+	int64_t end_ns = 0;
+	uint64_t allocations = 0;
+};
+
+/// @brief log2 histogram of the durations of a zone
+/// bucket i holds durations in [2^i, 2^(i+1)) ns
+struct ZoneHistogram
+{
+	static constexpr size_t buckets = 40;
+
+	std::array<uint64_t, buckets> counts {};
+	uint64_t count = 0;
+	uint64_t total_ns = 0;
+	uint64_t max_ns = 0;
+	/// @brief allocations of the zones (see AllocStats)
+	uint64_t allocations = 0;
+	uint64_t alloc_bytes = 0;
+
+	void add(uint64_t duration_ns_p, uint64_t allocations_p=0, uint64_t alloc_bytes_p=0);
+
+	/// @brief upper bound of the bucket containing the percentile
+	uint64_t percentile(uint32_t percent_p) const;
+};
+
+/// @brief events of one thread
+/// only written by its thread, read by Profiler::collect
+struct ZoneThreadBuffer
+{
+	uint32_t thread_idx = 0;
+	std::vector<ZoneEvent> events;
+	/// @brief zones currently open on the thread
+	std::vector<ZoneEvent> stack;
+};
+
+/// @brief Zone profiler
+/// zones are recorded in per thread buffers without lock, every flecs
+/// system run is a zone once the flecs hooks are installed (FLECS_PERF_TRACE)
+/// and thread pool jobs are zones as well.
+/// Zones also record the allocations of their thread (nested zones included)
+/// Buffers are collected between two progress into per zone histograms and
+/// optionally kept as a trace that can be exported for chrome://tracing or perfetto
+/// @note process wide since the flecs hooks are
+class Profiler
+{
+public:
+	static Profiler &get();
+
+	/// @brief start recording zones
+	/// @param trace_p keep every event for the trace export
+	/// @param flecs_internals_p also record flecs internal zones (commit, emit...)
+	void enable(bool trace_p=false, bool flecs_internals_p=false);
+	void disable();
+	bool is_enabled() const { return _enabled.load(std::memory_order_relaxed); }
+	bool records_flecs_internals() const { return _flecs_internals; }
+
+	/// @brief open a zone on the calling thread
+	void begin(char const *name_p);
+	/// @brief close the last zone open on the calling thread
+	void end();
+
+	/// @brief move the events of all threads into the histograms (and trace)
+	/// @note must be called when no zone is open on any other thread
+	/// (typically between two progress)
+	void collect();
+
+	/// @brief clear histograms, trace and buffers
+	void reset();
+
+	std::map<std::string, ZoneHistogram> const &histograms() const { return _histograms; }
+	std::vector<ZoneTraceEvent> const &trace() const { return _trace; }
+	std::vector<std::string> const &trace_names() const { return _trace_names; }
+
+	/// @brief export the trace as chrome trace event json
+	void write_chrome_trace(std::ostream &os_p) const;
+
+	/// @brief install the flecs perf trace hooks so that every system run is a zone
+	void install_flecs_hooks();
+
+	/// @brief ns since the profiler creation
+	int64_t now() const;
+
+private:
+	Profiler();
+
+	ZoneThreadBuffer &thread_buffer();
+
+	std::chrono::steady_clock::time_point const _epoch;
+	std::atomic<bool> _enabled {false};
+	bool _keep_trace = false;
+	bool _flecs_internals = false;
+
+	std::mutex _buffers_mutex;
+	std::vector<std::unique_ptr<ZoneThreadBuffer> > _buffers;
+
+	std::map<std::string, ZoneHistogram> _histograms;
+	/// @brief events kept for the trace, names are copied in _trace_names
+	std::vector<ZoneTraceEvent> _trace;
+	std::vector<std::string> _trace_names;
+	std::map<std::string, uint32_t> _trace_name_idx;
+};
+
+/// @brief scoped zone, does nothing when the profiler is disabled
+class ProfilerZone
+{
+public:
+	explicit ProfilerZone(char const *name_p)
+		: _active(Profiler::get().is_enabled())
+	{
+		if(_active) { Profiler::get().begin(name_p); }
+	}
+	~ProfilerZone()
+	{
+		if(_active) { Profiler::get().end(); }
+	}
+	ProfilerZone(ProfilerZone const &) = delete;
+	ProfilerZone &operator=(ProfilerZone const &) = delete;
+private:
+	bool const _active;
+};
+
+} // namespace octopus
+
+#define OCTOPUS_ZONE_CONCAT_IMPL(a, b) a##b
+#define OCTOPUS_ZONE_CONCAT(a, b) OCTOPUS_ZONE_CONCAT_IMPL(a, b)
+/// @brief profile the enclosing scope
+#define OCTOPUS_ZONE(name) octopus::ProfilerZone OCTOPUS_ZONE_CONCAT(octopus_zone_, __LINE__)(name);
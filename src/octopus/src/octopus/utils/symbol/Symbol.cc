@@ -0,0 +1,82 @@
+#include "Symbol.hh"
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace octopus
+{
+
+namespace
+{
+
+/// @brief names and their ids
+/// deque is used to keep references on names valid when interning
+struct SymbolTable
+{
+	SymbolTable() { intern(""); }
+
+	uint32_t intern(std::string const &name_p)
+	{
+		auto &&it = ids.find(name_p);
+		if(it != ids.cend())
+		{
+			return it->second;
+		}
+		uint32_t id_l = names.size();
+		names.push_back(name_p);
+		ids[name_p] = id_l;
+		return id_l;
+	}
+
+	std::mutex mutex;
+	std::deque<std::string> names;
+	std::unordered_map<std::string, uint32_t> ids;
+};
+
+SymbolTable &get_table()
+{
+	static SymbolTable table_l;
+	return table_l;
+}
+
+} // namespace
+
+Symbol::Symbol(std::string const &name_p)
+{
+	SymbolTable &table_l = get_table();
+	std::lock_guard<std::mutex> lock_l(table_l.mutex);
+	id = table_l.intern(name_p);
+}
+
+Symbol::Symbol(char const *name_p) : Symbol(std::string(name_p))
+{}
+
+std::string const &Symbol::name() const
+{
+	SymbolTable &table_l = get_table();
+	std::lock_guard<std::mutex> lock_l(table_l.mutex);
+	return table_l.names[id];
+}
+
+Symbol find_symbol(std::string const &name_p)
+{
+	SymbolTable &table_l = get_table();
+	std::lock_guard<std::mutex> lock_l(table_l.mutex);
+	Symbol symbol_l;
+	auto &&it = table_l.ids.find(name_p);
+	if(it != table_l.ids.cend())
+	{
+		symbol_l.id = it->second;
+	}
+	return symbol_l;
+}
+
+uint32_t symbol_count()
+{
+	SymbolTable &table_l = get_table();
+	std::lock_guard<std::mutex> lock_l(table_l.mutex);
+	return table_l.names.size();
+}
+
+} // namespace octopus
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace octopus
+{
+
+/// @brief Interned identifier (production, ability, upgrade...)
+/// the id indexes a process wide symbol table where names are
+/// registered in interning order (0 is the empty name)
+/// @note ids are only compared and used as indexes, they are
+/// never saved (names are)
+struct Symbol
+{
+	Symbol() = default;
+	Symbol(std::string const &name_p);
+	Symbol(char const *name_p);
+
+	/// @brief name of the symbol
+	std::string const &name() const;
+	bool empty() const { return id == 0; }
+
+	bool operator==(Symbol const &other_p) const { return id == other_p.id; }
+	bool operator!=(Symbol const &other_p) const { return id != other_p.id; }
+
+	uint32_t id = 0;
+};
+
+/// @brief return the symbol of the name if already interned
+/// or the empty symbol otherwise (the name is not interned)
+Symbol find_symbol(std::string const &name_p);
+
+/// @brief number of interned symbols (empty one included)
+uint32_t symbol_count();
+
+} // namespace octopus
+
+namespace std
+{
+
+template<>
+struct hash<octopus::Symbol>
+{
+	size_t operator()(octopus::Symbol const &symbol_p) const { return symbol_p.id; }
+};
+
+} // namespace std
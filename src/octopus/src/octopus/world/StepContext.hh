@@ -23,6 +23,7 @@
 #include "octopus/components/step/ComponentStepContainer.hh"
 #include "octopus/world/resources/ResourceStock.hh"
 #include "octopus/world/resources/CostReduction.hh"
+#include "octopus/world/timer/TimerWheel.hh"
 
 #define DEFAULT_STEPS_T octopus::HitPointStep, \
 octopus::HitPointMaxStep, \
@@ -32,6 +33,8 @@ octopus::StuckInfoStep, \
 octopus::PositionInTreeStep, \
 octopus::MassStep, \
 octopus::VelocityStep, \
+octopus::KinematicStep, \
+octopus::SleepStep, \
 octopus::CollisionStep, \
 octopus::AttackWindupStep, \
 octopus::AttackReloadStep, \
@@ -48,6 +51,7 @@ octopus::ReductionLibraryStep, \
 octopus::ProjectileStep, \
 octopus::PlayerUpgradeStep, \
 octopus::RallyPointStep, \
+octopus::TimerStep, \
 octopus::TimeStampIncrementStep \
 
 
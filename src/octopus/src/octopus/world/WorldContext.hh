@@ -1,14 +1,18 @@
 #pragma once
 
 #include "octopus/utils/ThreadPool.hh"
+#include "octopus/utils/alloc/AllocStats.hh"
+#include "octopus/utils/profiler/Profiler.hh"
 #include "octopus/utils/RandomGenerator.hh"
 #include "octopus/utils/triangulation/Triangulation.hh"
+#include "octopus/world/budget/WorkBudget.hh"
+#include "octopus/world/metrics/EngineMetrics.hh"
 #include "octopus/world/position/PositionContext.hh"
-#include "octopus/world/stats/TimeStats.hh"
 #include "octopus/world/ability/AbilityTemplateLibrary.hh"
 #include "octopus/world/production/ProductionTemplateLibrary.hh"
 #include "octopus/world/StepContext.hh"
 #include "octopus/commands/basic/move/DamageModifier.hh"
+#include "octopus/world/damage/DamageAccumulator.hh"
 #include "flecs.h"
 
 #include <memory>
@@ -21,9 +25,13 @@ namespace octopus
 template<class StepManager_t=DefaultStepManager>
 struct WorldContext
 {
-	WorldContext(unsigned long seed=42) : pool(12), position_context(ecs), rng(seed)
+	WorldContext(unsigned long seed=42) : pool(12), position_context(ecs), rng(seed), damage_accumulator(pool.size())
 	{
 		ecs.set_threads(12);
+		// every system run is a profiler zone (no op until the profiler is enabled)
+		Profiler::get().install_flecs_hooks();
+		// count flecs allocations (after the world creation that sets the flecs os api)
+		AllocStats::install_flecs_hooks();
 	}
 	~WorldContext() {
 		if(ecs.try_get<AbilityTemplateLibrary<StepManager_t>>())
@@ -39,10 +47,15 @@ struct WorldContext
 	flecs::world ecs;
 	ThreadPool pool;
 	PositionContext position_context;
-	TimeStats time_stats;
 	RandomGenerator rng;
 	Triangulation triangulation;
 	std::unique_ptr<DamageModifier> damage_modifier = std::make_unique<ArmorDamageModifier>();
+	/// @brief merge all damage of a step into one HitPointStep per target
+	DamageAccumulator damage_accumulator;
+	/// @brief budget channels of the background work (retarget scans, path finding...)
+	WorkScheduler work_scheduler;
+	/// @brief phase durations and engine counters (see metrics)
+	EngineMetricsCollector metrics_collector;
 
 	/// @brief tell if the AttackSystems should wait for
 	/// some time before looking for new target
@@ -53,6 +66,40 @@ struct WorldContext
 	/// @note should be either 1 or powers of 2
 	/// @note this is the number of step between to target scan.
 	int64_t attack_retarget_wait = 1;
+	/// @brief target scans per step (0 for unlimited)
+	/// Above it the wait between two scans doubles, up to
+	/// attack_retarget_max_wait (see BudgetChannel)
+	uint64_t attack_retarget_budget = 0;
+	int64_t attack_retarget_max_wait = 64;
+
+	/// @brief number of steps between two updates of the target
+	/// position of a projectile, doubled while the updates exceed
+	/// projectile_retarget_budget (0 for unlimited)
+	int64_t projectile_retarget_wait = 32;
+	uint64_t projectile_retarget_budget = 0;
+	int64_t projectile_retarget_max_wait = 128;
+
+	/// @brief number of steps an entity must stay idle
+	/// (not moving and no velocity) before being put to sleep
+	/// Sleeping entities are skipped by the flocking, stuck
+	/// detection and move systems until woken up by a move,
+	/// a moving neighbour or damage
+	/// @note 0 disables sleeping
+	uint8_t sleep_wait = 50;
+
+	/// @brief number of steps between two refreshes of the
+	/// HistoryMemory singleton (memory held by the step histories)
+	/// @note 0 disables the accounting
+	uint32_t history_memory_period = 0;
+
+	/// @brief publish the phase durations, steps per type, path requests
+	/// and position tree counters as flecs components and metrics
+	/// (see EngineMetricsCollector)
+	bool metrics = false;
+	/// @brief serve the flecs REST api on localhost for the explorer
+	/// (requires metrics)
+	/// @note 0 disables the REST api
+	uint16_t metrics_rest_port = 0;
 };
 
 } // namespace octopus
@@ -7,10 +7,15 @@
 #include "octopus/components/basic/player/Player.hh"
 #include "octopus/components/basic/player/UpgradeRequirement.hh"
 #include "octopus/utils/FixedPoint.hh"
+#include "octopus/utils/symbol/Symbol.hh"
 #include "octopus/utils/Vector.hh"
+#include "octopus/world/resources/ResourceLedger.hh"
 
 namespace octopus
 {
+template<class StepManager_t>
+struct AbilityTemplateLibrary;
+
 /// @brief This class represent a template for a production
 /// entity, it can be a unit, an upgrade, or event a building
 template<class StepManager_t>
@@ -22,8 +27,21 @@ struct AbilityTemplate
     /// requirements to cast this template
     bool check_requirement(flecs::entity caster_p, flecs::world const &ecs) const
     {
+        if(_requirement != no_requirement_id)
+        {
+            return check_requirements(caster_p, ecs, _requirement);
+        }
         return check_requirements(caster_p, ecs, get_requirements());
     }
+    /// @brief Return the list of unmet requirements for the given player
+    std::vector<std::string> explain_unmet_requirements(flecs::entity caster_p, flecs::world const &ecs) const
+    {
+        if(_requirement != no_requirement_id)
+        {
+            return octopus::explain_unmet_requirements(caster_p, ecs, _requirement);
+        }
+        return octopus::explain_unmet_requirements(caster_p, ecs, get_requirements());
+    }
     /// @brief Return a list of missing requirements
     virtual UpgradeRequirement get_requirements() const { return {}; }
     /// @brief This is used to handle resource consumption and restoration
@@ -41,6 +59,12 @@ struct AbilityTemplate
     virtual void cast(flecs::entity caster_p, Vector target_point, flecs::entity target_entity, flecs::world const &ecs, StepManager_t &manager_p) const = 0;
     /// @brief id of the ability
     virtual std::string name() const = 0;
+    /// @brief interned name, set when added to the library
+    Symbol const &symbol() const { return _symbol; }
+    /// @brief resource_consumption by resource index, set when added to the library
+    DenseCost const &dense_cost() const { return _dense_cost; }
+    /// @brief player_resource_consumption by resource index, set when added to the library
+    DenseCost const &dense_player_cost() const { return _dense_player_cost; }
     /// @brief This is the duration (in steps) during which
     /// the cast has to be prepared
     virtual int64_t windup() const = 0;
@@ -60,6 +84,13 @@ struct AbilityTemplate
     /// @param ecs The current state of the world, which can be used to check conditions
     /// @return an emtpy string if the ability is castable, or a non-empty string describing why it can't be cast
     virtual std::string is_castable(flecs::entity, flecs::world const &) const { return ""; }
+private:
+    Symbol _symbol;
+    DenseCost _dense_cost;
+    DenseCost _dense_player_cost;
+    RequirementId _requirement = no_requirement_id;
+
+    friend struct AbilityTemplateLibrary<StepManager_t>;
 };
 
 } // namespace octopus
@@ -2,6 +2,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include "AbilityTemplate.hh"
 
 namespace octopus
@@ -12,9 +13,19 @@ struct AbilityTemplateLibrary
 {
 public:
 
+    /// @brief add the template and intern its name
     void add_template(AbilityTemplate<StepManager_t>* template_p)
     {
+        template_p->_symbol = Symbol(template_p->name());
+        template_p->_requirement = register_requirement(template_p->get_requirements());
+        template_p->_dense_cost = make_dense_cost(template_p->resource_consumption());
+        template_p->_dense_player_cost = make_dense_cost(template_p->player_resource_consumption());
         _templates[template_p->name()] = template_p;
+        if(_templates_by_symbol.size() <= template_p->_symbol.id)
+        {
+            _templates_by_symbol.resize(template_p->_symbol.id+1, nullptr);
+        }
+        _templates_by_symbol[template_p->_symbol.id] = template_p;
     }
 
     AbilityTemplate<StepManager_t> const &get(std::string const &id_p) const
@@ -28,6 +39,16 @@ public:
         return it != _templates.cend() ? it->second : nullptr;
     }
 
+    AbilityTemplate<StepManager_t> const &get(Symbol const &id_p) const
+    {
+        return *_templates_by_symbol.at(id_p.id);
+    }
+
+    AbilityTemplate<StepManager_t> const *try_get(Symbol const &id_p) const
+    {
+        return id_p.id < _templates_by_symbol.size() ? _templates_by_symbol[id_p.id] : nullptr;
+    }
+
     void clean_up()
     {
         for(auto &&pair_l : _templates)
@@ -35,9 +56,12 @@ public:
             delete pair_l.second;
         }
         _templates.clear();
+        _templates_by_symbol.clear();
     }
 private:
     std::unordered_map<std::string, AbilityTemplate<StepManager_t>*> _templates;
+    /// @brief templates indexed by the id of their symbol
+    std::vector<AbilityTemplate<StepManager_t>*> _templates_by_symbol;
 };
 
 } // namespace octopus
@@ -0,0 +1,95 @@
+#include "WorkBudget.hh"
+
+#include <algorithm>
+
+namespace octopus
+{
+
+BudgetChannel::BudgetChannel(std::string const &name_p, BudgetKind kind_p, uint64_t budget_p, int64_t min_stride_p, int64_t max_stride_p)
+	: name(name_p), kind(kind_p), budget(budget_p), min_stride(std::max<int64_t>(1, min_stride_p)),
+	max_stride(std::max(min_stride, max_stride_p)), stride(min_stride)
+{
+	if(kind == BudgetKind::Stride)
+	{
+		_history.resize(history_size, {-1, 0});
+	}
+}
+
+void BudgetChannel::begin_queue()
+{
+	spent = 0;
+	runs = 0;
+}
+
+void BudgetChannel::update_stride(int64_t tick_p)
+{
+	// store the demand of the last tick run
+	if(_started)
+	{
+		_history[size_t(_demand_tick) % history_size] = {_demand_tick, _demand.load(std::memory_order_relaxed)};
+	}
+	_started = true;
+	_demand.store(0, std::memory_order_relaxed);
+	_demand_tick = tick_p;
+
+	std::pair<int64_t, uint64_t> const &previous_l = _history[size_t(tick_p - 1) % history_size];
+	uint64_t const demand_l = previous_l.first == tick_p - 1 ? previous_l.second : 0;
+
+	stride = min_stride;
+	if(budget > 0)
+	{
+		while(stride < max_stride && demand_l / uint64_t(stride) > budget)
+		{
+			stride = std::min(max_stride, stride * 2);
+		}
+	}
+	backlog = demand_l - demand_l / uint64_t(stride);
+}
+
+BudgetChannel &WorkScheduler::add_queue(std::string const &name_p, uint64_t budget_p)
+{
+	_owned.emplace_back(name_p, BudgetKind::Queue, budget_p);
+	_channels.push_back(&_owned.back());
+	return _owned.back();
+}
+
+BudgetChannel &WorkScheduler::add_stride(std::string const &name_p, uint64_t budget_p, int64_t min_stride_p, int64_t max_stride_p)
+{
+	_owned.emplace_back(name_p, BudgetKind::Stride, budget_p, min_stride_p, max_stride_p);
+	_channels.push_back(&_owned.back());
+	return _owned.back();
+}
+
+void WorkScheduler::attach(BudgetChannel &channel_p)
+{
+	_channels.push_back(&channel_p);
+}
+
+void WorkScheduler::begin_tick(int64_t tick_p)
+{
+	for(BudgetChannel *channel_l : _channels)
+	{
+		if(channel_l->kind == BudgetKind::Queue)
+		{
+			channel_l->begin_queue();
+		}
+		else
+		{
+			channel_l->update_stride(tick_p);
+		}
+	}
+}
+
+BudgetChannel *WorkScheduler::find(std::string const &name_p) const
+{
+	for(BudgetChannel *channel_l : _channels)
+	{
+		if(channel_l->name == name_p)
+		{
+			return channel_l;
+		}
+	}
+	return nullptr;
+}
+
+} // namespace octopus
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace octopus
+{
+
+enum class BudgetKind
+{
+	/// @brief items run in order while the budget is not spent
+	Queue,
+	/// @brief periodic work staggered over entities
+	Stride
+};
+
+/// @brief Per tick budget of a subsystem in work units (nodes expanded,
+/// entities scanned...). Budgets are never expressed in wall time so that
+/// every peer runs the same work on the same tick.
+/// - queue channels : the owner runs its items in order while has_budget()
+/// (the item started always completes) then reports the items left as backlog
+/// - stride channels : an entity is due when (tick + id) % stride == 0,
+/// the stride is the smallest power of two times min_stride (up to max_stride)
+/// for which the demand of the previous tick fits in the budget
+/// @note stride channels keep the demand of the last ticks so that the stride
+/// of a tick does not change when replaying it after a revert (as long as the
+/// revert is no deeper than history_size)
+struct BudgetChannel
+{
+	static constexpr size_t history_size = 1024;
+
+	/// @param budget_p work units per tick (0 for unlimited)
+	BudgetChannel(std::string const &name_p, BudgetKind kind_p, uint64_t budget_p, int64_t min_stride_p=1, int64_t max_stride_p=1);
+
+	std::string const name;
+	BudgetKind const kind;
+	/// @brief work units per tick (0 for unlimited)
+	uint64_t budget = 0;
+	int64_t min_stride = 1;
+	int64_t max_stride = 1;
+
+	/// @brief reset the work spent (queue)
+	void begin_queue();
+	/// @brief true if an item can be started this tick (queue)
+	bool has_budget() const { return budget == 0 || spent < budget; }
+	/// @brief account an item that cost units_p (queue)
+	void spend(uint64_t units_p) { spent += units_p; ++runs; }
+	/// @brief items left once the budget is spent (queue)
+	void set_backlog(uint64_t backlog_p) { backlog = backlog_p; }
+
+	/// @brief update the stride of the tick from the demand of the previous one (stride)
+	void update_stride(int64_t tick_p);
+	/// @brief account work that would run this tick if every entity was due (stride)
+	/// @note thread safe
+	void add_demand(uint64_t units_p) { _demand.fetch_add(units_p, std::memory_order_relaxed); }
+	/// @brief true if the periodic work of the entity is due this tick (stride)
+	bool is_due(int64_t tick_p, uint64_t id_p) const { return (tick_p + id_p) % stride == 0; }
+
+	/// @brief work spent this tick (queue)
+	uint64_t spent = 0;
+	/// @brief items run this tick (queue)
+	uint64_t runs = 0;
+	/// @brief items (queue) or work units (stride) deferred to the next ticks
+	uint64_t backlog = 0;
+	/// @brief stride of the tick (stride)
+	int64_t stride = 1;
+
+private:
+	/// @brief demand of the running tick
+	std::atomic<uint64_t> _demand {0};
+	int64_t _demand_tick = 0;
+	bool _started = false;
+	/// @brief (tick, demand) indexed by tick modulo history_size
+	std::vector<std::pair<int64_t, uint64_t> > _history;
+};
+
+/// @brief Registry of the budget channels of a world
+/// begin_tick must run once per tick before any system using a channel
+/// (see set_up_budget_systems)
+class WorkScheduler
+{
+public:
+	BudgetChannel &add_queue(std::string const &name_p, uint64_t budget_p);
+	BudgetChannel &add_stride(std::string const &name_p, uint64_t budget_p, int64_t min_stride_p, int64_t max_stride_p);
+	/// @brief register a channel owned by a subsystem (updated and reported as the others)
+	void attach(BudgetChannel &channel_p);
+
+	/// @brief reset queue channels and update the strides
+	void begin_tick(int64_t tick_p);
+
+	std::vector<BudgetChannel *> const &channels() const { return _channels; }
+	/// @brief nullptr if no channel has this name
+	BudgetChannel *find(std::string const &name_p) const;
+private:
+	/// @brief deque to keep references valid
+	std::deque<BudgetChannel> _owned;
+	std::vector<BudgetChannel *> _channels;
+};
+
+} // namespace octopus
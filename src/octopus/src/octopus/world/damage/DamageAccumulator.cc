@@ -0,0 +1,75 @@
+#include "DamageAccumulator.hh"
+
+#include <algorithm>
+
+namespace octopus
+{
+
+void DamageAccumulator::add(flecs::entity const &source_p, flecs::entity const &target_p, Fixed const &damage_p, size_t thread_idx_p)
+{
+	contributions[thread_idx_p].push_back({source_p, target_p, damage_p});
+}
+
+std::vector<DamageContribution> const &DamageAccumulator::reduce(ThreadPool &pool_p)
+{
+	// gather contributions from all threads
+	_sorted.clear();
+	for(std::vector<DamageContribution> &contributions_l : contributions)
+	{
+		_sorted.insert(_sorted.end(), contributions_l.begin(), contributions_l.end());
+		contributions_l.clear();
+	}
+
+	// stable to keep a deterministic order of sources for a given target
+	std::stable_sort(_sorted.begin(), _sorted.end(), [](DamageContribution const &a, DamageContribution const &b) {
+		return a.target.id() < b.target.id();
+	});
+
+	// start of every target range
+	_starts.clear();
+	for(size_t i = 0 ; i < _sorted.size() ; ++ i)
+	{
+		if(i == 0 || _sorted[i].target != _sorted[i-1].target)
+		{
+			_starts.push_back(i);
+		}
+	}
+
+	// net damage of targets in [s, e)
+	_net.resize(_starts.size());
+	auto sum_l = [this](size_t, size_t s, size_t e) {
+		for(size_t t = s ; t < e ; ++ t)
+		{
+			size_t const end_l = t+1 < _starts.size() ? _starts[t+1] : _sorted.size();
+			DamageContribution net_l {flecs::entity(), _sorted[_starts[t]].target, Fixed::Zero()};
+			for(size_t i = _starts[t] ; i < end_l ; ++ i)
+			{
+				net_l.damage += _sorted[i].damage;
+			}
+			_net[t] = net_l;
+		}
+	};
+
+	// not worth dispatching jobs for a few targets
+	if(_starts.size() < pool_p.size() * 16)
+	{
+		sum_l(0, 0, _starts.size());
+	}
+	else
+	{
+		threading(_starts.size(), pool_p, sum_l, "damage.accumulate");
+	}
+
+	if(debug)
+	{
+		breakdown = _sorted;
+	}
+	else
+	{
+		breakdown.clear();
+	}
+
+	return _net;
+}
+
+} // namespace octopus
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "flecs.h"
+
+#include <vector>
+
+#include "octopus/components/basic/hitpoint/HitPoint.hh"
+#include "octopus/systems/phases/Phases.hh"
+#include "octopus/utils/FixedPoint.hh"
+#include "octopus/utils/ThreadPool.hh"
+
+namespace octopus
+{
+
+/// @brief damage dealt to a target by a source
+/// @note heals are negative damages
+struct DamageContribution
+{
+	flecs::entity source;
+	flecs::entity target;
+	Fixed damage;
+};
+
+/// @brief Accumulate all damage and heal contributions of a step
+/// to emit only one HitPointStep per target
+struct DamageAccumulator
+{
+	DamageAccumulator(size_t threads_p=1) : contributions(threads_p) {}
+
+	/// @brief add a contribution
+	/// @param thread_idx_p stage id when called from a multi threaded system
+	void add(flecs::entity const &source_p, flecs::entity const &target_p, Fixed const &damage_p, size_t thread_idx_p=0);
+
+	/// @brief merge all contributions per target (in parallel)
+	/// @return the net damage per target sorted by target id (source is not set)
+	/// @note clears the contributions, keeps them in breakdown if debug is set
+	std::vector<DamageContribution> const &reduce(ThreadPool &pool_p);
+
+	/// @brief keep per source breakdown of the last reduction
+	bool debug = false;
+	/// @brief contributions of the last reduction sorted by target id
+	/// @note only filled when debug is set
+	std::vector<DamageContribution> breakdown;
+
+	/// @brief contributions per thread
+	std::vector<std::vector<DamageContribution>> contributions;
+
+private:
+	std::vector<DamageContribution> _sorted;
+	std::vector<size_t> _starts;
+	std::vector<DamageContribution> _net;
+};
+
+/// @brief emit one HitPointStep per target from the accumulated contributions
+/// @note must run after all damage sources (declared after them in EndUpdatePhase)
+template<class StepManager_t>
+void set_up_damage_systems(flecs::world &ecs, ThreadPool &pool, StepManager_t &manager_p, DamageAccumulator &accumulator_p)
+{
+	ecs.system<>()
+		.kind(ecs.entity(EndUpdatePhase))
+		.run([&pool, &manager_p, &accumulator_p](flecs::iter &) {
+			for(DamageContribution const &net_l : accumulator_p.reduce(pool))
+			{
+				if(net_l.damage != Fixed::Zero())
+				{
+					manager_p.get_last_layer().back().template get<HitPointStep>().add_step(net_l.target, {-net_l.damage});
+				}
+			}
+		});
+}
+
+} // namespace octopus
@@ -0,0 +1,217 @@
+#include "EngineMetrics.hh"
+
+#include <algorithm>
+#include <utility>
+
+#include "octopus/systems/phases/Phases.hh"
+#include "octopus/world/path/PathFindingCache.hh"
+
+namespace octopus
+{
+
+namespace
+{
+
+/// @brief pipeline order (see set_up_phases)
+char const * const phase_names[] = {
+	InitializationPhase,
+	PrepingUpdatePhase,
+	CleanUpPhase,
+	PostCleanUpPhase,
+	PreUpdatePhase,
+	UpdatePhase,
+	UpdateUnpausedPhase,
+	PostUpdatePhase,
+	PostUpdateUnpausedPhase,
+	EndUpdatePhase,
+	MovingPhase,
+	InputPhase,
+	SteppingPhase,
+	ValidatePhase,
+	DisplaySyncPhase,
+	EndCleanUpPhase,
+};
+
+uint64_t elapsed_ns(EngineMetricsCollector::clock::time_point const &start_p, EngineMetricsCollector::clock::time_point const &end_p)
+{
+	return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(end_p - start_p).count());
+}
+
+/// @brief difference with the previous total of the counter
+uint64_t counter_delta(uint64_t *previous_p, EngineCounter counter_p)
+{
+	uint64_t const total_l = EngineCounters::total(counter_p);
+	uint64_t const delta_l = total_l - previous_p[size_t(counter_p)];
+	previous_p[size_t(counter_p)] = total_l;
+	return delta_l;
+}
+
+/// @brief name without the namespaces
+std::string short_name(std::string const &name_p)
+{
+	size_t const pos_l = name_p.rfind("::");
+	return pos_l == std::string::npos ? name_p : name_p.substr(pos_l + 2);
+}
+
+} // namespace
+
+void EngineMetricsCollector::set_up(flecs::world &ecs)
+{
+	ecs.import<flecs::metrics>();
+
+	ecs.component<PhaseMetrics>()
+		.member<uint64_t>("last_ns")
+		.member<uint64_t>("max_ns");
+	ecs.component<EngineMetrics>()
+		.member<uint64_t>("steps")
+		.member<uint64_t>("path_queued")
+		.member<uint64_t>("path_computed")
+		.member<uint64_t>("path_backlog")
+		.member<uint64_t>("spatial_queries")
+		.member<uint64_t>("tree_inserts")
+		.member<uint64_t>("tree_reinserts")
+		.member<uint64_t>("tree_kept");
+	ecs.component<StepTypeMetrics>()
+		.member<uint64_t>("count")
+		.member<uint64_t>("bytes");
+	ecs.add<EngineMetrics>();
+
+	// one gauge per member, one instance per entity with the component
+	ecs.metric("octopus::metrics::phase_ns").kind<flecs::metrics::Gauge>().member<PhaseMetrics>("last_ns")
+		.brief("duration of the phase in the last tick");
+	for(char const *member_l : {"steps", "path_queued", "path_computed", "path_backlog",
+		"spatial_queries", "tree_inserts", "tree_reinserts", "tree_kept"})
+	{
+		ecs.metric(("octopus::metrics::" + std::string(member_l)).c_str()).kind<flecs::metrics::Gauge>().member<EngineMetrics>(member_l);
+	}
+	ecs.metric("octopus::metrics::step_count").kind<flecs::metrics::Gauge>().member<StepTypeMetrics>("count")
+		.brief("steps of the type added in the last tick");
+
+	_steps_root = ecs.entity("octopus::metrics::step_types");
+
+	_phases.clear();
+	for(char const *name_l : phase_names)
+	{
+		_phases.push_back(ecs.entity(name_l).add<PhaseMetrics>());
+	}
+	_starts.resize(_phases.size());
+	_ran.resize(_phases.size(), false);
+	_max_ns.resize(_phases.size(), 0);
+
+	for(size_t i = 0 ; i < _phases.size() ; ++ i)
+	{
+		ecs.system<>(("octopus::metrics::" + std::string(phase_names[i])).c_str())
+			.kind(_phases[i])
+			.run([this, i](flecs::iter &) {
+				_starts[i] = clock::now();
+				_ran[i] = true;
+			});
+	}
+
+	for(size_t i = 0 ; i < size_t(EngineCounter::Count) ; ++ i)
+	{
+		_counters[i] = EngineCounters::total(EngineCounter(i));
+	}
+}
+
+void EngineMetricsCollector::end_tick(flecs::world &ecs, EngineMetrics &metrics_p, HistoryMemory const &steps_p)
+{
+	clock::time_point const end_l = clock::now();
+	for(size_t i = 0 ; i < _phases.size() ; ++ i)
+	{
+		uint64_t phase_l = 0;
+		if(_ran[i])
+		{
+			// next phase that ran this tick
+			clock::time_point phase_end_l = end_l;
+			for(size_t j = i + 1 ; j < _phases.size() ; ++ j)
+			{
+				if(_ran[j])
+				{
+					phase_end_l = _starts[j];
+					break;
+				}
+			}
+			phase_l = elapsed_ns(_starts[i], phase_end_l);
+		}
+		_max_ns[i] = std::max(_max_ns[i], phase_l);
+		_phases[i].mut(ecs).set<PhaseMetrics>({phase_l, _max_ns[i]});
+	}
+	std::fill(_ran.begin(), _ran.end(), false);
+
+	metrics_p.steps = steps_p.elements;
+	metrics_p.path_queued = counter_delta(_counters, EngineCounter::PathRequests);
+	metrics_p.spatial_queries = counter_delta(_counters, EngineCounter::SpatialQueries);
+	metrics_p.tree_inserts = counter_delta(_counters, EngineCounter::TreeInserts);
+	metrics_p.tree_reinserts = counter_delta(_counters, EngineCounter::TreeReinserts);
+	metrics_p.tree_kept = counter_delta(_counters, EngineCounter::TreeKept);
+
+	PathFindingCache const *cache_l = ecs.try_get<PathFindingCache>();
+	if(cache_l)
+	{
+		metrics_p.path_computed = cache_l->budget.runs;
+		metrics_p.path_backlog = cache_l->budget.backlog;
+	}
+
+	for(HistoryEntryMemory const &entry_l : steps_p.types)
+	{
+		flecs::entity &type_l = _step_types[entry_l.name];
+		if(!type_l)
+		{
+			type_l = ecs.entity().child_of(_steps_root).set_name(short_name(entry_l.name).c_str());
+		}
+		type_l.mut(ecs).set<StepTypeMetrics>({entry_l.elements, entry_l.bytes});
+	}
+}
+
+void enable_metrics_rest(flecs::world &ecs, uint16_t port_p)
+{
+	ecs.import<flecs::stats>();
+	flecs::Rest rest_l {};
+	rest_l.port = port_p;
+	// owned by the component
+	rest_l.ipaddr = ecs_os_strdup("127.0.0.1");
+	ecs.set<flecs::Rest>(std::move(rest_l));
+}
+
+void write_metrics_json(std::ostream &os_p, flecs::world const &ecs)
+{
+	os_p << "{\n  \"phases_ns\": {";
+	bool first_l = true;
+	for(char const *name_l : phase_names)
+	{
+		flecs::entity const phase_l = ecs.lookup(name_l);
+		PhaseMetrics const *metrics_l = phase_l ? phase_l.try_get<PhaseMetrics>() : nullptr;
+		if(!metrics_l) { continue; }
+		os_p << (first_l ? "\n" : ",\n") << "    \"" << name_l << "\": {"
+			<< "\"last\": " << metrics_l->last_ns
+			<< ", \"max\": " << metrics_l->max_ns << "}";
+		first_l = false;
+	}
+	os_p << "\n  },\n";
+
+	EngineMetrics const *engine_l = ecs.try_get<EngineMetrics>();
+	EngineMetrics const metrics_l = engine_l ? *engine_l : EngineMetrics();
+	os_p << "  \"engine\": {"
+		<< "\"steps\": " << metrics_l.steps
+		<< ", \"path_queued\": " << metrics_l.path_queued
+		<< ", \"path_computed\": " << metrics_l.path_computed
+		<< ", \"path_backlog\": " << metrics_l.path_backlog
+		<< ", \"spatial_queries\": " << metrics_l.spatial_queries
+		<< ", \"tree_inserts\": " << metrics_l.tree_inserts
+		<< ", \"tree_reinserts\": " << metrics_l.tree_reinserts
+		<< ", \"tree_kept\": " << metrics_l.tree_kept
+		<< "},\n";
+
+	os_p << "  \"steps\": {";
+	first_l = true;
+	ecs.each([&os_p, &first_l](flecs::entity e, StepTypeMetrics const &step_p) {
+		os_p << (first_l ? "\n" : ",\n") << "    \"" << e.name() << "\": {"
+			<< "\"count\": " << step_p.count
+			<< ", \"bytes\": " << step_p.bytes << "}";
+		first_l = false;
+	});
+	os_p << "\n  }\n}\n";
+}
+
+} // namespace octopus
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "flecs.h"
+
+#include "octopus/utils/metrics/EngineCounters.hh"
+#include "octopus/world/step/HistoryMemory.hh"
+
+namespace octopus
+{
+
+/// @brief duration of a phase (component of the phase entity)
+struct PhaseMetrics
+{
+	/// @brief duration in the last tick (0 if the phase did not run)
+	uint64_t last_ns = 0;
+	uint64_t max_ns = 0;
+};
+
+/// @brief engine counters of the last tick (singleton)
+struct EngineMetrics
+{
+	/// @brief steps added (every type)
+	uint64_t steps = 0;
+	/// @brief path requests queued, computed and left for the next ticks
+	uint64_t path_queued = 0;
+	uint64_t path_computed = 0;
+	uint64_t path_backlog = 0;
+	uint64_t spatial_queries = 0;
+	/// @brief tree update mode of the leaves : inserted, reinserted (out of their box) or kept
+	uint64_t tree_inserts = 0;
+	uint64_t tree_reinserts = 0;
+	uint64_t tree_kept = 0;
+};
+
+/// @brief steps of one type added in the last tick
+/// (component of the entity of the step type, child of octopus::metrics::step_types)
+struct StepTypeMetrics
+{
+	uint64_t count = 0;
+	uint64_t bytes = 0;
+};
+
+/// @brief Publish the engine health as flecs components and metrics
+/// - PhaseMetrics on every phase entity, timed by a marker system declared first in each phase
+/// - EngineMetrics singleton from the EngineCounters and the PathFindingCache
+/// - StepTypeMetrics per step type from the last step layer
+/// every member is a gauge metric (octopus::metrics::*) with one instance per entity,
+/// readable as flecs::metrics::Value and shown by the explorer when REST is enabled
+/// @note markers and the end of tick system capture this object which must not be moved
+class EngineMetricsCollector
+{
+public:
+	using clock = std::chrono::steady_clock;
+
+	/// @brief register the components (meta), the flecs metrics and the phase markers
+	/// @note must be called after set_up_phases and before any other system
+	void set_up(flecs::world &ecs);
+
+	/// @brief update the metric components
+	/// @param ecs world of the running system
+	/// @param steps_p steps of the last layer per type
+	void end_tick(flecs::world &ecs, EngineMetrics &metrics_p, HistoryMemory const &steps_p);
+
+	/// @brief steps of the last layer (filled by the end of tick system)
+	HistoryMemory steps_memory;
+
+private:
+	std::vector<flecs::entity> _phases;
+	std::vector<clock::time_point> _starts;
+	std::vector<bool> _ran;
+	std::vector<uint64_t> _max_ns;
+
+	/// @brief totals of the EngineCounters at the end of the previous tick
+	uint64_t _counters[size_t(EngineCounter::Count)] = {};
+
+	flecs::entity _steps_root;
+	std::map<std::string, flecs::entity> _step_types;
+};
+
+/// @brief serve the REST api (and the world statistics) on localhost
+/// for the flecs explorer
+void enable_metrics_rest(flecs::world &ecs, uint16_t port_p);
+
+/// @brief export the metric components (phases, engine counters and steps per type) as json
+void write_metrics_json(std::ostream &os_p, flecs::world const &ecs);
+
+} // namespace octopus
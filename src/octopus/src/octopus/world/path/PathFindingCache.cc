@@ -1,5 +1,7 @@
 #include "PathFindingCache.hh"
 #include "octopus/utils/log/Logger.hh"
+#include "octopus/utils/metrics/EngineCounters.hh"
+#include "octopus/utils/profiler/Profiler.hh"
 
 #include <algorithm>
 #include <set>
@@ -18,7 +20,7 @@ PathRequest PathFindingCache::get_request(Vector const &orig, Vector const &dest
 
 PathQuery PathFindingCache::query_path(Position const &pos, Vector const &target) const
 {
-	START_TIME(query_path)
+	OCTOPUS_ZONE("path_finding.query_path")
 
 	// skip if no sync
 	if(accessible.empty()) { return PathQuery(); }
@@ -29,7 +31,7 @@ PathQuery PathFindingCache::query_path(Position const &pos, Vector const &target
 	std::lock_guard<std::mutex> lock(mutex);
 	// enqueue request
 	list_requests.push_back(request);
-	END_TIME_PTR(query_path, stats)
+	EngineCounters::add(EngineCounter::PathRequests);
 	// return query
 	return PathQuery { this, request.orig, request.dest, pos.pos, target };
 }
@@ -142,8 +144,9 @@ std::vector<std::size_t> PathFindingCache::get_neighbors(std::size_t idx, std::s
 	return neighbors;
 }
 
-std::vector<std::size_t> PathFindingCache::compute_path(std::size_t orig, std::size_t dest) const
+std::vector<std::size_t> PathFindingCache::compute_path(std::size_t orig, std::size_t dest, std::size_t *expanded_p) const
 {
+	std::size_t expanded_l = 0;
 	// pointer to the labels list
 	std::set<Label const *, comparator_ptr<Label> > open_list_l;
 	// one label per node at most
@@ -164,6 +167,7 @@ std::vector<std::size_t> PathFindingCache::compute_path(std::size_t orig, std::s
 	{
 		Label const * cur_l = *open_list_l.begin();
 		open_list_l.erase(open_list_l.begin());
+		++expanded_l;
 		if(cur_l->node == dest)
 		{
 			break;
@@ -197,6 +201,10 @@ std::vector<std::size_t> PathFindingCache::compute_path(std::size_t orig, std::s
 		labels[cur_l->node].closed = true;
 		labels[cur_l->node].opened = false;
 	}
+	if(expanded_p)
+	{
+		*expanded_p = expanded_l;
+	}
 
 	std::size_t reached_target = dest;
 
@@ -219,10 +227,9 @@ std::vector<std::size_t> PathFindingCache::compute_path(std::size_t orig, std::s
 
 void PathFindingCache::compute_paths(flecs::world &ecs)
 {
-	START_TIME(path_finding)
-	std::size_t const max_run = 10;
-	std::size_t run = 0;
-	while(!list_requests.empty() && run < max_run)
+	OCTOPUS_ZONE("path_finding.compute_paths")
+	budget.begin_queue();
+	while(!list_requests.empty() && budget.has_budget())
 	{
 		PathRequest const &request = list_requests.front();
 		// check for calculation
@@ -233,7 +240,8 @@ void PathFindingCache::compute_paths(flecs::world &ecs)
 			continue;
 		}
 		// compute path
-		std::vector<std::size_t> path = compute_path(request.orig, request.dest);
+		std::size_t expanded = 0;
+		std::vector<std::size_t> path = compute_path(request.orig, request.dest, &expanded);
 		if(path.empty() || path[path.size()-1] != request.dest)
 		{
 			paths_info[request.dest].get_indexes(request.orig) = request.orig;
@@ -245,9 +253,9 @@ void PathFindingCache::compute_paths(flecs::world &ecs)
 
 		// tidy up computations
 		list_requests.pop_front();
-		++run;
+		budget.spend(expanded);
 	}
-	END_TIME_PTR(path_finding, stats)
+	budget.set_backlog(list_requests.size());
 }
 
 bool PathFindingCache::has_path(std::size_t orig, std::size_t dest) const
@@ -259,17 +267,15 @@ bool PathFindingCache::has_path(std::size_t orig, std::size_t dest) const
 	return false;
 }
 
-void PathFindingCache::declare_cache_update_system(flecs::world &ecs, TimeStats &st)
+void PathFindingCache::declare_cache_update_system(flecs::world &ecs)
 {
-	stats = &st;
-
 	// compute paths on each loop
 	ecs.system<>()
 		.kind(ecs.entity(PrepingUpdatePhase))
 		.run([this, &ecs](flecs::iter) {
-			// Logger::getDebug() << "compute_paths :: start"<<std::endl;
+			// OCTOPUS_LOG_DEBUG << "compute_paths :: start"<<std::endl;
 			compute_paths(ecs);
-			// Logger::getDebug() << "compute_paths :: done"<<std::endl;
+			// OCTOPUS_LOG_DEBUG << "compute_paths :: done"<<std::endl;
 		});
 }
 
@@ -308,7 +314,7 @@ bool PathQuery::is_valid() const
 
 Vector PathQuery::get_direction() const
 {
-	START_TIME(path_funnelling)
+	OCTOPUS_ZONE("path_finding.funnelling")
 	std::vector<std::size_t> path = cache->build_path(orig, dest);
 
 	if(path.size() <= 2) { return vert_dest - vert_orig; }
@@ -321,7 +327,6 @@ Vector PathQuery::get_direction() const
 		dir *= 100;
 	}
 
-	END_TIME_PTR(path_funnelling, cache->stats)
 	return dir;
 }
 
@@ -7,7 +7,7 @@
 #include "flecs.h"
 #include "octopus/components/basic/position/Position.hh"
 #include "octopus/systems/phases/Phases.hh"
-#include "octopus/world/stats/TimeStats.hh"
+#include "octopus/world/budget/WorkBudget.hh"
 
 namespace octopus
 {
@@ -95,14 +95,15 @@ struct PathFindingCache
 	/// @brief Simple getter for debug purpose
 	std::vector<PathsInfo> const &get_paths_info() const { return paths_info; }
 
-	/// @brief Compute paths
+	/// @brief Compute the queued requests in order while the
+	/// budget (in nodes expanded) is not spent
 	void compute_paths(flecs::world &ecs);
 
 	/// @brief Checks if a path has been computed between two indexes
 	bool has_path(std::size_t orig, std::size_t dest) const;
 
 	/// @brief Declare system to compute paths
-	void declare_cache_update_system(flecs::world &ecs, TimeStats &st);
+	void declare_cache_update_system(flecs::world &ecs);
 
 	/// @brief Sync with grid
 	/// @tparam Grid to be synced with
@@ -146,22 +147,29 @@ struct PathFindingCache
 	Vector get_position(std::size_t idx) const;
 	Vector get_coord(std::size_t idx) const;
 	std::size_t get_index(Vector const &pos) const;
+
+	/// @brief A* between two tiles (no caching, the cache must be synced)
+	/// @param expanded_p if not null set to the number of nodes expanded
+	std::vector<std::size_t> compute_path(std::size_t orig, std::size_t dest, std::size_t *expanded_p=nullptr) const;
+
+	/// @brief compute los between two position
+	bool losCheck(Vector const &pos1_p, Vector const &pos2_p) const;
+
+	/// @brief nodes expanded per step by compute_paths (0 for unlimited)
+	/// the request started always completes, the others wait for the next steps
+	/// @note attach it to the WorkScheduler to report it with the other channels
+	BudgetChannel budget {"path_finding", BudgetKind::Queue, 4096};
 private:
 	/// @brief Compute a path request based on vector positions
 	PathRequest get_request(Vector const &orig, Vector const &dest) const;
 
-	std::vector<std::size_t> compute_path(std::size_t orig, std::size_t dest) const;
 	std::vector<std::size_t> get_neighbors(std::size_t idx, std::size_t dest) const;
 
-	/// @brief compute los between two position
-	bool losCheck(Vector const &pos1_p, Vector const &pos2_p) const;
-
 	// grid properties
 	std::size_t nb_tiles_x = 0;
 	std::size_t nb_tiles = 0;
 	Fixed tile_size;
 
-	TimeStats *stats = nullptr;
 	/// @brief fill paths info from a path
 	void consolidate_path(std::vector<std::size_t> const &path);
 
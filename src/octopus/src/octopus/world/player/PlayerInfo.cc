@@ -1,10 +1,18 @@
 #include "PlayerInfo.hh"
+#include "PlayerRegistry.hh"
 
 namespace octopus
 {
 
 flecs::entity get_player_from_appartenance(flecs::entity e, flecs::world const &ecs)
 {
+	// use the registry when set up
+	if(ecs.try_get<PlayerRegistry>())
+	{
+		PlayerEntry const *entry = get_player_entry(e, ecs);
+		return entry ? entry->player : flecs::entity();
+	}
+
 	flecs::query<PlayerInfo> query_player = ecs.query<PlayerInfo>();
 
 	return query_player.find([&e](PlayerInfo& p) {
@@ -0,0 +1,113 @@
+#include "PlayerRegistry.hh"
+
+#include <cassert>
+#include <string>
+
+#include "PlayerInfo.hh"
+
+namespace octopus
+{
+
+void set_up_player_registry(flecs::world &ecs)
+{
+	if(ecs.try_get<PlayerRegistry>()) { return; }
+	ecs.add<PlayerRegistry>();
+	// register components referenced by the entries
+	ecs.component<ResourceStock>();
+	ecs.component<PlayerUpgrade>();
+	ecs.component<ReductionLibrary>();
+	ecs.component<ResourceSpent>();
+	ecs.component<PlayerGroup>().add(flecs::Exclusive);
+
+	ecs.observer<PlayerInfo const>()
+		.event(flecs::OnSet)
+		.yield_existing()
+		.each([&ecs](flecs::entity e, PlayerInfo const &info_p) {
+			PlayerRegistry &registry_l = *ecs.try_get_mut<PlayerRegistry>();
+			// remove previous registration under another index
+			for(PlayerEntry &entry_l : registry_l.players)
+			{
+				if(entry_l.player == e) { entry_l = PlayerEntry(); }
+			}
+			if(registry_l.players.size() <= info_p.idx)
+			{
+				registry_l.players.resize(info_p.idx+1);
+			}
+			flecs::entity player_l(ecs, e.id());
+			registry_l.players[info_p.idx] = {
+				player_l,
+				player_l.get_ref<ResourceStock>(),
+				player_l.get_ref<PlayerUpgrade>(),
+				player_l.get_ref<ReductionLibrary>(),
+				player_l.get_ref<ResourceSpent>()
+			};
+		});
+
+	ecs.observer<PlayerInfo const>()
+		.event(flecs::OnRemove)
+		.each([&ecs](flecs::entity e, PlayerInfo const &info_p) {
+			PlayerRegistry &registry_l = *ecs.try_get_mut<PlayerRegistry>();
+			if(info_p.idx < registry_l.players.size() && registry_l.players[info_p.idx].player == e)
+			{
+				registry_l.players[info_p.idx] = PlayerEntry();
+			}
+		});
+
+	// cache requirements satisfaction when upgrades are set outside of steps
+	ecs.observer<PlayerUpgrade>()
+		.event(flecs::OnSet)
+		.each([](PlayerUpgrade &upgrade_p) {
+			upgrade_p.sync_satisfied();
+		});
+
+	ecs.observer<PlayerAppartenance const>()
+		.event(flecs::OnSet)
+		.yield_existing()
+		.each([&ecs](flecs::entity e, PlayerAppartenance const &appartenance_p) {
+			flecs::entity group_l = get_player_group(ecs, appartenance_p.idx);
+			if(!e.has<PlayerGroup>(group_l))
+			{
+				e.add<PlayerGroup>(group_l);
+			}
+		});
+}
+
+flecs::entity get_player_group(flecs::world const &ecs, uint32_t idx)
+{
+	PlayerRegistry *registry_l = ecs.try_get_mut<PlayerRegistry>();
+	assert(registry_l);
+	if(registry_l->groups.size() <= idx)
+	{
+		registry_l->groups.resize(idx+1);
+	}
+	flecs::entity &group_l = registry_l->groups[idx];
+	if(!group_l.is_valid())
+	{
+		// named so that the relationship survives save and load
+		std::string const name_l = "player_group_" + std::to_string(idx);
+		group_l = ecs.lookup(name_l.c_str());
+		if(!group_l.is_valid())
+		{
+			group_l = ecs.entity(name_l.c_str());
+		}
+	}
+	return group_l;
+}
+
+PlayerEntry const *get_player_entry(flecs::world const &ecs, uint32_t idx)
+{
+	PlayerRegistry const *registry_l = ecs.try_get<PlayerRegistry>();
+	if(!registry_l || idx >= registry_l->players.size() || !registry_l->players[idx].player.is_valid())
+	{
+		return nullptr;
+	}
+	return &registry_l->players[idx];
+}
+
+PlayerEntry const *get_player_entry(flecs::entity e, flecs::world const &ecs)
+{
+	PlayerAppartenance const *appartenance_l = e.try_get<PlayerAppartenance>();
+	return appartenance_l ? get_player_entry(ecs, appartenance_l->idx) : nullptr;
+}
+
+} // namespace octopus
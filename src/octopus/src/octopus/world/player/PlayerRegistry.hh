@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "flecs.h"
+
+#include "octopus/components/basic/player/PlayerUpgrade.hh"
+#include "octopus/world/resources/CostReduction.hh"
+#include "octopus/world/resources/ResourceSpent.hh"
+#include "octopus/world/resources/ResourceStock.hh"
+
+namespace octopus
+{
+
+/// @brief player entity and references to its components
+/// @note references are updated lazily hence
+/// must not be accessed from multi threaded systems
+struct PlayerEntry
+{
+	flecs::entity player;
+	mutable flecs::ref<ResourceStock> resource_stock;
+	mutable flecs::ref<PlayerUpgrade> player_upgrade;
+	mutable flecs::ref<ReductionLibrary> reduction_library;
+	mutable flecs::ref<ResourceSpent> resource_spent;
+};
+
+/// @brief Singleton giving access to players by their index
+/// Kept in sync with PlayerInfo by observers so that it follows
+/// every creation and destruction of players (steps and rollback included)
+struct PlayerRegistry
+{
+	/// @brief indexed by PlayerInfo::idx
+	std::vector<PlayerEntry> players;
+	/// @brief group entities indexed by PlayerAppartenance::idx
+	std::vector<flecs::entity> groups;
+};
+
+/// @brief exclusive relationship from every entity with a
+/// PlayerAppartenance to the group entity of its player
+/// used to group queries by player (see get_player_group)
+struct PlayerGroup {};
+
+/// @brief add the registry singleton and the observers keeping it up to date
+void set_up_player_registry(flecs::world &ecs);
+
+/// @brief get the group entity of the player with the given index
+/// creating it if necessary, to be used with query.set_group
+/// @note queries must be built with group_by<PlayerGroup>()
+/// entities not grouped yet are in the group 0
+flecs::entity get_player_group(flecs::world const &ecs, uint32_t idx);
+
+/// @brief get the player entry from its index
+/// @return nullptr if there is no such player
+PlayerEntry const *get_player_entry(flecs::world const &ecs, uint32_t idx);
+
+/// @brief get the player entry of the player owning the entity
+/// @return nullptr if the entity has no PlayerAppartenance or no such player
+PlayerEntry const *get_player_entry(flecs::entity e, flecs::world const &ecs);
+
+} // namespace octopus
@@ -3,6 +3,7 @@
 #include <cassert>
 #include <set>
 #include "octopus/utils/aabb/aabb.hh"
+#include "octopus/utils/alloc/SizeClassPool.hh"
 
 namespace octopus
 {
@@ -29,10 +30,21 @@ std::vector<flecs::entity> get_closest_entities(
 		}
 	};
 
-	std::set<DistanceEntity> closest_l;
+	// nodes are recycled by the pool of the thread
+	using closest_t = std::set<DistanceEntity, std::less<DistanceEntity>, PoolAllocator<DistanceEntity> >;
+	closest_t closest_l;
 
+	// captured through one pointer to fit in the std::function buffer (no allocation)
+	struct QueryState {
+		size_t count;
+		Fixed const &range;
+		Position const &pos;
+		std::function<bool(flecs::entity const&)> const &filter;
+		closest_t &closest;
+	} state_l {n, max_range, pos_p, filter_p, closest_l};
 
-	std::function<bool(int32_t, flecs::entity)> func_l = [&](int32_t idx_l, flecs::entity e) -> bool {
+	std::function<bool(int32_t, flecs::entity)> func_l = [state_p = &state_l](int32_t idx_l, flecs::entity e) -> bool {
+		auto &[n, max_range, pos_p, filter_p, closest_l] = *state_p;
 		Position const *other_p = e.try_get<Position>();
 		Collision const *other_col_p = e.try_get<Collision>();
 		assert(other_p);
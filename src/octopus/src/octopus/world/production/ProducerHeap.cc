@@ -0,0 +1,36 @@
+#include "ProducerHeap.hh"
+
+#include <algorithm>
+
+namespace octopus
+{
+
+namespace
+{
+
+/// @brief comparator making the heap a min heap on (end, rank)
+bool later(ProducerSlot const &a, ProducerSlot const &b)
+{
+	if(a.end != b.end)
+	{
+		return a.end > b.end;
+	}
+	return a.rank > b.rank;
+}
+
+} // namespace
+
+void ProducerHeap::push(flecs::entity producer_p, int64_t end_p)
+{
+	slots.push_back({end_p, uint32_t(slots.size()), producer_p});
+	std::push_heap(slots.begin(), slots.end(), later);
+}
+
+void ProducerHeap::delay_top(int64_t duration_p)
+{
+	std::pop_heap(slots.begin(), slots.end(), later);
+	slots.back().end += duration_p;
+	std::push_heap(slots.begin(), slots.end(), later);
+}
+
+} // namespace octopus
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "flecs.h"
+
+namespace octopus
+{
+
+/// @brief producer and the tick at which its queue will be empty
+struct ProducerSlot
+{
+	int64_t end = 0;
+	/// @brief order of insertion used to break ties
+	uint32_t rank = 0;
+	flecs::entity producer;
+};
+
+/// @brief Min heap of the producers able to produce a production
+/// ordered by the end of their queue then by order of insertion
+/// used to dispatch a batch of productions over several producers
+struct ProducerHeap
+{
+	void push(flecs::entity producer_p, int64_t end_p);
+
+	bool empty() const { return slots.empty(); }
+
+	/// @brief producer whose queue ends first
+	flecs::entity top() const { return slots.front().producer; }
+
+	/// @brief delay the top producer once a production of the
+	/// given duration has been queued on it
+	void delay_top(int64_t duration_p);
+
+	std::vector<ProducerSlot> slots;
+};
+
+} // namespace octopus
@@ -6,10 +6,15 @@
 #include "octopus/components/basic/player/PlayerUpgrade.hh"
 #include "octopus/components/basic/player/UpgradeRequirement.hh"
 #include "octopus/utils/FixedPoint.hh"
+#include "octopus/utils/symbol/Symbol.hh"
 #include "octopus/world/player/PlayerInfo.hh"
+#include "octopus/world/resources/ResourceLedger.hh"
 
 namespace octopus
 {
+template<class StepManager_t>
+struct ProductionTemplateLibrary;
+
 /// @brief This class represent a template for a production
 /// entity, it can be a unit, an upgrade, or event a building
 template<class StepManager_t>
@@ -21,9 +26,23 @@ struct ProductionTemplate
     /// requirements to produce this template
     bool check_requirement(flecs::entity producer_p, flecs::world const &ecs) const
     {
+        if(_requirement != no_requirement_id)
+        {
+            return check_requirements(producer_p, ecs, _requirement)
+                && can_produce(producer_p, ecs);
+        }
         return check_requirements(producer_p, ecs, get_requirements())
             && can_produce(producer_p, ecs);
     }
+    /// @brief Return the list of unmet requirements for the given player
+    std::vector<std::string> explain_unmet_requirements(flecs::entity producer_p, flecs::world const &ecs) const
+    {
+        if(_requirement != no_requirement_id)
+        {
+            return octopus::explain_unmet_requirements(producer_p, ecs, _requirement);
+        }
+        return octopus::explain_unmet_requirements(producer_p, ecs, get_requirements());
+    }
     /// @brief Return true if the producer can produce the production
     /// @remark this is useful when something can only be produced once (exemple an upgrade)
     virtual bool can_produce(flecs::entity producer_p, flecs::world const &ecs) const { return true; }
@@ -50,10 +69,20 @@ struct ProductionTemplate
     virtual void dequeue(flecs::entity producer_p, flecs::world const &ecs, StepManager_t &manager_p) const = 0;
     /// @brief return a unique name for this production
     virtual std::string name() const = 0;
+    /// @brief interned name, set when added to the library
+    Symbol const &symbol() const { return _symbol; }
+    /// @brief resource_consumption by resource index, set when added to the library
+    DenseCost const &dense_cost() const { return _dense_cost; }
     /// @brief This is the duration (in steps) during which
     /// the production will be the current element of the queue
     /// before being produced.
     virtual int64_t duration() const = 0;
+private:
+    Symbol _symbol;
+    DenseCost _dense_cost;
+    RequirementId _requirement = no_requirement_id;
+
+    friend struct ProductionTemplateLibrary<StepManager_t>;
 };
 
 } // namespace octopus
@@ -2,6 +2,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include "ProductionTemplate.hh"
 
 namespace octopus
@@ -12,9 +13,18 @@ struct ProductionTemplateLibrary
 {
 public:
 
+    /// @brief add the template and intern its name
     void add_template(ProductionTemplate<StepManager_t>* template_p)
     {
+        template_p->_symbol = Symbol(template_p->name());
+        template_p->_requirement = register_requirement(template_p->get_requirements());
+        template_p->_dense_cost = make_dense_cost(template_p->resource_consumption());
         _templates[template_p->name()] = template_p;
+        if(_templates_by_symbol.size() <= template_p->_symbol.id)
+        {
+            _templates_by_symbol.resize(template_p->_symbol.id+1, nullptr);
+        }
+        _templates_by_symbol[template_p->_symbol.id] = template_p;
     }
 
     ProductionTemplate<StepManager_t> const &get(std::string const &id_p) const
@@ -28,6 +38,16 @@ public:
         return it != _templates.cend() ? it->second : nullptr;
     }
 
+    ProductionTemplate<StepManager_t> const &get(Symbol const &id_p) const
+    {
+        return *_templates_by_symbol.at(id_p.id);
+    }
+
+    ProductionTemplate<StepManager_t> const *try_get(Symbol const &id_p) const
+    {
+        return id_p.id < _templates_by_symbol.size() ? _templates_by_symbol[id_p.id] : nullptr;
+    }
+
     void clean_up()
     {
         for(auto &&pair_l : _templates)
@@ -35,17 +55,22 @@ public:
             delete pair_l.second;
         }
         _templates.clear();
+        _templates_by_symbol.clear();
     }
 
 private:
     std::unordered_map<std::string, ProductionTemplate<StepManager_t>*> _templates;
+    /// @brief templates indexed by the id of their symbol
+    std::vector<ProductionTemplate<StepManager_t>*> _templates_by_symbol;
 };
 
+/// @brief sum of the durations of the productions of the queue
+/// @note ProductionQueue::queue_duration caches this value
 template<class StepManager_t>
-int64_t get_queue_duration(ProductionTemplateLibrary<StepManager_t> const &library, std::vector<std::string> const &queue)
+int64_t get_queue_duration(ProductionTemplateLibrary<StepManager_t> const &library, std::vector<Symbol> const &queue)
 {
     int64_t duration = 0;
-    for(std::string const &prod : queue)
+    for(Symbol const &prod : queue)
     {
         ProductionTemplate<StepManager_t> const * prod_template = library.try_get(prod);
         if(prod_template)
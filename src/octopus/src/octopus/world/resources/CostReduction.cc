@@ -1,5 +1,7 @@
 #include "CostReduction.hh"
 
+#include "ResourceLedger.hh"
+
 namespace octopus
 {
 
@@ -9,12 +11,46 @@ void ReductionLibraryStep::apply_step(Data &d, Memento &memento) const
 	memento.production = production;
 	memento.quantity = d.reductions[production].reduction[resource];
 
-	d.reductions[production].reduction[resource] += delta;
+	Fixed &reduction_l = d.reductions[production].reduction[resource];
+	reduction_l += delta;
+	d.set_reduction(Symbol(production), resource_index(resource), reduction_l);
 }
 
 void ReductionLibraryStep::revert_step(Data &d, Memento const &memento) const
 {
 	d.reductions[production].reduction[resource] = memento.quantity;
+	d.set_reduction(Symbol(production), resource_index(resource), memento.quantity);
+}
+
+Fixed ReductionLibrary::get_reduction(Symbol const &production_p, uint32_t resource_p) const
+{
+	if(production_p.id >= dense.size())
+	{
+		return Fixed::Zero();
+	}
+	return get_dense(dense[production_p.id], resource_p);
+}
+
+void ReductionLibrary::set_reduction(Symbol const &production_p, uint32_t resource_p, Fixed const &value_p)
+{
+	if(dense.size() <= production_p.id)
+	{
+		dense.resize(production_p.id+1);
+	}
+	set_dense(dense[production_p.id], resource_p, value_p);
+}
+
+void ReductionLibrary::sync_dense()
+{
+	dense.clear();
+	for(auto &&production_l : reductions.data())
+	{
+		Symbol const symbol_l(production_l.first);
+		for(auto &&resource_l : production_l.second.reduction.data())
+		{
+			set_reduction(symbol_l, resource_index(resource_l.first), resource_l.second);
+		}
+	}
 }
 
 std::unordered_map<std::string, Fixed> get_required_resources(
@@ -2,9 +2,11 @@
 
 #include <cstdint>
 #include <unordered_map>
+#include <vector>
 #include "octopus/utils/FixedPoint.hh"
 #include "octopus/utils/fast_map/fast_map.hh"
 #include "ResourceInfo.hh"
+#include "octopus/utils/symbol/Symbol.hh"
 
 namespace octopus
 {
@@ -19,6 +21,21 @@ struct CostReduction
 struct ReductionLibrary
 {
 	fast_map<std::string, CostReduction> reductions;
+
+	/// @brief reductions indexed by the symbol id of the production
+	/// then by resource_index (see ResourceLedger)
+	/// kept up to date by ReductionLibraryStep and on set
+	/// @note not serialized
+	std::vector<std::vector<Fixed> > dense;
+
+	/// @brief reduction of the resource for the production (zero if none)
+	Fixed get_reduction(Symbol const &production_p, uint32_t resource_p) const;
+
+	/// @brief update the dense reduction of the resource for the production
+	void set_reduction(Symbol const &production_p, uint32_t resource_p, Fixed const &value_p);
+
+	/// @brief rebuild dense from reductions
+	void sync_dense();
 };
 
 struct ReductionLibraryMemento {
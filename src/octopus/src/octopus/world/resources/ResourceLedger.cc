@@ -0,0 +1,153 @@
+#include "ResourceLedger.hh"
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+
+#include "CostReduction.hh"
+#include "ResourceSpent.hh"
+#include "ResourceStock.hh"
+#include "octopus/world/player/PlayerRegistry.hh"
+
+namespace octopus
+{
+
+namespace
+{
+
+/// @brief names of the resources and their indexes
+/// deque is used to keep references on names valid when registering
+struct ResourceTable
+{
+	std::mutex mutex;
+	std::deque<std::string> names;
+	std::unordered_map<std::string, uint32_t> indexes;
+};
+
+ResourceTable &get_table()
+{
+	static ResourceTable table_l;
+	return table_l;
+}
+
+} // namespace
+
+uint32_t resource_index(std::string const &resource_p)
+{
+	ResourceTable &table_l = get_table();
+	std::lock_guard<std::mutex> lock_l(table_l.mutex);
+	auto &&it = table_l.indexes.find(resource_p);
+	if(it != table_l.indexes.cend())
+	{
+		return it->second;
+	}
+	uint32_t index_l = table_l.names.size();
+	table_l.names.push_back(resource_p);
+	table_l.indexes[resource_p] = index_l;
+	return index_l;
+}
+
+std::string const &resource_name(uint32_t index_p)
+{
+	ResourceTable &table_l = get_table();
+	std::lock_guard<std::mutex> lock_l(table_l.mutex);
+	return table_l.names.at(index_p);
+}
+
+DenseCost make_dense_cost(std::unordered_map<std::string, Fixed> const &cost_p)
+{
+	DenseCost dense_l;
+	dense_l.reserve(cost_p.size());
+	for(auto &&pair_l : cost_p)
+	{
+		dense_l.push_back({resource_index(pair_l.first), pair_l.second});
+	}
+	std::sort(dense_l.begin(), dense_l.end(), [](ResourceAmount const &a, ResourceAmount const &b) {
+		return a.resource < b.resource;
+	});
+	return dense_l;
+}
+
+void set_dense(std::vector<Fixed> &dense_p, uint32_t index_p, Fixed const &value_p)
+{
+	if(dense_p.size() <= index_p)
+	{
+		dense_p.resize(index_p+1, Fixed::Zero());
+	}
+	dense_p[index_p] = value_p;
+}
+
+Fixed get_dense(std::vector<Fixed> const &dense_p, uint32_t index_p)
+{
+	return index_p < dense_p.size() ? dense_p[index_p] : Fixed::Zero();
+}
+
+Fixed ResourceLedger::available(uint32_t resource_p) const
+{
+	Fixed available_l = stock ? get_dense(stock->dense, resource_p) : Fixed::Zero();
+	if(spent)
+	{
+		available_l -= get_dense(spent->dense, resource_p);
+	}
+	return available_l;
+}
+
+Fixed ResourceLedger::price(Symbol const &action_p, ResourceAmount const &amount_p) const
+{
+	if(reductions)
+	{
+		return amount_p.quantity - reductions->get_reduction(action_p, amount_p.resource);
+	}
+	return amount_p.quantity;
+}
+
+bool ResourceLedger::can_afford(Symbol const &action_p, DenseCost const &cost_p) const
+{
+	for(ResourceAmount const &amount_l : cost_p)
+	{
+		if(available(amount_l.resource) < price(action_p, amount_l))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+ResourceLedger get_resource_ledger(PlayerEntry const *entry_p)
+{
+	if(!entry_p)
+	{
+		return ResourceLedger();
+	}
+	return {
+		entry_p->resource_stock.try_get(),
+		entry_p->resource_spent.try_get(),
+		entry_p->reduction_library.try_get()
+	};
+}
+
+void get_affordable(ResourceLedger const &ledger_p, std::vector<LedgerQuery> const &queries_p, std::vector<bool> &result_p)
+{
+	result_p.resize(queries_p.size());
+	for(size_t i = 0 ; i < queries_p.size() ; ++ i)
+	{
+		result_p[i] = queries_p[i].cost && ledger_p.can_afford(queries_p[i].action, *queries_p[i].cost);
+	}
+}
+
+void set_up_resource_ledger(flecs::world &ecs)
+{
+	ecs.observer<ResourceStock>()
+		.event(flecs::OnSet)
+		.each([](ResourceStock &stock_p) {
+			stock_p.sync_dense();
+		});
+
+	ecs.observer<ReductionLibrary>()
+		.event(flecs::OnSet)
+		.each([](ReductionLibrary &library_p) {
+			library_p.sync_dense();
+		});
+}
+
+} // namespace octopus
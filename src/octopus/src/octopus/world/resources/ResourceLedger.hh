@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "flecs.h"
+
+#include "octopus/utils/FixedPoint.hh"
+#include "octopus/utils/symbol/Symbol.hh"
+
+namespace octopus
+{
+
+struct PlayerEntry;
+struct ReductionLibrary;
+struct ResourceSpent;
+struct ResourceStock;
+
+/// @brief dense index of a resource, process wide
+/// resources are registered on first use
+uint32_t resource_index(std::string const &resource_p);
+
+/// @brief name of the resource from its dense index
+std::string const &resource_name(uint32_t index_p);
+
+/// @brief quantity of a resource given by its dense index
+struct ResourceAmount
+{
+	uint32_t resource = 0;
+	Fixed quantity;
+};
+
+/// @brief resources required by an action sorted by dense index
+using DenseCost = std::vector<ResourceAmount>;
+
+DenseCost make_dense_cost(std::unordered_map<std::string, Fixed> const &cost_p);
+
+/// @brief set the value at the given index, growing the vector if necessary
+void set_dense(std::vector<Fixed> &dense_p, uint32_t index_p, Fixed const &value_p);
+
+/// @brief return the value at the given index or zero
+Fixed get_dense(std::vector<Fixed> const &dense_p, uint32_t index_p);
+
+/// @brief Read only view on the resources of a player
+/// relying on the dense mirrors of ResourceStock, ResourceSpent
+/// and ReductionLibrary which are updated by their steps
+/// so that checks are only a few comparisons
+/// @note any of the pointers may be null (treated as empty)
+struct ResourceLedger
+{
+	ResourceStock const *stock = nullptr;
+	ResourceSpent const *spent = nullptr;
+	ReductionLibrary const *reductions = nullptr;
+
+	/// @brief stock minus locked resources
+	Fixed available(uint32_t resource_p) const;
+
+	/// @brief cost of the resource for the action once reduced
+	Fixed price(Symbol const &action_p, ResourceAmount const &amount_p) const;
+
+	/// @brief return true if every resource of the reduced cost is available
+	bool can_afford(Symbol const &action_p, DenseCost const &cost_p) const;
+};
+
+/// @brief build the ledger of the player (empty if no entry)
+ResourceLedger get_resource_ledger(PlayerEntry const *entry_p);
+
+/// @brief an action to check in a batch
+struct LedgerQuery
+{
+	Symbol action;
+	DenseCost const *cost = nullptr;
+};
+
+/// @brief check all queries at once (meant for ui polling)
+/// @param result_p filled with one boolean per query
+void get_affordable(ResourceLedger const &ledger_p, std::vector<LedgerQuery> const &queries_p, std::vector<bool> &result_p);
+
+/// @brief observers syncing the dense mirrors when components
+/// are set outside of steps (creation, loading)
+void set_up_resource_ledger(flecs::world &ecs);
+
+} // namespace octopus
@@ -13,6 +13,7 @@ void set_up_resource_spent_system(flecs::world &ecs)
 		.each([](flecs::entity e, ResourceSpent &spent)
 	{
 		spent.resources_spent.clear();
+		spent.dense.clear();
 	});
 
 	ecs.system<>()
@@ -4,6 +4,7 @@
 
 #include <unordered_map>
 #include <string>
+#include <vector>
 
 #include "octopus/utils/FixedPoint.hh"
 
@@ -16,6 +17,8 @@ namespace octopus
 struct ResourceSpent
 {
 	std::unordered_map<std::string, Fixed> resources_spent;
+	/// @brief resources_spent indexed by resource_index (see ResourceLedger)
+	std::vector<Fixed> dense;
 };
 
 void set_up_resource_spent_system(flecs::world &ecs);
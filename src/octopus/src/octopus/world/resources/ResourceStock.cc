@@ -8,11 +8,22 @@ void ResourceStockStep::apply_step(Data &d, Memento &memento) const
 	memento.resource = resource;
 	memento.quantity = d.resource[resource].quantity;
 	d.resource[resource].quantity += delta;
+	set_dense(d.dense, resource_index(resource), d.resource[resource].quantity);
 }
 
 void ResourceStockStep::revert_step(Data &d, Memento const &memento) const
 {
 	d.resource[memento.resource].quantity = memento.quantity;
+	set_dense(d.dense, resource_index(memento.resource), memento.quantity);
+}
+
+void ResourceStock::sync_dense()
+{
+	dense.clear();
+	for(auto &&pair_l : resource.data())
+	{
+		set_dense(dense, resource_index(pair_l.first), pair_l.second.quantity);
+	}
 }
 
 Fixed get_resource_quantity(std::string const &resource_p, std::unordered_map<std::string, Fixed> const &map_p)
@@ -5,6 +5,7 @@
 #include "octopus/utils/FixedPoint.hh"
 #include "octopus/utils/fast_map/fast_map.hh"
 #include "ResourceInfo.hh"
+#include "ResourceLedger.hh"
 #include "ResourceSpent.hh"
 
 namespace octopus
@@ -13,8 +14,16 @@ namespace octopus
 struct ResourceStock
 {
 	ResourceStock() = default;
-	ResourceStock(std::unordered_map<std::string, ResourceInfo> const &map_p) : resource(map_p) {}
+	ResourceStock(std::unordered_map<std::string, ResourceInfo> const &map_p) : resource(map_p) { sync_dense(); }
 	fast_map<std::string, ResourceInfo> resource;
+
+	/// @brief quantities indexed by resource_index (see ResourceLedger)
+	/// kept up to date by ResourceStockStep and on set
+	/// @note not serialized
+	std::vector<Fixed> dense;
+
+	/// @brief rebuild dense from resource
+	void sync_dense();
 };
 
 struct ResourceStockMemento {
@@ -47,7 +56,9 @@ void spend_resources(StepManager &manager, ResourceSpent *spent, flecs::entity e
 	manager.get_last_layer().back().template get<ResourceStockStep>().add_step(e, {-amount, resource});
 	if(spent)
 	{
-		spent->resources_spent[resource] += amount;
+		Fixed &spent_l = spent->resources_spent[resource];
+		spent_l += amount;
+		set_dense(spent->dense, resource_index(resource), spent_l);
 	}
 }
 
@@ -0,0 +1,111 @@
+#include "HistoryMemory.hh"
+
+#include <algorithm>
+
+namespace octopus
+{
+
+void HistoryMemory::clear()
+{
+	types.clear();
+	layers.clear();
+	elements = 0;
+	bytes = 0;
+}
+
+void HistoryMemory::add(std::string const &type_p, size_t age_p, uint64_t elements_p, uint64_t bytes_p)
+{
+	auto it_l = std::lower_bound(types.begin(), types.end(), type_p, [](HistoryEntryMemory const &entry_p, std::string const &name_p) {
+		return entry_p.name < name_p;
+	});
+	if(it_l == types.end() || it_l->name != type_p)
+	{
+		it_l = types.insert(it_l, HistoryEntryMemory {type_p, 0, 0});
+	}
+	it_l->elements += elements_p;
+	it_l->bytes += bytes_p;
+
+	if(layers.size() <= age_p)
+	{
+		layers.resize(age_p + 1);
+	}
+	layers[age_p].elements += elements_p;
+	layers[age_p].bytes += bytes_p;
+
+	elements += elements_p;
+	bytes += bytes_p;
+}
+
+HistoryEntryMemory const *HistoryMemory::find(std::string const &type_p) const
+{
+	auto it_l = std::lower_bound(types.begin(), types.end(), type_p, [](HistoryEntryMemory const &entry_p, std::string const &name_p) {
+		return entry_p.name < name_p;
+	});
+	if(it_l == types.end() || it_l->name != type_p)
+	{
+		return nullptr;
+	}
+	return &*it_l;
+}
+
+size_t history_heap_bytes(std::string const &str_p)
+{
+	// small strings are stored in the string itself
+	char const *begin_l = reinterpret_cast<char const *>(&str_p);
+	if(str_p.data() >= begin_l && str_p.data() < begin_l + sizeof(str_p))
+	{
+		return 0;
+	}
+	return str_p.capacity() + 1;
+}
+
+size_t history_heap_bytes(ResourceStockStep const &step_p)
+{
+	return history_heap_bytes(step_p.resource);
+}
+
+size_t history_heap_bytes(ResourceStockMemento const &memento_p)
+{
+	return history_heap_bytes(memento_p.resource);
+}
+
+size_t history_heap_bytes(ReductionLibraryStep const &step_p)
+{
+	return history_heap_bytes(step_p.resource) + history_heap_bytes(step_p.production);
+}
+
+size_t history_heap_bytes(ReductionLibraryMemento const &memento_p)
+{
+	return history_heap_bytes(memento_p.resource) + history_heap_bytes(memento_p.production);
+}
+
+size_t history_heap_bytes(ComponentStepTuple const &tuple_p)
+{
+	return tuple_p.step.base ? tuple_p.step.base->footprint() : 0;
+}
+
+void account_history(HistoryMemory &memory_p, ComponentStepContainer const &container_p, size_t age_p)
+{
+	uint64_t bytes_l = container_p.steps.capacity() * sizeof(ComponentStepTuple);
+	for(ComponentStepTuple const &tuple_l : container_p.steps)
+	{
+		bytes_l += history_heap_bytes(tuple_l);
+	}
+	memory_p.add("octopus::ComponentStep", age_p, container_p.steps.size(), bytes_l);
+}
+
+void account_history(HistoryMemory &memory_p, StepEntityManager const &manager_p)
+{
+	size_t age_l = manager_p.creation_steps.size();
+	for(std::vector<EntityCreationStep> const &steps_l : manager_p.creation_steps)
+	{
+		memory_p.add("octopus::EntityCreationStep", --age_l, steps_l.size(), steps_l.capacity() * sizeof(EntityCreationStep));
+	}
+	age_l = manager_p.creation_steps_memento.size();
+	for(std::vector<EntityCreationMemento> const &mementos_l : manager_p.creation_steps_memento)
+	{
+		memory_p.add("octopus::EntityCreationMemento", --age_l, mementos_l.size(), mementos_l.capacity() * sizeof(EntityCreationMemento));
+	}
+}
+
+} // namespace octopus
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "flecs.h"
+
+#include "octopus/commands/queue/CommandQueue.hh"
+#include "octopus/commands/step/StateChangeSteps.hh"
+#include "octopus/world/StepContext.hh"
+#include "octopus/world/step/StepEntityManager.hh"
+
+namespace octopus
+{
+
+/// @brief memory held by one type of history entry
+struct HistoryEntryMemory
+{
+	std::string name;
+	uint64_t elements = 0;
+	uint64_t bytes = 0;
+};
+
+/// @brief memory held by the histories for one step
+struct HistoryLayerMemory
+{
+	uint64_t elements = 0;
+	uint64_t bytes = 0;
+};
+
+/// @brief Memory held by the histories kept for rollback (StepManager,
+/// StateStepContainer, CommandQueueMementoManager and StepEntityManager)
+/// per entry type and per layer.
+/// Bytes include the unused capacity of the vectors and the heap held by
+/// the entries (strings, replaced command lists, type erased component steps)
+/// @note singleton refreshed by set_up_history_memory_system
+struct HistoryMemory
+{
+	/// @brief sorted by name
+	std::vector<HistoryEntryMemory> types;
+	/// @brief newest layer first, the n first layers are
+	/// the memory required to revert n steps
+	std::vector<HistoryLayerMemory> layers;
+	uint64_t elements = 0;
+	uint64_t bytes = 0;
+
+	void clear();
+	/// @param age_p age of the layer (0 for the newest)
+	void add(std::string const &type_p, size_t age_p, uint64_t elements_p, uint64_t bytes_p);
+	/// @brief nullptr if no entry of this type is kept
+	HistoryEntryMemory const *find(std::string const &type_p) const;
+};
+
+/// @brief heap held by the string (0 when stored inline)
+size_t history_heap_bytes(std::string const &str_p);
+size_t history_heap_bytes(ResourceStockStep const &step_p);
+size_t history_heap_bytes(ResourceStockMemento const &memento_p);
+size_t history_heap_bytes(ReductionLibraryStep const &step_p);
+size_t history_heap_bytes(ReductionLibraryMemento const &memento_p);
+size_t history_heap_bytes(ComponentStepTuple const &tuple_p);
+
+/// @brief steps and mementos holding no heap
+template<typename T>
+size_t history_heap_bytes(T const &)
+{
+	return 0;
+}
+
+template<typename T>
+void account_history(HistoryMemory &memory_p, StepVector<T> const &vector_p, size_t age_p)
+{
+	uint64_t bytes_l = vector_p.steps.capacity() * sizeof(StepTuple<T>);
+	// only steps or mementos with a destructor may hold heap
+	if constexpr(!std::is_trivially_destructible<T>::value || !std::is_trivially_destructible<typename T::Memento>::value)
+	{
+		for(StepTuple<T> const &tuple_l : vector_p.steps)
+		{
+			bytes_l += history_heap_bytes(tuple_l.step) + history_heap_bytes(tuple_l.memento);
+		}
+	}
+	memory_p.add(flecs::_::type_name<T>(), age_p, vector_p.steps.size(), bytes_l);
+}
+
+template<class... Ts> void account_history(HistoryMemory &, StepContainerCascade<Ts...> const &, size_t) {}
+template<class T, class... Ts> void account_history(HistoryMemory &memory_p, StepContainerCascade<T, Ts...> const &container_p, size_t age_p)
+{
+	account_history(memory_p, container_p.steps, age_p);
+	// cascade
+	StepContainerCascade<Ts...> const &base = container_p;
+	account_history(memory_p, base, age_p);
+}
+
+template<class Layer_t>
+void account_history(HistoryMemory &memory_p, std::vector<Layer_t> const &layer_p, size_t age_p)
+{
+	for(Layer_t const &container_l : layer_p)
+	{
+		account_history(memory_p, container_l, age_p);
+	}
+}
+
+void account_history(HistoryMemory &memory_p, ComponentStepContainer const &container_p, size_t age_p);
+
+template<typename... Ts>
+void account_history(HistoryMemory &memory_p, StepManager<Ts...> const &manager_p)
+{
+	// every list has one layer per step
+	size_t age_l = manager_p.steps.size();
+	auto it_steps_l = manager_p.steps.begin();
+	auto it_presteps_l = manager_p.presteps.begin();
+	auto it_component_steps_l = manager_p.component_steps.begin();
+	for( ; it_steps_l != manager_p.steps.end() ; ++ it_steps_l, ++ it_presteps_l, ++ it_component_steps_l)
+	{
+		--age_l;
+		account_history(memory_p, *it_steps_l, age_l);
+		account_history(memory_p, *it_presteps_l, age_l);
+		account_history(memory_p, *it_component_steps_l, age_l);
+	}
+}
+
+template<typename variant_t>
+void account_history(HistoryMemory &memory_p, StateStepLayer<variant_t> const &layer_p, size_t age_p)
+{
+	memory_p.add("octopus::StateAddPairStep", age_p, layer_p._addPair.size(),
+		layer_p._addPair.capacity() * sizeof(StateAddPairStep<variant_t>));
+	memory_p.add("octopus::StateRemovePairStep", age_p, layer_p._removePair.size(),
+		layer_p._removePair.capacity() * sizeof(StateRemovePairStep<variant_t>));
+	memory_p.add("octopus::StateSetComponentStep", age_p, layer_p._setComp.size(),
+		layer_p._setComp.capacity() * sizeof(StateSetComponentStep<variant_t>));
+}
+
+template<typename variant_t>
+void account_history(HistoryMemory &memory_p, StateStepContainer<variant_t> const &container_p)
+{
+	size_t age_l = container_p.layers.size();
+	for(StateStepLayer<variant_t> const &layer_l : container_p.layers)
+	{
+		account_history(memory_p, layer_l, --age_l);
+	}
+	age_l = container_p.prelayers.size();
+	for(StateStepLayer<variant_t> const &layer_l : container_p.prelayers)
+	{
+		account_history(memory_p, layer_l, --age_l);
+	}
+}
+
+template<typename variant_t>
+void account_history(HistoryMemory &memory_p, CommandQueueMementoManager<variant_t> const &manager_p)
+{
+	size_t age_l = manager_p.lMementos.size();
+	for(auto const &mementos_l : manager_p.lMementos)
+	{
+		// unused capacity of the vector
+		uint64_t bytes_l = (mementos_l.capacity() - mementos_l.size()) * sizeof(CommandQueueMemento<variant_t>);
+		for(CommandQueueMemento<variant_t> const &memento_l : mementos_l)
+		{
+			bytes_l += memory_footprint(memento_l);
+		}
+		memory_p.add("octopus::CommandQueueMemento", --age_l, mementos_l.size(), bytes_l);
+	}
+}
+
+void account_history(HistoryMemory &memory_p, StepEntityManager const &manager_p);
+
+} // namespace octopus
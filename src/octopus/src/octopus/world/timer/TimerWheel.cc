@@ -0,0 +1,132 @@
+#include "TimerWheel.hh"
+
+#include <algorithm>
+
+namespace octopus
+{
+
+bool operator==(Timer const &a, Timer const &b)
+{
+	return a.expiry == b.expiry && a.kind == b.kind && a.entity.id() == b.entity.id();
+}
+
+bool operator<(Timer const &a, Timer const &b)
+{
+	if(a.expiry != b.expiry) { return a.expiry < b.expiry; }
+	if(a.kind != b.kind) { return a.kind < b.kind; }
+	return a.entity.id() < b.entity.id();
+}
+
+namespace
+{
+
+std::vector<Timer> *get_slot(TimerWheel &wheel_p, int64_t expiry_p)
+{
+	if(expiry_p <= 0)
+	{
+		return &wheel_p.immediate;
+	}
+	if(wheel_p.slots.size() != TimerWheel::nb_slots)
+	{
+		wheel_p.slots.resize(TimerWheel::nb_slots);
+	}
+	return &wheel_p.slots[uint64_t(expiry_p) % TimerWheel::nb_slots];
+}
+
+} // namespace
+
+void TimerWheel::add(Timer const &timer_p)
+{
+	std::vector<Timer> &slot_l = *get_slot(*this, timer_p.expiry);
+	slot_l.insert(std::upper_bound(slot_l.begin(), slot_l.end(), timer_p), timer_p);
+}
+
+bool TimerWheel::remove(Timer const &timer_p)
+{
+	std::vector<Timer> &slot_l = *get_slot(*this, timer_p.expiry);
+	auto &&it = std::lower_bound(slot_l.begin(), slot_l.end(), timer_p);
+	if(it == slot_l.end() || !(*it == timer_p))
+	{
+		return false;
+	}
+	slot_l.erase(it);
+	return true;
+}
+
+void TimerWheel::get_due(int64_t time_p, std::vector<Timer> &due_p) const
+{
+	size_t const first_l = due_p.size();
+	due_p.insert(due_p.end(), immediate.begin(), immediate.end());
+	if(slots.size() == nb_slots)
+	{
+		std::vector<Timer> const &slot_l = slots[uint64_t(time_p) % nb_slots];
+		for(Timer const &timer_l : slot_l)
+		{
+			if(timer_l.expiry > time_p) { break; }
+			if(timer_l.expiry == time_p)
+			{
+				due_p.push_back(timer_l);
+			}
+		}
+	}
+	std::sort(due_p.begin()+first_l, due_p.end(), [](Timer const &a, Timer const &b) {
+		if(a.kind != b.kind) { return a.kind < b.kind; }
+		if(a.entity.id() != b.entity.id()) { return a.entity.id() < b.entity.id(); }
+		return a.expiry < b.expiry;
+	});
+}
+
+size_t TimerWheel::size() const
+{
+	size_t size_l = immediate.size();
+	for(std::vector<Timer> const &slot_l : slots)
+	{
+		size_l += slot_l.size();
+	}
+	return size_l;
+}
+
+void TimerStep::apply_step(Data &d, Memento &memento) const
+{
+	if(add)
+	{
+		d.add(timer);
+		memento.done = true;
+	}
+	else
+	{
+		memento.done = d.remove(timer);
+	}
+}
+
+void TimerStep::revert_step(Data &d, Memento const &memento) const
+{
+	if(!memento.done) { return; }
+	if(add)
+	{
+		d.remove(timer);
+	}
+	else
+	{
+		d.add(timer);
+	}
+}
+
+std::vector<flecs::entity> get_due_entities(flecs::world const &ecs, uint32_t kind_p)
+{
+	std::vector<flecs::entity> entities_l;
+	DueTimers const *due_l = ecs.try_get<DueTimers>();
+	if(!due_l) { return entities_l; }
+	for(Timer const &timer_l : due_l->timers)
+	{
+		if(timer_l.kind == kind_p)
+		{
+			entities_l.push_back(timer_l.entity);
+		}
+	}
+	// timers are sorted by kind then entity
+	entities_l.erase(std::unique(entities_l.begin(), entities_l.end()), entities_l.end());
+	return entities_l;
+}
+
+} // namespace octopus
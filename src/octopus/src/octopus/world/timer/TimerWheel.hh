@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "flecs.h"
+
+namespace octopus
+{
+
+/// @brief kind of the timers of the production system
+/// other systems can use any other value
+constexpr uint32_t production_timer_kind = 0;
+
+struct Timer
+{
+	flecs::entity entity;
+	int64_t expiry = 0;
+	uint32_t kind = 0;
+};
+
+bool operator==(Timer const &a, Timer const &b);
+/// @brief order by expiry, kind then entity id
+bool operator<(Timer const &a, Timer const &b);
+
+/// @brief Hashed timer wheel, timers are stored in the slot
+/// of their expiry (modulo the number of slots) and sorted
+/// The content only depends on the set of timers hence
+/// reverting the timer steps restores the wheel exactly
+/// Timers with an expiry <= 0 are due at the next collection
+/// whatever the time (used for components set outside of steps
+/// like entity creation or loading)
+/// @note singleton updated through TimerStep except for the
+/// immediate timers added by observers
+struct TimerWheel
+{
+	static constexpr size_t nb_slots = 256;
+
+	std::vector<std::vector<Timer> > slots;
+	std::vector<Timer> immediate;
+
+	void add(Timer const &timer_p);
+	/// @brief remove one occurence of the timer
+	/// @return false if the timer was not found
+	bool remove(Timer const &timer_p);
+	/// @brief add timers expiring at the given time and immediate
+	/// timers to the vector (sorted by kind then entity id)
+	void get_due(int64_t time_p, std::vector<Timer> &due_p) const;
+	/// @brief number of timers in the wheel
+	size_t size() const;
+};
+
+/// @brief timers due this tick, filled by the timer system
+/// @note not part of the rollback state (recomputed every tick)
+struct DueTimers
+{
+	std::vector<Timer> timers;
+};
+
+struct TimerMemento {
+	bool done = false;
+};
+
+/// @brief add or cancel a timer
+struct TimerStep {
+	Timer timer;
+	/// @brief false to cancel the timer
+	bool add = true;
+
+	typedef TimerWheel Data;
+	typedef TimerMemento Memento;
+
+	void apply_step(Data &d, Memento &memento) const;
+
+	void revert_step(Data &d, Memento const &memento) const;
+};
+
+/// @brief entities with a timer of the given kind due this tick
+/// sorted by id and without duplicates
+std::vector<flecs::entity> get_due_entities(flecs::world const &ecs, uint32_t kind_p);
+
+/// @brief schedule a timer of the given kind for the entity
+template<class StepManager_t>
+void add_timer(flecs::world const &ecs, StepManager_t &manager_p, flecs::entity e, int64_t expiry_p, uint32_t kind_p)
+{
+	manager_p.get_last_layer().back().template get<TimerStep>().add_step(ecs.entity<TimerWheel>(), {{e, expiry_p, kind_p}, true});
+}
+
+/// @brief cancel a timer previously scheduled
+template<class StepManager_t>
+void cancel_timer(flecs::world const &ecs, StepManager_t &manager_p, flecs::entity e, int64_t expiry_p, uint32_t kind_p)
+{
+	manager_p.get_last_layer().back().template get<TimerStep>().add_step(ecs.entity<TimerWheel>(), {{e, expiry_p, kind_p}, false});
+}
+
+} // namespace octopus
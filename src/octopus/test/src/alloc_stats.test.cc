@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <set>
+
+#include "flecs.h"
+
+#include "octopus/utils/alloc/AllocStats.hh"
+#include "octopus/utils/alloc/SizeClassPool.hh"
+#include "octopus/utils/profiler/Profiler.hh"
+
+using namespace octopus;
+
+/////////////////////////////////////////////////
+/// This test aims at testing that allocations
+/// are counted per thread, per source and per
+/// zone and that pooled containers stop
+/// allocating once warmed up
+/////////////////////////////////////////////////
+
+TEST(alloc_stats, new_and_flecs)
+{
+	if(!AllocStats::tracks_new())
+	{
+		GTEST_SKIP() << "built without OCTOPUS_ALLOC_TRACKING";
+	}
+	AllocCounters const thread_start_l = AllocStats::thread();
+	AllocScope scope_l;
+
+	std::unique_ptr<int[]> array_l(new int[100]);
+	array_l.reset();
+
+	AllocCounters const thread_l = AllocStats::thread() - thread_start_l;
+	EXPECT_EQ(1u, thread_l.allocations);
+	EXPECT_EQ(1u, thread_l.deallocations);
+	EXPECT_EQ(100 * sizeof(int), thread_l.bytes);
+	// other threads may allocate
+	EXPECT_LE(1u, scope_l.allocated(AllocSource::New).allocations);
+	EXPECT_EQ(0u, scope_l.allocated(AllocSource::Flecs).allocations);
+
+	flecs::world ecs;
+	AllocStats::install_flecs_hooks();
+	AllocScope flecs_scope_l;
+	for(size_t i = 0 ; i < 100 ; ++ i)
+	{
+		ecs.entity().set<int>({int(i)});
+	}
+	EXPECT_LT(0u, flecs_scope_l.allocated(AllocSource::Flecs).allocations);
+}
+
+TEST(alloc_stats, profiler_zone)
+{
+	if(!AllocStats::tracks_new())
+	{
+		GTEST_SKIP() << "built without OCTOPUS_ALLOC_TRACKING";
+	}
+	Profiler &profiler_l = Profiler::get();
+	profiler_l.reset();
+	profiler_l.enable();
+	{
+		OCTOPUS_ZONE("allocating")
+		std::unique_ptr<int> ptr_l = std::make_unique<int>(2);
+	}
+	{
+		OCTOPUS_ZONE("not_allocating")
+	}
+	profiler_l.collect();
+	profiler_l.disable();
+
+	EXPECT_EQ(1u, profiler_l.histograms().at("allocating").allocations);
+	EXPECT_EQ(sizeof(int), profiler_l.histograms().at("allocating").alloc_bytes);
+	EXPECT_EQ(0u, profiler_l.histograms().at("not_allocating").allocations);
+	profiler_l.reset();
+}
+
+TEST(alloc_stats, pool_steady_state)
+{
+	using pooled_set = std::set<int, std::less<int>, PoolAllocator<int> >;
+	auto churn_l = []() {
+		pooled_set set_l;
+		for(int i = 0 ; i < 200 ; ++ i)
+		{
+			set_l.insert(i * 7 % 200);
+		}
+		for(int i = 0 ; i < 100 ; ++ i)
+		{
+			set_l.erase(i * 3 % 200);
+		}
+	};
+	// warm up
+	churn_l();
+	size_t const chunks_l = thread_size_class_pool().chunks();
+	EXPECT_LT(0u, chunks_l);
+
+	AllocCounters const start_l = AllocStats::thread();
+	for(size_t i = 0 ; i < 10 ; ++ i)
+	{
+		churn_l();
+	}
+	if(AllocStats::tracks_new())
+	{
+		EXPECT_EQ(0u, (AllocStats::thread() - start_l).allocations);
+	}
+	EXPECT_EQ(chunks_l, thread_size_class_pool().chunks());
+
+	// big blocks are forwarded to operator new
+	SizeClassPool pool_l;
+	void *big_l = pool_l.allocate(SizeClassPool::max_size + 1);
+	pool_l.deallocate(big_l, SizeClassPool::max_size + 1);
+	EXPECT_EQ(0u, pool_l.chunks());
+	void *small_l = pool_l.allocate(24);
+	pool_l.deallocate(small_l, 24);
+	EXPECT_EQ(small_l, pool_l.allocate(32));
+	EXPECT_EQ(1u, pool_l.chunks());
+}
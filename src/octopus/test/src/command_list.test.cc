@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "octopus/commands/queue/CommandList.hh"
+
+using namespace octopus;
+
+/////////////////////////////////////////////////
+/// This test aims at testing that command lists
+/// behave as lists when wrapping around and when
+/// growing out of their inline storage
+/////////////////////////////////////////////////
+
+namespace
+{
+
+std::vector<int> content(CommandList<int, 2> const &list_p)
+{
+	return std::vector<int>(list_p.begin(), list_p.end());
+}
+
+}
+
+TEST(command_list, push_pop)
+{
+	CommandList<int, 2> list_l;
+	EXPECT_TRUE(list_l.empty());
+
+	list_l.push_back(1);
+	list_l.push_back(2);
+	EXPECT_EQ(0u, list_l.heap_bytes());
+
+	// wrap around in the inline storage
+	list_l.pop_front();
+	list_l.push_back(3);
+	EXPECT_EQ(std::vector<int>({2, 3}), content(list_l));
+	EXPECT_EQ(0u, list_l.heap_bytes());
+
+	// grow to the heap
+	list_l.push_front(1);
+	list_l.push_back(4);
+	EXPECT_EQ(std::vector<int>({1, 2, 3, 4}), content(list_l));
+	EXPECT_EQ(4u, list_l.capacity());
+	EXPECT_EQ(1, list_l.front());
+	EXPECT_EQ(4, list_l.back());
+
+	list_l.pop_back();
+	list_l.pop_front();
+	EXPECT_EQ(std::vector<int>({2, 3}), content(list_l));
+
+	// heap buffer is kept when cleared
+	list_l.clear();
+	EXPECT_TRUE(list_l.empty());
+	EXPECT_EQ(4u, list_l.capacity());
+	list_l.push_front(5);
+	list_l.push_front(6);
+	EXPECT_EQ(std::vector<int>({6, 5}), content(list_l));
+}
+
+TEST(command_list, copy_move)
+{
+	CommandList<std::string, 2> list_l = {"a", "b", "c"};
+
+	CommandList<std::string, 2> copy_l = list_l;
+	EXPECT_EQ(3u, copy_l.size());
+	EXPECT_EQ("c", copy_l.back());
+
+	// heap buffer is stolen
+	size_t const heap_l = list_l.heap_bytes();
+	CommandList<std::string, 2> moved_l = std::move(list_l);
+	EXPECT_TRUE(list_l.empty());
+	EXPECT_EQ(heap_l, moved_l.heap_bytes());
+	EXPECT_EQ("a", moved_l.front());
+
+	// inline content is moved
+	CommandList<std::string, 2> small_l = {"d"};
+	moved_l = std::move(small_l);
+	EXPECT_TRUE(small_l.empty());
+	ASSERT_EQ(1u, moved_l.size());
+	EXPECT_EQ("d", moved_l.front());
+}
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include "octopus/commands/basic/ability/CastCommand.hh"
+#include "octopus/commands/basic/move/AttackCommand.hh"
+#include "octopus/commands/queue/CommandQueue.hh"
+#include "octopus/components/step/StepContainer.hh"
+#include "octopus/components/step/StepReversal.hh"
+#include "octopus/systems/Systems.hh"
+#include "octopus/world/WorldContext.hh"
+#include "octopus/world/StepContext.hh"
+
+#include <variant>
+#include <vector>
+
+#include "env/custom_components.hh"
+
+using namespace octopus;
+
+/////////////////////////////////////////////////
+/// This test aims at testing that command queue
+/// mementos only store deltas : a scripted match
+/// must take less memory than full snapshots
+/// and be reverted step by step exactly
+/////////////////////////////////////////////////
+
+namespace
+{
+
+using custom_variant = std::variant<octopus::NoOpCommand, octopus::AttackCommand, octopus::CastCommand, WalkTest, AttackTest>;
+using CustomCommandQueue = CommandQueue<custom_variant>;
+
+/// @brief size of the queue as seen by a full snapshot memento
+size_t snapshot_footprint(CustomCommandQueue const &queue_p)
+{
+	size_t const node_overhead_l = 2 * sizeof(void *);
+	return sizeof(CommandQueueMemento<custom_variant>)
+		+ queue_p._queued.size() * (sizeof(custom_variant) + node_overhead_l)
+		+ queue_p._queuedActions.size() * (sizeof(CustomCommandQueue::CommandQueueAction) + node_overhead_l);
+}
+
+struct QueueRecord
+{
+	size_t queued = 0;
+	size_t current = 0;
+	size_t actions = 0;
+	bool done = false;
+
+	bool operator==(QueueRecord const &other_p) const
+	{
+		return queued == other_p.queued && current == other_p.current
+			&& actions == other_p.actions && done == other_p.done;
+	}
+};
+
+QueueRecord record(CustomCommandQueue const &queue_p)
+{
+	return {queue_p._queued.size(), queue_p._current.index(), queue_p._queuedActions.size(), queue_p._done};
+}
+
+}
+
+TEST(command_queue_memento, scripted_match)
+{
+	WorldContext world;
+	auto step_context = makeDefaultStepContext<custom_variant>();
+	flecs::world &ecs = world.ecs;
+
+	set_up_systems(world, step_context);
+
+	// WalkTest : walk for a few progress then done
+	ecs.system<WalkTest, CustomCommandQueue>()
+		.kind(ecs.entity(UpdatePhase))
+		.with(CustomCommandQueue::state(ecs), ecs.component<WalkTest::State>())
+		.each([](flecs::entity e, WalkTest &walk_p, CustomCommandQueue &cQueue_p) {
+			++walk_p.t;
+			if(walk_p.t >= 7)
+			{
+				walk_p.t = 0;
+				cQueue_p._queuedActions.push_back(CommandQueueActionDone());
+			}
+		});
+
+	std::vector<flecs::entity> entities_l;
+	for(size_t i = 0 ; i < 4 ; ++ i)
+	{
+		entities_l.push_back(ecs.entity().add<CustomCommandQueue>());
+	}
+
+	// one minute at 10 steps per second
+	size_t const steps_l = 600;
+	size_t snapshot_bytes_l = 0;
+	std::vector<std::vector<QueueRecord> > records_l(entities_l.size());
+
+	for(size_t i = 0 ; i < steps_l ; ++ i)
+	{
+		for(size_t idx = 0 ; idx < entities_l.size() ; ++ idx)
+		{
+			CustomCommandQueue &queue_l = *entities_l[idx].try_get_mut<CustomCommandQueue>();
+			// shift queued orders every few steps
+			if((i + idx) % 5 == 0)
+			{
+				queue_l._queuedActions.push_back(CommandQueueActionAddBack<custom_variant> {WalkTest(idx)});
+			}
+			// new orders replacing the queue
+			if((i + 3 * idx) % 60 == 0)
+			{
+				std::vector<custom_variant> orders_l(8, WalkTest(0));
+				queue_l._queuedActions.push_back(CommandQueueActionReplace<custom_variant> {orders_l});
+			}
+			// a full snapshot would be taken when there are actions
+			if(!queue_l._queuedActions.empty())
+			{
+				snapshot_bytes_l += snapshot_footprint(queue_l);
+			}
+			records_l[idx].push_back(record(queue_l));
+		}
+		ecs.progress();
+	}
+
+	size_t const delta_bytes_l = memory_footprint(step_context.memento_manager);
+	EXPECT_LT(delta_bytes_l * 2, snapshot_bytes_l);
+
+	// revert every step and check the queues
+	for(size_t i = steps_l ; i > 0 ; -- i)
+	{
+		revert_n_steps(ecs, world.pool, 1, step_context.step_manager, step_context.memento_manager, step_context.state_step_manager);
+		clear_n_steps(ecs, 1, step_context.step_manager, step_context.memento_manager, step_context.state_step_manager);
+
+		for(size_t idx = 0 ; idx < entities_l.size() ; ++ idx)
+		{
+			ASSERT_TRUE(records_l[idx][i-1] == record(*entities_l[idx].try_get<CustomCommandQueue>())) << "step " << i-1 << " entity " << idx;
+		}
+	}
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "flecs.h"
+
+#include "octopus/utils/profiler/CostAttribution.hh"
+
+using namespace octopus;
+
+/////////////////////////////////////////////////
+/// This test aims at testing that entity costs
+/// are merged per tick, that only sampled ticks
+/// are recorded and that the top K is kept
+/////////////////////////////////////////////////
+
+namespace
+{
+
+void run_entity(flecs::entity e, char const *command_p, size_t steps_p, std::chrono::microseconds wait_p)
+{
+	OCTOPUS_ENTITY_COST("test_system", e, command_p)
+	for(size_t i = 0 ; i < steps_p ; ++ i)
+	{
+		CostAttribution::count_step();
+	}
+	std::this_thread::sleep_for(wait_p);
+}
+
+} // namespace
+
+TEST(cost_attribution, top_k)
+{
+	flecs::world ecs;
+	flecs::entity cheap_l = ecs.entity();
+	flecs::entity busy_l = ecs.entity();
+	flecs::entity idle_l = ecs.entity();
+
+	CostAttribution &costs_l = CostAttribution::get();
+	costs_l.reset();
+
+	// disabled : nothing recorded
+	run_entity(busy_l, "Busy", 1, std::chrono::microseconds(0));
+	costs_l.collect();
+	EXPECT_EQ(0u, costs_l.sampled_ticks());
+	EXPECT_TRUE(costs_l.commands().empty());
+
+	costs_l.enable(2, 2);
+	for(size_t tick_l = 0 ; tick_l < 3 ; ++ tick_l)
+	{
+		run_entity(idle_l, nullptr, 0, std::chrono::microseconds(0));
+		run_entity(cheap_l, "Cheap", 1, std::chrono::microseconds(0));
+		for(size_t i = 0 ; i < 3 ; ++ i)
+		{
+			run_entity(busy_l, "Busy", 2, std::chrono::milliseconds(2));
+		}
+		costs_l.collect();
+	}
+	costs_l.disable();
+
+	// ticks 0 and 2 are sampled
+	EXPECT_EQ(2u, costs_l.sampled_ticks());
+
+	// runs of an entity are merged in the tick
+	ASSERT_EQ(2u, costs_l.last_top().size());
+	EntityCost const &top_l = costs_l.last_top()[0];
+	EXPECT_EQ(busy_l.id(), top_l.entity);
+	EXPECT_EQ(2u, top_l.tick);
+	EXPECT_EQ(3u, top_l.calls);
+	EXPECT_EQ(6u, top_l.steps);
+	EXPECT_LE(uint64_t(6000000), top_l.ns);
+	EXPECT_GE(top_l.ns, costs_l.last_top()[1].ns);
+
+	ASSERT_EQ(2u, costs_l.worst().size());
+	EXPECT_EQ(busy_l.id(), costs_l.worst()[0].entity);
+	EXPECT_EQ(busy_l.id(), costs_l.worst()[1].entity);
+
+	// commands are cumulated over the sampled ticks
+	ASSERT_EQ(3u, costs_l.commands().size());
+	CommandCost const &busy_cost_l = costs_l.commands().at({"test_system", "Busy"});
+	EXPECT_EQ(6u, busy_cost_l.calls);
+	EXPECT_EQ(12u, busy_cost_l.steps);
+	EXPECT_EQ(2u, costs_l.commands().at({"test_system", "Cheap"}).steps);
+	EXPECT_EQ(2u, costs_l.commands().at({"test_system", "none"}).calls);
+
+	std::stringstream ss_l;
+	costs_l.write_json(ss_l);
+	std::string const json_l = ss_l.str();
+	EXPECT_EQ(0u, json_l.find("{\"sampled_ticks\": 2,"));
+	EXPECT_NE(std::string::npos, json_l.find("{\"system\": \"test_system\", \"command\": \"Busy\", \"calls\": 6, \"ns\": "));
+
+	costs_l.reset();
+	EXPECT_TRUE(costs_l.worst().empty());
+	EXPECT_TRUE(costs_l.commands().empty());
+	EXPECT_EQ(0u, costs_l.sampled_ticks());
+}
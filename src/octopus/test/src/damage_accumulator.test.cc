@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include "flecs.h"
+
+#include "octopus/utils/ThreadPool.hh"
+#include "octopus/world/damage/DamageAccumulator.hh"
+
+using namespace octopus;
+
+/////////////////////////////////////////////////
+/// This test aims at testing that damage
+/// contributions are merged per target
+/////////////////////////////////////////////////
+
+TEST(damage_accumulator, simple)
+{
+	flecs::world ecs;
+	ThreadPool pool_l(2);
+	DamageAccumulator accumulator_l(2);
+
+	auto t1 = ecs.entity("t1");
+	auto t2 = ecs.entity("t2");
+	auto s1 = ecs.entity("s1");
+	auto s2 = ecs.entity("s2");
+	auto s3 = ecs.entity("s3");
+
+	accumulator_l.add(s1, t2, 5);
+	accumulator_l.add(s2, t1, 3, 1);
+	accumulator_l.add(s3, t2, -2);
+
+	std::vector<DamageContribution> net_l = accumulator_l.reduce(pool_l);
+
+	ASSERT_EQ(2u, net_l.size());
+	EXPECT_EQ(t1, net_l[0].target);
+	EXPECT_EQ(Fixed(3), net_l[0].damage);
+	EXPECT_EQ(t2, net_l[1].target);
+	EXPECT_EQ(Fixed(3), net_l[1].damage);
+	EXPECT_TRUE(accumulator_l.breakdown.empty());
+
+	// contributions have been consumed
+	EXPECT_TRUE(accumulator_l.reduce(pool_l).empty());
+
+	// breakdown per source
+	accumulator_l.debug = true;
+	accumulator_l.add(s1, t2, 5);
+	accumulator_l.add(s2, t1, 3, 1);
+	accumulator_l.add(s3, t2, -2);
+	accumulator_l.reduce(pool_l);
+
+	ASSERT_EQ(3u, accumulator_l.breakdown.size());
+	EXPECT_EQ(s2, accumulator_l.breakdown[0].source);
+	EXPECT_EQ(s1, accumulator_l.breakdown[1].source);
+	EXPECT_EQ(s3, accumulator_l.breakdown[2].source);
+}
+
+TEST(damage_accumulator, parallel)
+{
+	flecs::world ecs;
+	ThreadPool pool_l(2);
+	DamageAccumulator accumulator_l(2);
+
+	std::vector<flecs::entity> targets_l;
+	for(size_t i = 0 ; i < 100 ; ++ i)
+	{
+		targets_l.push_back(ecs.entity());
+	}
+	auto source = ecs.entity();
+
+	for(size_t i = 0 ; i < 100 ; ++ i)
+	{
+		accumulator_l.add(source, targets_l[99-i], int(i), 0);
+		accumulator_l.add(source, targets_l[99-i], 1, 1);
+	}
+
+	std::vector<DamageContribution> const &net_l = accumulator_l.reduce(pool_l);
+
+	ASSERT_EQ(100u, net_l.size());
+	for(size_t i = 0 ; i < 100 ; ++ i)
+	{
+		EXPECT_EQ(targets_l[i], net_l[i].target);
+		EXPECT_EQ(Fixed(int(99-i)+1), net_l[i].damage);
+	}
+}
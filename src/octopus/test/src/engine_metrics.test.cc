@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <thread>
+
+#include "flecs.h"
+
+#include "octopus/commands/basic/move/AttackCommand.hh"
+#include "octopus/commands/basic/move/MoveCommand.hh"
+#include "octopus/components/basic/hitpoint/HitPoint.hh"
+#include "octopus/components/basic/position/Position.hh"
+#include "octopus/components/basic/position/PositionInTree.hh"
+#include "octopus/systems/Systems.hh"
+#include "octopus/utils/metrics/EngineCounters.hh"
+#include "octopus/world/metrics/EngineMetrics.hh"
+#include "octopus/world/StepContext.hh"
+#include "octopus/world/WorldContext.hh"
+
+using namespace octopus;
+
+/////////////////////////////////////////////////
+/// This test aims at testing that the engine
+/// metrics are published as flecs components
+/// and metrics
+/////////////////////////////////////////////////
+
+namespace
+{
+
+using custom_variant = std::variant<octopus::NoOpCommand, octopus::MoveCommand, octopus::AttackCommand>;
+
+}
+
+TEST(engine_metrics, counters)
+{
+	uint64_t const start_l = EngineCounters::total(EngineCounter::TreeKept);
+	std::thread thread_l([]() {
+		EngineCounters::add(EngineCounter::TreeKept, 3);
+	});
+	thread_l.join();
+	EngineCounters::add(EngineCounter::TreeKept);
+	EXPECT_EQ(start_l + 4, EngineCounters::total(EngineCounter::TreeKept));
+}
+
+TEST(engine_metrics, world)
+{
+	WorldContext world;
+	world.metrics = true;
+	flecs::world &ecs = world.ecs;
+
+	auto step_context = makeDefaultStepContext<custom_variant>();
+	set_up_systems(world, step_context);
+
+	ecs.entity("e0")
+		.add<PositionInTree>()
+		.set<Position>({{10,10}})
+		.set<Collision>({Fixed::One(), Fixed::One(), false})
+		.set<HitPoint>({10});
+
+	// the entity is added to the trees
+	ecs.progress();
+	EngineMetrics const *metrics_l = ecs.try_get<EngineMetrics>();
+	ASSERT_NE(nullptr, metrics_l);
+	EXPECT_LE(1u, metrics_l->tree_inserts);
+	EXPECT_EQ(0u, metrics_l->tree_kept);
+	EXPECT_LE(1u, metrics_l->steps);
+
+	flecs::entity const step_type_l = ecs.lookup("octopus::metrics::step_types::PositionInTreeStep");
+	ASSERT_TRUE(step_type_l);
+	EXPECT_EQ(metrics_l->tree_inserts, step_type_l.try_get<StepTypeMetrics>()->count);
+
+	// the entity does not move
+	ecs.progress();
+	metrics_l = ecs.try_get<EngineMetrics>();
+	EXPECT_EQ(0u, metrics_l->tree_inserts);
+	EXPECT_EQ(0u, metrics_l->tree_reinserts);
+	EXPECT_LE(1u, metrics_l->tree_kept);
+	EXPECT_EQ(0u, step_type_l.try_get<StepTypeMetrics>()->count);
+
+	PhaseMetrics const *phase_l = ecs.lookup(InitializationPhase).try_get<PhaseMetrics>();
+	ASSERT_NE(nullptr, phase_l);
+	EXPECT_LT(0u, phase_l->last_ns);
+	EXPECT_LE(phase_l->last_ns, phase_l->max_ns);
+
+	// one instance of the flecs metric per phase
+	ecs.progress();
+	flecs::entity const metric_l = ecs.lookup("octopus::metrics::phase_ns");
+	ASSERT_TRUE(metric_l);
+	size_t instances_l = 0;
+	metric_l.children([&instances_l](flecs::entity instance_p) {
+		if(instance_p.has<flecs::metrics::Value>())
+		{
+			++instances_l;
+		}
+	});
+	EXPECT_EQ(16u, instances_l);
+
+	std::stringstream json_l;
+	write_metrics_json(json_l, ecs);
+	EXPECT_NE(std::string::npos, json_l.str().find("\"Initialization\": {\"last\": "));
+	EXPECT_NE(std::string::npos, json_l.str().find("\"PositionInTreeStep\": {\"count\": 0"));
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include "flecs.h"
+
+#include "octopus/commands/basic/move/AttackCommand.hh"
+#include "octopus/components/basic/hitpoint/HitPoint.hh"
+#include "octopus/world/resources/ResourceStock.hh"
+#include "octopus/world/step/HistoryMemory.hh"
+
+using namespace octopus;
+
+/////////////////////////////////////////////////
+/// This test aims at testing that the memory
+/// of the histories is accounted per step type
+/// and per layer (newest first)
+/////////////////////////////////////////////////
+
+TEST(history_memory, step_manager)
+{
+	flecs::world ecs;
+	flecs::entity e1 = ecs.entity();
+
+	StepManager<HitPointStep, ResourceStockStep> manager_l;
+	manager_l.add_layer(1);
+	manager_l.get_last_layer().back().get<HitPointStep>().add_step(e1, {Fixed(-1)});
+	manager_l.add_layer(1);
+	manager_l.get_last_layer().back().get<HitPointStep>().add_step(e1, {Fixed(-1)});
+	manager_l.get_last_layer().back().get<HitPointStep>().add_step(e1, {Fixed(-1)});
+	std::string const long_name_l(64, 'r');
+	manager_l.get_last_prelayer().back().get<ResourceStockStep>().add_step(e1, {Fixed(1), long_name_l});
+
+	HistoryMemory memory_l;
+	account_history(memory_l, manager_l);
+
+	HistoryEntryMemory const *hp_l = memory_l.find("octopus::HitPointStep");
+	ASSERT_NE(nullptr, hp_l);
+	EXPECT_EQ(3u, hp_l->elements);
+	EXPECT_LE(3 * sizeof(StepTuple<HitPointStep>), hp_l->bytes);
+
+	// the resource name is on the heap
+	HistoryEntryMemory const *resource_l = memory_l.find("octopus::ResourceStockStep");
+	ASSERT_NE(nullptr, resource_l);
+	EXPECT_EQ(1u, resource_l->elements);
+	EXPECT_LE(sizeof(StepTuple<ResourceStockStep>) + long_name_l.size(), resource_l->bytes);
+
+	EXPECT_EQ(nullptr, memory_l.find("octopus::AttackWindupStep"));
+
+	ASSERT_EQ(2u, memory_l.layers.size());
+	EXPECT_EQ(3u, memory_l.layers[0].elements);
+	EXPECT_EQ(1u, memory_l.layers[1].elements);
+	EXPECT_EQ(4u, memory_l.elements);
+	EXPECT_EQ(memory_l.layers[0].bytes + memory_l.layers[1].bytes, memory_l.bytes);
+}
+
+TEST(history_memory, other_histories)
+{
+	typedef std::variant<NoOpCommand, AttackCommand> variant_t;
+	StateStepContainer<variant_t> state_l;
+	state_l.add_layer();
+	state_l.layers.back()._addPair.emplace_back();
+	state_l.add_layer();
+	state_l.prelayers.back()._setComp.emplace_back();
+
+	CommandQueueMementoManager<variant_t> mementos_l;
+	mementos_l.lMementos.emplace_back(2);
+
+	StepEntityManager entities_l;
+	entities_l.add_layer();
+	entities_l.creation_steps.back().emplace_back();
+
+	HistoryMemory memory_l;
+	account_history(memory_l, state_l);
+	account_history(memory_l, mementos_l);
+	account_history(memory_l, entities_l);
+
+	ASSERT_NE(nullptr, memory_l.find("octopus::StateAddPairStep"));
+	EXPECT_EQ(1u, memory_l.find("octopus::StateAddPairStep")->elements);
+	EXPECT_EQ(1u, memory_l.find("octopus::StateSetComponentStep")->elements);
+	EXPECT_EQ(0u, memory_l.find("octopus::StateRemovePairStep")->elements);
+	EXPECT_EQ(2u, memory_l.find("octopus::CommandQueueMemento")->elements);
+	EXPECT_EQ(1u, memory_l.find("octopus::EntityCreationStep")->elements);
+
+	// the add pair step is in the oldest of the two state layers
+	ASSERT_EQ(2u, memory_l.layers.size());
+	EXPECT_EQ(4u, memory_l.layers[0].elements);
+	EXPECT_EQ(1u, memory_l.layers[1].elements);
+
+	memory_l.clear();
+	EXPECT_EQ(0u, memory_l.bytes);
+	EXPECT_TRUE(memory_l.types.empty());
+}
+
+TEST(history_memory, string_heap)
+{
+	EXPECT_EQ(0u, history_heap_bytes(std::string("a")));
+	std::string const long_l(100, 'a');
+	EXPECT_LE(101u, history_heap_bytes(long_l));
+}
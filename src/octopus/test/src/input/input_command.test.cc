@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+
+#include <flecs.h>
+#include <thread>
+#include <vector>
+
+#include "octopus/commands/basic/ability/CastCommand.hh"
+#include "octopus/commands/basic/move/AttackCommand.hh"
+#include "octopus/commands/basic/move/MoveCommand.hh"
+#include "octopus/commands/queue/CommandQueue.hh"
+
+#include "octopus/components/basic/flock/FlockManager.hh"
+#include "octopus/components/basic/position/Move.hh"
+#include "octopus/components/basic/position/Position.hh"
+#include "octopus/components/step/StepContainer.hh"
+
+#include "octopus/systems/Systems.hh"
+#include "octopus/systems/phases/Phases.hh"
+
+#include "octopus/serialization/components/BasicSupport.hh"
+
+#include "octopus/world/WorldContext.hh"
+#include "octopus/world/StepContext.hh"
+
+using namespace octopus;
+
+/////////////////////////////////////////////////
+/// This test aims at testing that command inputs
+/// submitted from several threads or to large
+/// groups reach the queues in submission order
+/////////////////////////////////////////////////
+
+namespace
+{
+
+using custom_variant = std::variant<octopus::NoOpCommand, octopus::MoveCommand, octopus::AttackCommand, octopus::CastCommand>;
+using CustomCommandQueue = CommandQueue<custom_variant>;
+using CustomInput = Input<custom_variant, DefaultStepManager>;
+
+Fixed target_x(custom_variant const &command_p)
+{
+	return std::get<MoveCommand>(command_p).target.x;
+}
+
+}
+
+TEST(input_command, group_fan_out)
+{
+	WorldContext world;
+	flecs::world &ecs = world.ecs;
+
+	basic_components_support(ecs);
+
+	auto flock_manager = ecs.entity("flock_manager")
+							.add<FlockManager>();
+	ecs.add<CustomInput>();
+	ecs.try_get_mut<CustomInput>()->flock_manager = flock_manager;
+
+	auto step_context = makeDefaultStepContext<custom_variant>();
+	set_up_systems(world, step_context);
+
+	// large enough to be fanned out in parallel
+	std::vector<flecs::entity> group_l;
+	for(size_t i = 0 ; i < 2 * CustomInput::parallel_fan_out ; ++ i)
+	{
+		group_l.push_back(ecs.entity()
+			.add<CustomCommandQueue>()
+			.set<Position>({{int(i % 32) * 3, int(i / 32) * 3}})
+			.set<Collision>({octopus::Fixed::One(), octopus::Fixed::One(), false})
+			.add<Move>());
+	}
+
+	ecs.try_get_mut<CustomInput>()->addBackCommand(group_l, MoveCommand {{1, 0}});
+	ecs.try_get_mut<CustomInput>()->addBackCommand(group_l, MoveCommand {{2, 0}});
+	ecs.try_get_mut<CustomInput>()->addBackCommand(group_l[0], MoveCommand {{3, 0}});
+
+	// inputs are handled during the first progress
+	// and the queues updated during the second one
+	ecs.progress();
+	ecs.progress();
+
+	for(size_t i = 0 ; i < group_l.size() ; ++ i)
+	{
+		CustomCommandQueue const *queue_l = group_l[i].try_get<CustomCommandQueue>();
+		ASSERT_TRUE(std::holds_alternative<MoveCommand>(queue_l->_current));
+		EXPECT_EQ(Fixed(1), target_x(queue_l->_current));
+		ASSERT_EQ(i == 0 ? 2u : 1u, queue_l->_queued.size());
+		EXPECT_EQ(Fixed(2), target_x(queue_l->_queued.front()));
+	}
+	EXPECT_EQ(Fixed(3), target_x(group_l[0].try_get<CustomCommandQueue>()->_queued.back()));
+
+	// one flock per group command
+	EXPECT_EQ(2u, flock_manager.try_get<FlockManager>()->flocks.size());
+}
+
+TEST(input_command, concurrent_submission)
+{
+	WorldContext world;
+	flecs::world &ecs = world.ecs;
+
+	ecs.add<CustomInput>();
+
+	auto step_context = makeDefaultStepContext<custom_variant>();
+	set_up_systems(world, step_context);
+
+	auto e1 = ecs.entity().add<CustomCommandQueue>();
+
+	CustomInput *input_l = ecs.try_get_mut<CustomInput>();
+	size_t const threads_l = 4;
+	size_t const commands_l = 100;
+	std::vector<std::thread> producers_l;
+	for(size_t t = 0 ; t < threads_l ; ++ t)
+	{
+		producers_l.emplace_back([input_l, e1, t, commands_l]() {
+			for(size_t i = 0 ; i < commands_l ; ++ i)
+			{
+				input_l->addBackCommand(e1, MoveCommand {{int(t), int(i)}});
+			}
+		});
+	}
+	for(std::thread &thread_l : producers_l)
+	{
+		thread_l.join();
+	}
+
+	// inputs are handled during the first progress
+	// and the queues updated during the second one
+	ecs.progress();
+	ecs.progress();
+
+	CustomCommandQueue const *queue_l = e1.try_get<CustomCommandQueue>();
+	ASSERT_EQ(threads_l * commands_l - 1, queue_l->_queued.size());
+
+	// every producer keeps its order
+	std::vector<custom_variant> commands_received_l = {queue_l->_current};
+	commands_received_l.insert(commands_received_l.end(), queue_l->_queued.begin(), queue_l->_queued.end());
+	std::vector<int> last_l(threads_l, -1);
+	for(custom_variant const &command_l : commands_received_l)
+	{
+		MoveCommand const &move_l = std::get<MoveCommand>(command_l);
+		int thread_l = move_l.target.x.to_int();
+		int idx_l = move_l.target.y.to_int();
+		EXPECT_EQ(last_l[thread_l] + 1, idx_l);
+		last_l[thread_l] = idx_l;
+	}
+}
@@ -804,3 +804,90 @@ TEST(input_new_production, balance_queue)
 
 	revert_test.revert_and_check_records(world, step_context);
 }
+
+TEST(input_new_production, balance_queue_same_step)
+{
+	WorldContext world;
+	flecs::world &ecs = world.ecs;
+
+	basic_components_support(ecs);
+	basic_commands_support(ecs);
+	command_queue_support<octopus::NoOpCommand, octopus::AttackCommand>(ecs);
+
+	ecs.add<Input<custom_variant, DefaultStepManager>>();
+
+	auto step_context = makeDefaultStepContext<custom_variant>();
+	ProductionTemplateLibrary<DefaultStepManager> lib_l;
+	lib_l.add_template(new ProdA());
+	ecs.set(lib_l);
+
+	set_up_systems(world, step_context);
+
+	Position pos_l = {{10,10}};
+	auto e1 = ecs.entity("e1")
+		.add<CustomCommandQueue>()
+		.set<HitPoint>({10})
+		.set<ProductionQueue>({0, {}})
+		.add<ProductionQueue>(ecs.component("a"))
+		.set<PlayerAppartenance>({0});
+	auto e2 = ecs.entity("e2")
+		.add<CustomCommandQueue>()
+		.set<HitPoint>({10})
+		.set<ProductionQueue>({0, {}})
+		.add<ProductionQueue>(ecs.component("a"))
+		.set<PlayerAppartenance>({0});
+
+	auto player = ecs.entity("player")
+		.set<PlayerInfo>({0, 0})
+		.add<ResourceStock>();
+
+	std::vector<octopus::Fixed> const expected_hp1_l = {
+		octopus::Fixed(10),
+		octopus::Fixed(10),
+		octopus::Fixed(10),
+		octopus::Fixed(10),
+		octopus::Fixed(10),
+		octopus::Fixed(11),
+		octopus::Fixed(11),
+		octopus::Fixed(11),
+		octopus::Fixed(11),
+		octopus::Fixed(11),
+	};
+
+	std::vector<octopus::Fixed> const expected_hp2_l = {
+		octopus::Fixed(10),
+		octopus::Fixed(10),
+		octopus::Fixed(10),
+		octopus::Fixed(10),
+		octopus::Fixed(10),
+		octopus::Fixed(11),
+		octopus::Fixed(11),
+		octopus::Fixed(11),
+		octopus::Fixed(11),
+		octopus::Fixed(11),
+	};
+
+	RevertTester<custom_variant, HitPoint, ProductionQueue> revert_test({e1, e2});
+
+	for(size_t i = 0; i < 10 ; ++ i)
+	{
+		// std::cout<<"p"<<i<<std::endl;
+
+		ecs.progress();
+		revert_test.add_record(ecs);
+
+		// both productions are dispatched in the same step
+		if(i == 2)
+		{
+			ecs.try_get_mut<Input<custom_variant, DefaultStepManager>>()->newProduction({{e1, e2}, "a"});
+			ecs.try_get_mut<Input<custom_variant, DefaultStepManager>>()->newProduction({{e1, e2}, "a"});
+		}
+
+		// stream_ent<HitPoint, ProductionQueue>(std::cout, ecs, e1);
+		// std::cout<<std::endl;
+		EXPECT_EQ(expected_hp1_l.at(i), e1.try_get<HitPoint>()->qty) << "10 != "<<e1.try_get<HitPoint>()->qty.to_double();
+		EXPECT_EQ(expected_hp2_l.at(i), e2.try_get<HitPoint>()->qty) << "10 != "<<e2.try_get<HitPoint>()->qty.to_double();
+	}
+
+	revert_test.revert_and_check_records(world, step_context);
+}
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "octopus/utils/log/Logger.hh"
+#include "octopus/utils/log/LogRing.hh"
+
+using namespace octopus;
+
+/////////////////////////////////////////////////
+/// This test aims at testing that records are
+/// written in order by the logger thread and
+/// that disabled statements are not evaluated
+/////////////////////////////////////////////////
+
+namespace
+{
+
+struct NotBinary
+{
+	int value;
+};
+
+std::ostream &operator<<(std::ostream &os_p, NotBinary const &not_binary_p)
+{
+	return os_p << "nb(" << not_binary_p.value << ")";
+}
+
+}
+
+TEST(logger, ring)
+{
+	LogRing ring_l(64);
+
+	// 8 bytes of header per entry
+	EXPECT_TRUE(ring_l.push("0123456789abcdef", 16));
+	EXPECT_TRUE(ring_l.push("abc", 3));
+	// no room left
+	EXPECT_FALSE(ring_l.push("0123456789abcdef0123456789abcdef", 32));
+	EXPECT_EQ(1u, ring_l.dropped());
+
+	std::vector<std::string> records_l;
+	auto collect_l = [&records_l](char const *record_p, uint32_t size_p) {
+		records_l.push_back(std::string(record_p, size_p));
+	};
+	EXPECT_EQ(2u, ring_l.drain(collect_l));
+	ASSERT_EQ(2u, records_l.size());
+	EXPECT_EQ("0123456789abcdef", records_l[0]);
+	EXPECT_EQ("abc", records_l[1]);
+
+	// wraps with a padding entry
+	EXPECT_TRUE(ring_l.push("0123456789abcdef0123", 20));
+	EXPECT_EQ(1u, ring_l.drain(collect_l));
+	ASSERT_EQ(3u, records_l.size());
+	EXPECT_EQ("0123456789abcdef0123", records_l[2]);
+	EXPECT_EQ(1u, ring_l.dropped());
+}
+
+TEST(logger, simple)
+{
+	std::stringstream ss_l;
+	Logger::redirect(&ss_l);
+
+	std::string const str_l = "string";
+	char buffer_l[] = "buffer";
+	OCTOPUS_LOG_NORMAL << "literal " << str_l << " " << buffer_l << " " << 42 << " " << -3l << " " << true
+		<< " " << Fixed(1) / 4 << " " << Vector(1, 2) << " " << NotBinary {7} << std::endl;
+	OCTOPUS_LOG_NORMAL << std::hex << 255 << std::endl;
+	// hex does not leak to the next record
+	OCTOPUS_LOG_NORMAL << 255 << std::endl;
+
+	// other threads
+	std::vector<std::thread> threads_l;
+	for(int i = 0 ; i < 4 ; ++ i)
+	{
+		threads_l.emplace_back([i]() {
+			for(int j = 0 ; j < 10 ; ++ j)
+			{
+				OCTOPUS_LOG_NORMAL << "thread " << i << " line " << j << std::endl;
+			}
+		});
+	}
+	for(std::thread &thread_l : threads_l)
+	{
+		thread_l.join();
+	}
+
+	Logger::flush();
+	Logger::redirect(nullptr);
+
+	std::vector<std::string> lines_l;
+	std::string line_l;
+	while(std::getline(ss_l, line_l))
+	{
+		lines_l.push_back(line_l);
+	}
+	ASSERT_EQ(43u, lines_l.size());
+	std::stringstream expected_l;
+	expected_l << "literal string buffer 42 -3 1 " << Fixed(1) / 4 << " " << Vector(1, 2) << " nb(7)";
+	EXPECT_EQ(expected_l.str(), lines_l[0]);
+	EXPECT_EQ("ff", lines_l[1]);
+	EXPECT_EQ("255", lines_l[2]);
+
+	// lines of a thread are in order
+	for(int i = 0 ; i < 4 ; ++ i)
+	{
+		int next_l = 0;
+		for(size_t l = 3 ; l < lines_l.size() ; ++ l)
+		{
+			std::string const prefix_l = "thread " + std::to_string(i) + " line ";
+			if(lines_l[l].rfind(prefix_l, 0) == 0)
+			{
+				EXPECT_EQ(prefix_l + std::to_string(next_l), lines_l[l]);
+				++next_l;
+			}
+		}
+		EXPECT_EQ(10, next_l);
+	}
+	EXPECT_EQ(0u, Logger::dropped());
+}
+
+TEST(logger, disabled_not_evaluated)
+{
+	std::stringstream ss_l;
+	Logger::redirect(&ss_l);
+
+	int calls_l = 0;
+	auto count_l = [&calls_l]() { ++calls_l; return calls_l; };
+
+	Logger::disable_debug();
+	OCTOPUS_LOG_DEBUG << "debug " << count_l() << std::endl;
+	EXPECT_EQ(0, calls_l);
+
+	Logger::enable_debug();
+	OCTOPUS_LOG_DEBUG << "debug " << count_l() << std::endl;
+	Logger::disable_debug();
+
+	Logger::flush();
+	Logger::redirect(nullptr);
+
+	if(OCTOPUS_LOG_LEVEL == 0)
+	{
+		EXPECT_EQ(1, calls_l);
+		EXPECT_EQ("debug 1\n", ss_l.str());
+	}
+	else
+	{
+		// compiled out
+		EXPECT_EQ(0, calls_l);
+		EXPECT_EQ("", ss_l.str());
+	}
+}
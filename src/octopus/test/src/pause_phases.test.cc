@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <flecs.h>
+#include <sstream>
+#include <string>
+
+#include "octopus/systems/Systems.hh"
+#include "octopus/systems/phases/Phases.hh"
+
+#include "octopus/serialization/queue/CommandQueueSupport.hh"
+#include "octopus/serialization/components/BasicSupport.hh"
+#include "octopus/serialization/commands/CommandSupport.hh"
+
+using namespace octopus;
+
+/////////////////////////////////////////////////
+/// This test aims at testing that pausing
+/// only skips the pausable phases and keeps
+/// the order of the other ones
+/////////////////////////////////////////////////
+
+namespace
+{
+
+using custom_variant = std::variant<octopus::NoOpCommand, octopus::MoveCommand, octopus::AttackCommand, octopus::CastCommand>;
+
+void add_tracing_system(flecs::world &ecs, std::stringstream &res, char const *phase)
+{
+	ecs.system<>()
+		.kind(ecs.entity(phase))
+		.run([&res, phase](flecs::iter &) {
+			res<<phase<<" ";
+		});
+}
+
+}
+
+TEST(pause_phases, simple)
+{
+	WorldContext world;
+	flecs::world &ecs = world.ecs;
+
+	basic_components_support(ecs);
+	basic_commands_support(ecs);
+	command_queue_support<octopus::NoOpCommand, octopus::MoveCommand, octopus::AttackCommand>(ecs);
+
+	auto step_context = makeDefaultStepContext<custom_variant>();
+	set_up_systems(world, step_context);
+
+	std::stringstream res;
+	add_tracing_system(ecs, res, PreUpdatePhase);
+	add_tracing_system(ecs, res, UpdatePhase);
+	add_tracing_system(ecs, res, UpdateUnpausedPhase);
+	add_tracing_system(ecs, res, PostUpdatePhase);
+	add_tracing_system(ecs, res, PostUpdateUnpausedPhase);
+	add_tracing_system(ecs, res, MovingPhase);
+	add_tracing_system(ecs, res, InputPhase);
+
+	auto e1 = ecs.entity("e1")
+		.add<Move>()
+		.set<Position>({{10,10}})
+		.set<Destroyable>({0});
+
+	EXPECT_FALSE(are_phases_paused(ecs));
+
+	ecs.progress();
+	EXPECT_EQ("PreUpdate Update UpdateUnpaused PostUpdate PostUpdateUnpaused Moving Input ", res.str());
+	EXPECT_EQ(1, get_time_stamp(ecs));
+
+	pause_phases(ecs);
+	EXPECT_TRUE(are_phases_paused(ecs));
+
+	// new entity created during pause should still be flagged as created
+	auto e2 = ecs.entity("e2")
+		.set<Destroyable>({0});
+
+	for(size_t i = 0 ; i < 3 ; ++ i)
+	{
+		res.str("");
+		ecs.progress();
+		EXPECT_EQ("PreUpdate UpdateUnpaused PostUpdateUnpaused Input ", res.str());
+	}
+	EXPECT_EQ(1, get_time_stamp(ecs));
+	EXPECT_TRUE(e2.has<Created>());
+
+	unpause_phases(ecs);
+	EXPECT_FALSE(are_phases_paused(ecs));
+
+	res.str("");
+	ecs.progress();
+	EXPECT_EQ("PreUpdate Update UpdateUnpaused PostUpdate PostUpdateUnpaused Moving Input ", res.str());
+	EXPECT_EQ(2, get_time_stamp(ecs));
+	EXPECT_TRUE(e1.has<Created>());
+}
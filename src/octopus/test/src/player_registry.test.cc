@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include "flecs.h"
+
+#include "octopus/world/player/PlayerInfo.hh"
+#include "octopus/world/player/PlayerRegistry.hh"
+
+using namespace octopus;
+
+/////////////////////////////////////////////////
+/// This test aims at testing that the player
+/// registry follows the players and their
+/// components
+/////////////////////////////////////////////////
+
+TEST(player_registry, simple)
+{
+	flecs::world ecs;
+	set_up_player_registry(ecs);
+
+	auto player = ecs.entity("player")
+		.set<PlayerInfo>({1, 1});
+	auto unit = ecs.entity("unit")
+		.set<PlayerAppartenance>({1});
+	auto orphan = ecs.entity("orphan");
+
+	EXPECT_EQ(nullptr, get_player_entry(ecs, 0));
+	EXPECT_EQ(nullptr, get_player_entry(ecs, 2));
+	EXPECT_EQ(nullptr, get_player_entry(orphan, ecs));
+
+	PlayerEntry const *entry = get_player_entry(unit, ecs);
+	ASSERT_NE(nullptr, entry);
+	EXPECT_EQ(player, entry->player);
+	EXPECT_EQ(player, get_player_from_appartenance(unit, ecs));
+	EXPECT_EQ(nullptr, entry->resource_stock.try_get());
+
+	// components added later are visible through the entry
+	player.set<ResourceStock>({});
+	player.add<PlayerUpgrade>();
+	entry = get_player_entry(ecs, 1);
+	ASSERT_NE(nullptr, entry);
+	EXPECT_EQ(player.try_get<ResourceStock>(), entry->resource_stock.try_get());
+	EXPECT_EQ(player.try_get<PlayerUpgrade>(), entry->player_upgrade.try_get());
+
+	// index change
+	player.set<PlayerInfo>({2, 1});
+	EXPECT_EQ(nullptr, get_player_entry(ecs, 1));
+	ASSERT_NE(nullptr, get_player_entry(ecs, 2));
+	EXPECT_EQ(player, get_player_entry(ecs, 2)->player);
+
+	// destruction
+	player.destruct();
+	EXPECT_EQ(nullptr, get_player_entry(ecs, 2));
+}
+
+TEST(player_registry, existing)
+{
+	flecs::world ecs;
+
+	auto player = ecs.entity("player")
+		.set<PlayerInfo>({0, 0});
+
+	// players created before the set up are registered
+	set_up_player_registry(ecs);
+
+	ASSERT_NE(nullptr, get_player_entry(ecs, 0));
+	EXPECT_EQ(player, get_player_entry(ecs, 0)->player);
+}
+
+TEST(player_registry, group)
+{
+	flecs::world ecs;
+	set_up_player_registry(ecs);
+
+	auto unit_1 = ecs.entity("unit_1")
+		.set<PlayerAppartenance>({0});
+	auto unit_2 = ecs.entity("unit_2")
+		.set<PlayerAppartenance>({1});
+	auto unit_3 = ecs.entity("unit_3")
+		.set<PlayerAppartenance>({1});
+
+	flecs::entity group_0 = get_player_group(ecs, 0);
+	flecs::entity group_1 = get_player_group(ecs, 1);
+	EXPECT_NE(group_0, group_1);
+	EXPECT_EQ(group_0, get_player_group(ecs, 0));
+	EXPECT_TRUE(unit_1.has<PlayerGroup>(group_0));
+	EXPECT_TRUE(unit_2.has<PlayerGroup>(group_1));
+
+	flecs::query query = ecs.query_builder<PlayerAppartenance const>()
+		.group_by<PlayerGroup>()
+		.cached()
+		.build();
+
+	std::vector<flecs::entity> res;
+	query.set_group(group_1).each([&res](flecs::entity e, PlayerAppartenance const &) { res.push_back(e); });
+	ASSERT_EQ(2u, res.size());
+	EXPECT_EQ(unit_2, res[0]);
+	EXPECT_EQ(unit_3, res[1]);
+
+	// changing player moves the entity to the other group
+	unit_3.set<PlayerAppartenance>({0});
+	EXPECT_TRUE(unit_3.has<PlayerGroup>(group_0));
+	EXPECT_FALSE(unit_3.has<PlayerGroup>(group_1));
+
+	res.clear();
+	query.set_group(group_0).each([&res](flecs::entity e, PlayerAppartenance const &) { res.push_back(e); });
+	EXPECT_EQ(2u, res.size());
+}
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+
+#include "flecs.h"
+
+#include "octopus/utils/ThreadPool.hh"
+#include "octopus/utils/profiler/Profiler.hh"
+
+using namespace octopus;
+
+/////////////////////////////////////////////////
+/// This test aims at testing that zones are
+/// recorded in histograms and in the trace,
+/// including flecs systems and thread pool jobs
+/////////////////////////////////////////////////
+
+TEST(profiler, zones)
+{
+	Profiler &profiler_l = Profiler::get();
+	profiler_l.reset();
+
+	// disabled : nothing recorded
+	{
+		OCTOPUS_ZONE("outer")
+	}
+	profiler_l.collect();
+	EXPECT_TRUE(profiler_l.histograms().empty());
+
+	profiler_l.enable(true);
+	for(size_t i = 0 ; i < 3 ; ++ i)
+	{
+		OCTOPUS_ZONE("outer")
+		{
+			OCTOPUS_ZONE("inner")
+		}
+		{
+			OCTOPUS_ZONE("inner")
+		}
+	}
+	profiler_l.collect();
+	profiler_l.disable();
+
+	ASSERT_EQ(2u, profiler_l.histograms().size());
+	ZoneHistogram const &outer_l = profiler_l.histograms().at("outer");
+	ZoneHistogram const &inner_l = profiler_l.histograms().at("inner");
+	EXPECT_EQ(3u, outer_l.count);
+	EXPECT_EQ(6u, inner_l.count);
+	EXPECT_LE(inner_l.max_ns, outer_l.max_ns);
+	EXPECT_LE(outer_l.percentile(50), outer_l.percentile(99));
+	EXPECT_LE(outer_l.max_ns, outer_l.percentile(100));
+
+	// inner zones are nested in their outer zone
+	ASSERT_EQ(9u, profiler_l.trace().size());
+	ASSERT_EQ(2u, profiler_l.trace_names().size());
+	ZoneTraceEvent const &first_inner_l = profiler_l.trace()[0];
+	ZoneTraceEvent const &first_outer_l = profiler_l.trace()[2];
+	EXPECT_EQ("inner", profiler_l.trace_names()[first_inner_l.name_idx]);
+	EXPECT_EQ("outer", profiler_l.trace_names()[first_outer_l.name_idx]);
+	EXPECT_LE(first_outer_l.start_ns, first_inner_l.start_ns);
+	EXPECT_GE(first_outer_l.end_ns, first_inner_l.end_ns);
+
+	std::stringstream ss_l;
+	profiler_l.write_chrome_trace(ss_l);
+	std::string const json_l = ss_l.str();
+	EXPECT_EQ(0u, json_l.find("{\"displayTimeUnit\": \"ns\", \"traceEvents\": ["));
+	EXPECT_NE(std::string::npos, json_l.find("{\"name\": \"outer\", \"ph\": \"X\", \"pid\": 0, \"tid\": "));
+
+	profiler_l.reset();
+	EXPECT_TRUE(profiler_l.histograms().empty());
+	EXPECT_TRUE(profiler_l.trace().empty());
+}
+
+TEST(profiler, flecs_systems_and_jobs)
+{
+	Profiler &profiler_l = Profiler::get();
+	profiler_l.reset();
+	profiler_l.install_flecs_hooks();
+
+	flecs::world ecs;
+	ThreadPool pool_l(2);
+	ecs.system("profiled_system")
+		.run([&pool_l](flecs::iter &) {
+			threading(4, pool_l, [](size_t, size_t, size_t) {}, "profiled_job");
+		});
+
+	profiler_l.enable();
+	ecs.progress();
+	ecs.progress();
+	profiler_l.collect();
+	profiler_l.disable();
+
+	ASSERT_NE(profiler_l.histograms().end(), profiler_l.histograms().find("profiled_system"));
+	EXPECT_EQ(2u, profiler_l.histograms().at("profiled_system").count);
+	ASSERT_NE(profiler_l.histograms().end(), profiler_l.histograms().find("profiled_job"));
+	EXPECT_EQ(4u, profiler_l.histograms().at("profiled_job").count);
+	// flecs internals are not recorded by default
+	for(auto const &pair_l : profiler_l.histograms())
+	{
+		EXPECT_NE(0u, pair_l.first.find("flecs."));
+	}
+	// trace is not kept by default
+	EXPECT_TRUE(profiler_l.trace().empty());
+
+	profiler_l.reset();
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include "flecs.h"
+
+#include "octopus/world/player/PlayerInfo.hh"
+#include "octopus/world/player/PlayerRegistry.hh"
+#include "octopus/world/resources/CostReduction.hh"
+#include "octopus/world/resources/ResourceLedger.hh"
+#include "octopus/world/resources/ResourceStock.hh"
+
+using namespace octopus;
+
+/////////////////////////////////////////////////
+/// This test aims at testing that the resource
+/// ledger follows the steps (and their revert)
+/// on stock and cost reductions
+/////////////////////////////////////////////////
+
+TEST(resource_ledger, simple)
+{
+	flecs::world ecs;
+	set_up_player_registry(ecs);
+	set_up_resource_ledger(ecs);
+
+	auto player = ecs.entity("player")
+		.set<PlayerInfo>({0, 0})
+		.set<ResourceStock>({ {
+			{"food", {10, 100}},
+			{"steel", {5, 100}},
+		}})
+		.add<ResourceSpent>()
+		.add<ReductionLibrary>();
+
+	Symbol const unit("ledger_unit");
+	Symbol const tower("ledger_tower");
+	DenseCost const unit_cost = make_dense_cost({{"food", 8}, {"steel", 5}});
+	DenseCost const tower_cost = make_dense_cost({{"steel", 6}});
+
+	ResourceLedger ledger = get_resource_ledger(get_player_entry(ecs, 0));
+	EXPECT_EQ(Fixed(10), ledger.available(resource_index("food")));
+	EXPECT_TRUE(ledger.can_afford(unit, unit_cost));
+	EXPECT_FALSE(ledger.can_afford(tower, tower_cost));
+
+	// locked resources
+	ResourceSpent *spent = player.try_get_mut<ResourceSpent>();
+	spent->resources_spent["food"] += 3;
+	set_dense(spent->dense, resource_index("food"), 3);
+	EXPECT_FALSE(ledger.can_afford(unit, unit_cost));
+	spent->resources_spent.clear();
+	spent->dense.clear();
+
+	// steps on stock
+	ResourceStock *stock = player.try_get_mut<ResourceStock>();
+	ResourceStockStep step_stock {2, "steel"};
+	ResourceStockMemento memento_stock;
+	step_stock.apply_step(*stock, memento_stock);
+	EXPECT_TRUE(ledger.can_afford(tower, tower_cost));
+	step_stock.revert_step(*stock, memento_stock);
+	EXPECT_FALSE(ledger.can_afford(tower, tower_cost));
+
+	// steps on reductions
+	ReductionLibrary *library = player.try_get_mut<ReductionLibrary>();
+	ReductionLibraryStep step_reduction {2, "steel", "ledger_tower"};
+	ReductionLibraryMemento memento_reduction;
+	step_reduction.apply_step(*library, memento_reduction);
+	EXPECT_EQ(Fixed(4), ledger.price(tower, tower_cost[0]));
+	EXPECT_EQ(Fixed(5), ledger.price(unit, unit_cost[1]));
+
+	std::vector<bool> affordable;
+	get_affordable(ledger, {{unit, &unit_cost}, {tower, &tower_cost}, {unit, nullptr}}, affordable);
+	ASSERT_EQ(3u, affordable.size());
+	EXPECT_TRUE(affordable[0]);
+	EXPECT_TRUE(affordable[1]);
+	EXPECT_FALSE(affordable[2]);
+
+	step_reduction.revert_step(*library, memento_reduction);
+	EXPECT_FALSE(ledger.can_afford(tower, tower_cost));
+
+	// set outside of steps
+	player.set<ResourceStock>({ {
+		{"steel", {20, 100}},
+	}});
+	ledger = get_resource_ledger(get_player_entry(ecs, 0));
+	EXPECT_TRUE(ledger.can_afford(tower, tower_cost));
+	EXPECT_FALSE(ledger.can_afford(unit, unit_cost));
+}
@@ -135,9 +135,9 @@ TEST(ser_command_queue, simple)
 		values_reverted_l.push_front(std::string(ecs.to_json(e1.try_get<CustomCommandQueue>())));
 		e1.try_get_mut<CustomCommandQueue>()->_queuedActions.clear();
 		std::vector<CommandQueueMemento<custom_variant> > &mementos_l = *rit_l;
-		for(CommandQueueMemento<custom_variant> const &memento_l : mementos_l)
+		for(auto rit_memento_l = mementos_l.rbegin() ; rit_memento_l != mementos_l.rend() ; ++ rit_memento_l)
 		{
-			restore(ecs, memento_l);
+			restore(ecs, *rit_memento_l);
 		}
 	}
 	std::vector<std::string> vec_values_reverted_l(values_reverted_l.begin(), values_reverted_l.end());
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include "flecs.h"
+#include <string>
+
+#include "octopus/components/advanced/production/queue/ProductionQueue.hh"
+#include "octopus/components/basic/player/PlayerUpgrade.hh"
+#include "octopus/serialization/components/BasicSupport.hh"
+#include "octopus/utils/symbol/Symbol.hh"
+
+using namespace octopus;
+
+/////////////////////////////////////////////////
+/// This test aims at testing that symbols are
+/// interned once and saved as their names
+/////////////////////////////////////////////////
+
+TEST(ser_symbol, simple)
+{
+	Symbol a("symbol_test_a");
+	Symbol b(std::string("symbol_test_b"));
+
+	EXPECT_TRUE(Symbol().empty());
+	EXPECT_EQ(Symbol(""), Symbol());
+	EXPECT_FALSE(a.empty());
+	EXPECT_NE(a, b);
+	EXPECT_EQ(a, Symbol("symbol_test_a"));
+	EXPECT_EQ("symbol_test_a", a.name());
+	EXPECT_EQ(b, find_symbol("symbol_test_b"));
+
+	// find does not intern
+	uint32_t count_l = symbol_count();
+	EXPECT_TRUE(find_symbol("symbol_test_unknown").empty());
+	EXPECT_EQ(count_l, symbol_count());
+}
+
+TEST(ser_symbol, json)
+{
+	flecs::world ecs;
+	basic_components_support(ecs);
+
+	ProductionQueue queue_l;
+	queue_l.queue = {"symbol_test_a", "symbol_test_b"};
+	PlayerUpgrade upgrade_l;
+	upgrade_l.upgrades["symbol_test_up"] = 2;
+
+	std::string json_queue_l = ecs.to_json(&queue_l).c_str();
+	std::string json_upgrade_l = ecs.to_json(&upgrade_l).c_str();
+
+	// names are saved, not ids
+	EXPECT_NE(std::string::npos, json_queue_l.find("\"symbol_test_b\""));
+	EXPECT_NE(std::string::npos, json_upgrade_l.find("\"symbol_test_up\""));
+
+	ProductionQueue loaded_queue_l;
+	ecs.from_json(&loaded_queue_l, json_queue_l.c_str());
+	ASSERT_EQ(2u, loaded_queue_l.queue.size());
+	EXPECT_EQ(Symbol("symbol_test_a"), loaded_queue_l.queue[0]);
+	EXPECT_EQ(Symbol("symbol_test_b"), loaded_queue_l.queue[1]);
+
+	PlayerUpgrade loaded_upgrade_l;
+	ecs.from_json(&loaded_upgrade_l, json_upgrade_l.c_str());
+	EXPECT_TRUE(check_upgrades(loaded_upgrade_l, "symbol_test_up", 2));
+	EXPECT_FALSE(check_upgrades(loaded_upgrade_l, "symbol_test_up", 3));
+}
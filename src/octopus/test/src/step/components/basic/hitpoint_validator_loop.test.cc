@@ -88,3 +88,45 @@ TEST(hitpoint_validator_loop, simple)
 
 	revert_test.revert_and_check_records(world, step_context);
 }
+
+TEST(hitpoint_validator_loop, changed_only)
+{
+	WorldContext world;
+	flecs::world &ecs = world.ecs;
+
+	basic_components_support(ecs);
+	basic_commands_support(ecs);
+
+	command_queue_support<octopus::NoOpCommand, octopus::AttackCommand>(ecs);
+
+	auto step_context = makeDefaultStepContext<custom_variant>();
+
+	set_up_systems(world, step_context);
+
+	auto e1 = ecs.entity("e1")
+		.set<HitPoint>({5})
+		.set<HitPointMax>({10});
+
+	auto e2 = ecs.entity("e2")
+		.set<HitPoint>({5})
+		.set<HitPointMax>({10});
+
+	ecs.progress();
+
+	// tracked through OnSet
+	e1.set<HitPointMax>({-3});
+	// untracked write
+	e2.try_get_mut<HitPoint>()->qty = 20;
+
+	ecs.progress();
+
+	EXPECT_EQ(Fixed(1), e1.try_get<HitPointMax>()->qty);
+	EXPECT_EQ(Fixed(1), e1.try_get<HitPoint>()->qty);
+	EXPECT_EQ(Fixed(20), e2.try_get<HitPoint>()->qty);
+
+	e2.modified<HitPoint>();
+
+	ecs.progress();
+
+	EXPECT_EQ(Fixed(10), e2.try_get<HitPoint>()->qty);
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <flecs.h>
+#include <iostream>
+#include <string>
+#include <list>
+
+#include "octopus/commands/basic/move/AttackCommand.hh"
+#include "octopus/commands/basic/move/MoveCommand.hh"
+#include "octopus/commands/queue/CommandQueue.hh"
+
+#include "octopus/components/basic/position/Move.hh"
+#include "octopus/components/basic/position/Position.hh"
+#include "octopus/components/basic/position/PositionInTree.hh"
+#include "octopus/components/step/StepContainer.hh"
+
+#include "octopus/systems/Systems.hh"
+#include "octopus/systems/phases/Phases.hh"
+
+#include "octopus/serialization/queue/CommandQueueSupport.hh"
+#include "octopus/serialization/components/BasicSupport.hh"
+#include "octopus/serialization/commands/CommandSupport.hh"
+
+#include "env/stream_ent.hh"
+#include "utils/reverted/reverted_comparison.hh"
+
+using namespace octopus;
+
+/////////////////////////////////////////////////
+/// This test aims at testing that idle entities
+/// are put to sleep and woken up by a move
+/// or a moving neighbour
+/////////////////////////////////////////////////
+
+namespace
+{
+
+using custom_variant = std::variant<octopus::NoOpCommand, octopus::MoveCommand, octopus::AttackCommand, octopus::CastCommand>;
+using CustomCommandQueue = CommandQueue<custom_variant>;
+
+}
+
+TEST(sleep_loop, simple)
+{
+	WorldContext world;
+	flecs::world &ecs = world.ecs;
+	world.sleep_wait = 3;
+
+	basic_components_support(ecs);
+	basic_commands_support(ecs);
+	command_queue_support<octopus::NoOpCommand, octopus::MoveCommand, octopus::AttackCommand>(ecs);
+
+	auto step_context = makeDefaultStepContext<custom_variant>();
+	set_up_systems(world, step_context);
+
+	auto e1 = ecs.entity("e1")
+		.add<CustomCommandQueue>()
+		.add<Move>()
+		.add<PositionInTree>()
+		.set<Collision>({octopus::Fixed::One(), octopus::Fixed::One(), true})
+		.set<Position>({{10,10}});
+
+	auto e2 = ecs.entity("e2")
+		.add<CustomCommandQueue>()
+		.add<Move>()
+		.add<PositionInTree>()
+		.set<Collision>({octopus::Fixed::One(), octopus::Fixed::One(), true})
+		.set<Position>({{15,10}});
+
+	RevertTester<custom_variant, Position> revert_test({e1, e2});
+
+	bool e2_woken_l = false;
+	for(size_t i = 0; i < 20 ; ++ i)
+	{
+		ecs.progress();
+		revert_test.add_record(ecs);
+
+		if(i == 5)
+		{
+			EXPECT_TRUE(e1.try_get<Position>()->stuck_info.sleeping);
+			EXPECT_TRUE(e2.try_get<Position>()->stuck_info.sleeping);
+
+			MoveCommand move_l {{20,10}};
+			e1.try_get_mut<CustomCommandQueue>()->_queuedActions.push_back(CommandQueueActionAddBack<custom_variant> {move_l});
+		}
+		if(i == 6)
+		{
+			EXPECT_FALSE(e1.try_get<Position>()->stuck_info.sleeping);
+			EXPECT_LT(Fixed(10), e1.try_get<Position>()->pos.x);
+		}
+		if(i > 6 && !e2.try_get<Position>()->stuck_info.sleeping)
+		{
+			e2_woken_l = true;
+		}
+	}
+
+	EXPECT_TRUE(e2_woken_l);
+
+	revert_test.revert_and_check_records(world, step_context);
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include "flecs.h"
+
+#include "octopus/world/timer/TimerWheel.hh"
+
+using namespace octopus;
+
+/////////////////////////////////////////////////
+/// This test aims at testing that timers are
+/// due at their expiry and that reverting the
+/// timer steps restores the wheel exactly
+/////////////////////////////////////////////////
+
+namespace
+{
+
+bool same_wheel(TimerWheel const &a, TimerWheel const &b)
+{
+	if(a.immediate != b.immediate) { return false; }
+	for(size_t i = 0 ; i < TimerWheel::nb_slots ; ++ i)
+	{
+		std::vector<Timer> empty_l;
+		std::vector<Timer> const &slot_a = i < a.slots.size() ? a.slots[i] : empty_l;
+		std::vector<Timer> const &slot_b = i < b.slots.size() ? b.slots[i] : empty_l;
+		if(slot_a != slot_b) { return false; }
+	}
+	return true;
+}
+
+}
+
+TEST(timer_wheel, simple)
+{
+	flecs::world ecs;
+	auto e1 = ecs.entity("e1");
+	auto e2 = ecs.entity("e2");
+
+	TimerWheel wheel_l;
+	wheel_l.add({e2, 10, 0});
+	wheel_l.add({e1, 10, 0});
+	wheel_l.add({e1, 10, 1});
+	// same slot, next round
+	wheel_l.add({e1, 10 + TimerWheel::nb_slots, 0});
+	wheel_l.add({e2, 0, 0});
+
+	EXPECT_EQ(5u, wheel_l.size());
+
+	std::vector<Timer> due_l;
+	wheel_l.get_due(9, due_l);
+	// only immediate timer
+	ASSERT_EQ(1u, due_l.size());
+	EXPECT_EQ(e2, due_l[0].entity);
+
+	due_l.clear();
+	wheel_l.get_due(10, due_l);
+	// sorted by kind then entity
+	ASSERT_EQ(4u, due_l.size());
+	EXPECT_EQ(e1, due_l[0].entity);
+	EXPECT_EQ(10, due_l[0].expiry);
+	EXPECT_EQ(e2, due_l[1].entity);
+	EXPECT_EQ(0, due_l[1].expiry);
+	EXPECT_EQ(e2, due_l[2].entity);
+	EXPECT_EQ(10, due_l[2].expiry);
+	EXPECT_EQ(1u, due_l[3].kind);
+
+	EXPECT_TRUE(wheel_l.remove({e1, 10, 0}));
+	EXPECT_FALSE(wheel_l.remove({e1, 10, 0}));
+	EXPECT_EQ(4u, wheel_l.size());
+}
+
+TEST(timer_wheel, revert)
+{
+	flecs::world ecs;
+	auto e1 = ecs.entity("e1");
+	auto e2 = ecs.entity("e2");
+
+	TimerWheel wheel_l;
+	wheel_l.add({e1, 3, 0});
+	wheel_l.add({e2, 3, 0});
+	TimerWheel const reference_l = wheel_l;
+
+	std::vector<TimerStep> steps_l = {
+		{{e1, 5, 0}, true},
+		{{e2, 3, 0}, false},
+		// cancelling a missing timer does nothing
+		{{e2, 4, 0}, false},
+		{{e1, 3, 0}, true},
+		{{e1, 0, 0}, true},
+	};
+	std::vector<TimerMemento> mementos_l(steps_l.size());
+
+	for(size_t i = 0 ; i < steps_l.size() ; ++ i)
+	{
+		steps_l[i].apply_step(wheel_l, mementos_l[i]);
+	}
+	EXPECT_EQ(4u, wheel_l.size());
+	EXPECT_FALSE(mementos_l[2].done);
+
+	for(size_t i = steps_l.size() ; i > 0 ; -- i)
+	{
+		steps_l[i-1].revert_step(wheel_l, mementos_l[i-1]);
+	}
+
+	EXPECT_TRUE(same_wheel(reference_l, wheel_l));
+}
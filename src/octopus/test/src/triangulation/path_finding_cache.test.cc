@@ -1,7 +1,6 @@
 #include <gtest/gtest.h>
 #include "octopus/utils/triangulation/Triangulation.hh"
 #include "octopus/world/path/PathFindingCache.hh"
-#include "octopus/world/stats/TimeStats.hh"
 #include "octopus/systems/Systems.hh"
 
 #include "flecs.h"
@@ -44,10 +43,8 @@ struct TestGrid
 
 TEST(path_finding_cache, basic_query_system)
 {
-    TimeStats stats;
     flecs::world ecs;
     ecs.add<PathFindingCache>();
-    ecs.set<TimeStatsPtr>(TimeStatsPtr {&stats});
 
     PathFindingCache * cache = ecs.try_get_mut<PathFindingCache>();
 
@@ -71,7 +68,7 @@ TEST(path_finding_cache, basic_query_system)
     Vector target {50,50};
 
     cache->declare_sync_system(ecs, &grid);
-    cache->declare_cache_update_system(ecs, stats);
+    cache->declare_cache_update_system(ecs);
 
     ecs.progress();
 
@@ -113,7 +110,4 @@ TEST(path_finding_cache, basic_query_system)
 
     Vector direction_3 = query.get_direction();
     EXPECT_EQ(Vector(4, 0), direction_3);
-
-    std::cout<<"path_finding : "<<stats.path_finding/10e6<<"ms"<<std::endl;
-    std::cout<<"path_funnelling : "<<stats.path_funnelling/10e6<<"ms"<<std::endl;
 }
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "flecs.h"
+
+#include "octopus/components/basic/player/PlayerUpgrade.hh"
+#include "octopus/components/basic/player/UpgradeRequirement.hh"
+#include "octopus/world/player/PlayerInfo.hh"
+#include "octopus/world/player/PlayerRegistry.hh"
+
+using namespace octopus;
+
+/////////////////////////////////////////////////
+/// This test aims at testing that the cached
+/// satisfaction of requirements follows the
+/// upgrade steps (and their revert)
+/////////////////////////////////////////////////
+
+TEST(upgrade_requirement, simple)
+{
+	flecs::world ecs;
+	set_up_player_registry(ecs);
+
+	RequirementId const req_a = register_requirement({{{{"req_test_a", 1}}}});
+	RequirementId const req_ab = register_requirement({{{{"req_test_a", 2}, {"req_test_b", 1}}}});
+	RequirementId const req_none = register_requirement({});
+	// identical requirements share their id
+	EXPECT_EQ(req_a, register_requirement({{{{"req_test_a", 1}}}}));
+	EXPECT_NE(req_a, req_ab);
+	std::vector<RequirementId> const &dependents = get_dependent_requirements(Symbol("req_test_a"));
+	EXPECT_NE(dependents.end(), std::find(dependents.begin(), dependents.end(), req_a));
+	EXPECT_NE(dependents.end(), std::find(dependents.begin(), dependents.end(), req_ab));
+
+	auto player = ecs.entity("player")
+		.set<PlayerInfo>({0, 0})
+		.set<PlayerUpgrade>({});
+	auto unit = ecs.entity("unit")
+		.set<PlayerAppartenance>({0});
+
+	EXPECT_FALSE(check_requirements(unit, ecs, req_a));
+	EXPECT_FALSE(check_requirements(unit, ecs, req_ab));
+	EXPECT_TRUE(check_requirements(unit, ecs, req_none));
+	EXPECT_EQ(1u, explain_unmet_requirements(unit, ecs, req_a).size());
+
+	PlayerUpgrade *upgrade = player.try_get_mut<PlayerUpgrade>();
+	PlayerUpgradeStep step_a {Symbol("req_test_a"), 2};
+	PlayerUpgradeStep step_b {Symbol("req_test_b"), 1};
+	PlayerUpgradeMemento memento_a;
+	PlayerUpgradeMemento memento_b;
+
+	step_a.apply_step(*upgrade, memento_a);
+	EXPECT_TRUE(check_requirements(unit, ecs, req_a));
+	EXPECT_FALSE(check_requirements(unit, ecs, req_ab));
+	EXPECT_TRUE(explain_unmet_requirements(unit, ecs, req_a).empty());
+
+	step_b.apply_step(*upgrade, memento_b);
+	EXPECT_TRUE(check_requirements(unit, ecs, req_ab));
+
+	// registered after the last sync
+	RequirementId const req_b = register_requirement({{{{"req_test_b", 2}}}});
+	EXPECT_FALSE(check_requirements(unit, ecs, req_b));
+
+	step_b.revert_step(*upgrade, memento_b);
+	EXPECT_FALSE(check_requirements(unit, ecs, req_ab));
+	step_a.revert_step(*upgrade, memento_a);
+	EXPECT_FALSE(check_requirements(unit, ecs, req_a));
+
+	// set outside of steps
+	player.set<PlayerUpgrade>({{{{"req_test_a", 3}, {"req_test_b", 2}}}});
+	EXPECT_TRUE(check_requirements(unit, ecs, req_ab));
+	EXPECT_TRUE(check_requirements(unit, ecs, req_b));
+	EXPECT_TRUE(player.try_get<PlayerUpgrade>()->is_satisfied(req_b));
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include "octopus/world/budget/WorkBudget.hh"
+
+using namespace octopus;
+
+/////////////////////////////////////////////////
+/// This test aims at testing that budget
+/// channels only depend on the work units
+/// accounted, including after a revert
+/////////////////////////////////////////////////
+
+TEST(work_budget, queue)
+{
+	WorkScheduler scheduler_l;
+	BudgetChannel &queue_l = scheduler_l.add_queue("queue", 10);
+
+	std::vector<uint64_t> items_l = {4, 8, 1, 3};
+	size_t next_l = 0;
+
+	scheduler_l.begin_tick(0);
+	while(next_l < items_l.size() && queue_l.has_budget())
+	{
+		queue_l.spend(items_l[next_l++]);
+	}
+	queue_l.set_backlog(items_l.size() - next_l);
+	// the second item exceeds the budget but completes
+	EXPECT_EQ(2u, queue_l.runs);
+	EXPECT_EQ(12u, queue_l.spent);
+	EXPECT_EQ(2u, queue_l.backlog);
+
+	scheduler_l.begin_tick(1);
+	EXPECT_EQ(0u, queue_l.spent);
+	while(next_l < items_l.size() && queue_l.has_budget())
+	{
+		queue_l.spend(items_l[next_l++]);
+	}
+	queue_l.set_backlog(items_l.size() - next_l);
+	EXPECT_EQ(2u, queue_l.runs);
+	EXPECT_EQ(0u, queue_l.backlog);
+
+	EXPECT_EQ(&queue_l, scheduler_l.find("queue"));
+	EXPECT_EQ(nullptr, scheduler_l.find("none"));
+}
+
+TEST(work_budget, stride)
+{
+	WorkScheduler scheduler_l;
+	BudgetChannel &stride_l = scheduler_l.add_stride("stride", 100, 2, 16);
+
+	// demand of every tick
+	std::vector<uint64_t> demands_l = {50, 300, 1000, 5000, 150};
+	std::vector<int64_t> strides_l;
+	for(int64_t tick_l = 0 ; tick_l < int64_t(demands_l.size()) ; ++ tick_l)
+	{
+		scheduler_l.begin_tick(tick_l);
+		strides_l.push_back(stride_l.stride);
+		stride_l.add_demand(demands_l[tick_l]);
+	}
+	// stride of a tick fits the demand of the previous one
+	EXPECT_EQ(std::vector<int64_t>({2, 2, 4, 16, 16}), strides_l);
+	EXPECT_EQ(5000u - 5000u / 16u, stride_l.backlog);
+
+	EXPECT_TRUE(stride_l.is_due(4, 12));
+	EXPECT_FALSE(stride_l.is_due(4, 13));
+
+	// replaying the reverted ticks gives the same strides
+	for(int64_t tick_l = 2 ; tick_l < int64_t(demands_l.size()) ; ++ tick_l)
+	{
+		scheduler_l.begin_tick(tick_l);
+		EXPECT_EQ(strides_l[size_t(tick_l)], stride_l.stride);
+		stride_l.add_demand(demands_l[tick_l]);
+	}
+
+	// unlimited budget keeps the min stride
+	BudgetChannel &unlimited_l = scheduler_l.add_stride("unlimited", 0, 32, 128);
+	scheduler_l.begin_tick(5);
+	unlimited_l.add_demand(100000);
+	scheduler_l.begin_tick(6);
+	EXPECT_EQ(32, unlimited_l.stride);
+}